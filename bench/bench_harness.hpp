@@ -0,0 +1,125 @@
+#ifndef BENCH_HARNESS_HPP
+#define BENCH_HARNESS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Minimal microbenchmark harness: calibrates an iteration count per benchmark,
+// times several repetitions of it and reports the median, min and max cost
+// per operation as JSON.
+namespace bench {
+
+// Keeps the compiler from optimizing a value (and the work producing it) away
+template <typename T>
+inline void doNotOptimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+struct Options {
+    double minTimeSeconds = 0.1;   // Target duration of one repetition
+    int repetitions = 5;
+    std::string filter;            // Only run benchmarks whose name contains this
+};
+
+struct Result {
+    std::string name;
+    std::uint64_t iterations = 0;  // Operations per repetition
+    std::uint64_t itemsPerOp = 1;  // Vehicles, records, ... processed by one operation
+    double nsPerOp = 0.0;          // Median over repetitions
+    double minNsPerOp = 0.0;
+    double maxNsPerOp = 0.0;
+
+    double itemsPerSecond() const { return nsPerOp > 0.0 ? itemsPerOp * 1e9 / nsPerOp : 0.0; }
+};
+
+class Runner {
+public:
+    explicit Runner(Options options) : options(std::move(options)) {}
+
+    bool selected(const std::string& name) const {
+        return options.filter.empty() || name.find(options.filter) != std::string::npos;
+    }
+
+    /// Times op() and records the result under name.
+    /// @param itemsPerOp Units of work in one call, for the throughput column.
+    template <typename Op>
+    void run(const std::string& name, std::uint64_t itemsPerOp, Op&& op) {
+        if (!selected(name)) {
+            return;
+        }
+
+        // Grow the iteration count until one repetition takes at least minTimeSeconds
+        std::uint64_t iterations = 1;
+        for (;;) {
+            const double seconds = timeIterations(op, iterations);
+            if (seconds >= options.minTimeSeconds || iterations >= (1ull << 40)) {
+                break;
+            }
+            const double scale = seconds > 0.0 ? options.minTimeSeconds / seconds * 1.2 : 10.0;
+            iterations = std::max(iterations + 1, static_cast<std::uint64_t>(iterations * std::min(scale, 10.0)));
+        }
+
+        std::vector<double> samples;
+        for (int r = 0; r < std::max(1, options.repetitions); ++r) {
+            samples.push_back(timeIterations(op, iterations) * 1e9 / iterations);
+        }
+        std::sort(samples.begin(), samples.end());
+
+        Result result;
+        result.name = name;
+        result.iterations = iterations;
+        result.itemsPerOp = itemsPerOp;
+        result.nsPerOp = samples[samples.size() / 2];
+        result.minNsPerOp = samples.front();
+        result.maxNsPerOp = samples.back();
+        results.push_back(result);
+
+        std::cerr << std::left << std::setw(44) << name << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(14) << result.nsPerOp << " ns/op" << std::setw(16) << result.itemsPerSecond()
+                  << " items/s" << std::endl;
+    }
+
+    const std::vector<Result>& getResults() const { return results; }
+
+    /// Writes all results with the run's context as one JSON document.
+    void writeJson(std::ostream& os, const std::vector<std::pair<std::string, std::string>>& context) const {
+        os << "{\n  \"context\": {";
+        for (std::size_t i = 0; i < context.size(); ++i) {
+            os << (i ? ", " : "") << '"' << context[i].first << "\": \"" << context[i].second << '"';
+        }
+        os << "},\n  \"min_time_s\": " << options.minTimeSeconds
+           << ",\n  \"repetitions\": " << options.repetitions << ",\n  \"benchmarks\": [";
+        os << std::setprecision(3) << std::fixed;
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            os << (i ? ",\n" : "\n") << "    {\"name\": \"" << r.name << "\", \"iterations\": " << r.iterations
+               << ", \"items_per_op\": " << r.itemsPerOp << ", \"ns_per_op\": " << r.nsPerOp
+               << ", \"min_ns_per_op\": " << r.minNsPerOp << ", \"max_ns_per_op\": " << r.maxNsPerOp
+               << ", \"items_per_second\": " << r.itemsPerSecond() << "}";
+        }
+        os << "\n  ]\n}\n";
+    }
+
+private:
+    template <typename Op>
+    static double timeIterations(Op& op, std::uint64_t iterations) {
+        const auto start = std::chrono::steady_clock::now();
+        for (std::uint64_t i = 0; i < iterations; ++i) {
+            op();
+        }
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    Options options;
+    std::vector<Result> results;
+};
+
+} // namespace bench
+
+#endif // BENCH_HARNESS_HPP
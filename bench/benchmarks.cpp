@@ -0,0 +1,652 @@
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <streambuf>
+#include <string>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "bench_harness.hpp"
+#include "../headers/acc.hpp"
+#include "../headers/acc_controllers.hpp"
+#include "../headers/checkpoint.hpp"
+#include "../headers/columnar_exporter.hpp"
+#include "../headers/dashboard.hpp"
+#include "../headers/dashboard_renderer.hpp"
+#include "../headers/diagnostics.hpp"
+#include "../headers/fleet.hpp"
+#include "../headers/instrumentation.hpp"
+#include "../headers/logger.hpp"
+#include "../headers/metrics_exporter.hpp"
+#include "../headers/rng.hpp"
+#include "../headers/rule_engine.hpp"
+#include "../headers/sensor_recording.hpp"
+#include "../headers/signal_bus.hpp"
+#include "../headers/signal_history.hpp"
+#include "../headers/simd_kernels.hpp"
+#include "../headers/tick_engine.hpp"
+#include "../headers/vehicle.hpp"
+#include "../headers/vehicle_pool.hpp"
+
+namespace {
+// Every benchmark uses the same seed so runs are comparable
+constexpr std::uint64_t kSeed = 42;
+
+// Discards everything written to it
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize n) override { return n; }
+};
+
+// Sends std::cout to a NullBuffer and file descriptor 1 to /dev/null for its lifetime,
+// so console formatting is measured without the terminal
+class SilenceStdout {
+public:
+    SilenceStdout() : previous(std::cout.rdbuf(&sink)), savedFd(dup(STDOUT_FILENO)) {
+        const int devNull = open("/dev/null", O_WRONLY);
+        dup2(devNull, STDOUT_FILENO);
+        close(devNull);
+    }
+    ~SilenceStdout() {
+        std::cout.rdbuf(previous);
+        dup2(savedFd, STDOUT_FILENO);
+        close(savedFd);
+    }
+
+private:
+    NullBuffer sink;
+    std::streambuf* previous;
+    int savedFd;
+};
+
+// The sensors and control units of one vehicle, for benchmarking components in isolation
+struct Components {
+    VehicleSensors sensors{kSeed, 0};
+    EngineControlUnit engine;
+    BrakeControlUnit brake;
+    TransmissionControlUnit transmission;
+
+    // Publishes every current reading and actuator state, as Vehicle does
+    void publish(SignalBus& bus) const {
+        sensors.publishAll(bus, bus.now());
+        bus.publish(Signal::Throttle, engine.getThrottlePosition());
+        bus.publish(Signal::BrakePressure, brake.getBrakePressure());
+        bus.publish(Signal::Gear, transmission.getGear());
+    }
+};
+
+void benchLogger(bench::Runner& runner, Logger& logger) {
+    const std::string message = "Radar sensor updated.";
+    double distance = 42.0;
+    runner.run("logger/log_sync_file", 1, [&] { logger.Log(message); });
+    runner.run("logger/log_format_sync_file", 1, [&] {
+        logger.Log(VT_FMT("Radar detected distance: {:.2f} m"), distance += 0.01);
+    });
+
+    // Below the category's threshold only the level check runs; the arguments are not evaluated
+    logger.SetLevel(LogCategory::Sensors, LogLevel::Info);
+    runner.run("logger/disabled_level", 1, [&] {
+        VT_LOG_DEBUG(logger, Sensors, "Radar detected distance: {:.2f} m", distance += 0.01);
+    });
+    logger.SetLevel(LogCategory::Sensors, LogLevel::Debug);
+    runner.run("logger/sampled_1_in_100_sync_file", 1, [&] {
+        VT_LOG_EVERY_N(logger, Debug, Sensors, 100, "Radar detected distance: {:.2f} m", distance += 0.01);
+    });
+    logger.SetLevel(LogCategory::Sensors, LogLevel::Info);
+
+    if (runner.selected("logger/log_async_file") || runner.selected("logger/log_format_async_file")) {
+        logger.EnableAsync(8192, OverflowPolicy::Block);
+        runner.run("logger/log_async_file", 1, [&] { logger.Log(message); });
+        // Only the arguments are copied on the caller's thread; the writer formats them
+        runner.run("logger/log_format_async_file", 1, [&] {
+            logger.Log(VT_FMT("Radar detected distance: {:.2f} m"), distance += 0.01);
+        });
+        logger.Shutdown();
+    }
+}
+
+void benchInstrumentation(bench::Runner& runner) {
+    // Compiled in but switched off: a relaxed load and a branch per probe
+    Instrumentation::SetEnabled(false);
+    runner.run("instrumentation/probe_idle", 1, [&] { ScopedTimer timer(Probe::Tick); });
+    Instrumentation::SetEnabled(true);
+    // Two clock reads and a histogram update in the thread's own metrics
+    runner.run("instrumentation/probe_active", 1, [&] { ScopedTimer timer(Probe::Tick); });
+    runner.run("instrumentation/count", 1, [&] { VT_COUNT(LogRecords, 1); });
+
+    LatencyHistogram histogram;
+    std::uint64_t ns = 0;
+    runner.run("instrumentation/histogram_record", 1, [&] { histogram.record((ns += 7919) & 0xfffff); });
+    runner.run("instrumentation/snapshot", 1, [&] {
+        bench::doNotOptimize(Instrumentation::GetInstance().Snapshot().probe(Probe::Tick).count());
+    });
+}
+
+// Bulk uniform draws for one block of vehicles from each generator policy
+void benchRng(bench::Runner& runner) {
+    double out[Fleet::kKernelBlock];
+    std::uint64_t tick = 0;
+    runner.run("rng/philox_simd", Fleet::kKernelBlock, [&] {
+        simd::uniform<rng::Philox4x32>(kSeed, RandomChannel::Speed, tick++, 0, out, Fleet::kKernelBlock);
+        bench::doNotOptimize(out[0]);
+    });
+    runner.run("rng/philox_scalar", Fleet::kKernelBlock, [&] {
+        rng::fillUniformScalar<rng::Philox4x32>(kSeed, RandomChannel::Speed, tick++, 0, out, Fleet::kKernelBlock);
+        bench::doNotOptimize(out[0]);
+    });
+    runner.run("rng/threefry_scalar", Fleet::kKernelBlock, [&] {
+        rng::fillUniformScalar<rng::Threefry4x32>(kSeed, RandomChannel::Speed, tick++, 0, out, Fleet::kKernelBlock);
+        bench::doNotOptimize(out[0]);
+    });
+}
+
+void benchSensors(bench::Runner& runner) {
+    VehicleSensors sensors(kSeed, 0);
+    SpeedSensor& speed = sensors.get<SpeedSensor>();
+    FuelSensor& fuel = sensors.get<FuelSensor>();
+    TemperatureSensor& temperature = sensors.get<TemperatureSensor>();
+    Battery& battery = sensors.get<Battery>();
+    RadarSensor& radar = sensors.get<RadarSensor>();
+    runner.run("sensor/speed_update", 1, [&] { speed.update(); bench::doNotOptimize(speed.readData()); });
+    runner.run("sensor/fuel_update", 1, [&] { fuel.update(); bench::doNotOptimize(fuel.readData()); });
+    runner.run("sensor/temperature_update", 1, [&] {
+        temperature.update();
+        bench::doNotOptimize(temperature.readData());
+    });
+    runner.run("sensor/battery_update", 1, [&] { battery.update(); bench::doNotOptimize(battery.readCharge()); });
+    runner.run("sensor/radar_update", 1, [&] { radar.update(); bench::doNotOptimize(radar.readData()); });
+
+    // Updating every sensor: the registry's statically expanded loop against the same
+    // sensors behind the virtual plug-in interface
+    SignalBus bus;
+    runner.run("sensor/update_all_static", VehicleSensors::size(), [&] {
+        sensors.forEach([&](auto& sensor) { SensorTraits<std::decay_t<decltype(sensor)>>::update(sensor, bus); });
+        bench::doNotOptimize(radar.readData());
+    });
+    std::vector<std::unique_ptr<Sensor>> plugins;
+    plugins.push_back(std::make_unique<SensorAdapter<SpeedSensor>>(kSeed, 0));
+    plugins.push_back(std::make_unique<SensorAdapter<FuelSensor>>(kSeed, 0));
+    plugins.push_back(std::make_unique<SensorAdapter<TemperatureSensor>>(kSeed, 0));
+    plugins.push_back(std::make_unique<SensorAdapter<Battery>>(kSeed, 0));
+    plugins.push_back(std::make_unique<SensorAdapter<RadarSensor>>(kSeed, 0));
+    runner.run("sensor/update_all_virtual", plugins.size(), [&] {
+        for (const std::unique_ptr<Sensor>& sensor : plugins) {
+            sensor->update(bus);
+        }
+        bench::doNotOptimize(plugins.back()->readData());
+    });
+
+    runner.run("sensor/update_all_publish", VehicleSensors::size(), [&] { sensors.updateAll(bus); });
+}
+
+// Renders a realistic sequence of states: the full-frame iostream baseline, plain
+// to_chars frames, and incremental ANSI updates, all written to /dev/null
+void benchDashboardRendering(bench::Runner& runner) {
+    Fleet fleet(1, kSeed);
+    std::vector<VehicleState> states;
+    for (int i = 0; i < 1024; ++i) {
+        fleet.tick();
+        states.push_back(fleet.state(0));
+    }
+    const int devNull = open("/dev/null", O_WRONLY);
+    std::size_t next = 0;
+
+    runner.run("dashboard/render_ostream_full", 1, [&] {
+        std::ostringstream frame;
+        frame << "\n======= Vehicle Dashboard =======\n" << states[next++ & 1023] << '\n'
+              << "=================================\n";
+        const std::string text = frame.str();
+        bench::doNotOptimize(write(devNull, text.data(), text.size()));
+    });
+
+    DashboardRenderer plain(1, devNull, 0);
+    runner.run("dashboard/render_to_chars_full", 1, [&] { plain.render(states[next++ & 1023]); });
+
+    DashboardRenderer incremental(1, devNull, 1);
+    runner.run("dashboard/render_incremental", 1, [&] { incremental.render(states[next++ & 1023]); });
+
+    DashboardRenderer panels(64, devNull, 1);
+    runner.run("dashboard/render_incremental_64_panels", 64, [&] {
+        for (std::size_t p = 0; p < 64; ++p) {
+            panels.update(p, states[(next + p) & 1023]);
+        }
+        ++next;
+        panels.flush();
+    });
+    close(devNull);
+}
+
+void benchSignalBus(bench::Runner& runner) {
+    SignalBus bus;
+    double value = 0.0;
+    runner.run("bus/publish", 1, [&] { bus.publish(Signal::RadarDistance, value += 0.5, 0); });
+    runner.run("bus/latest", 1, [&] { bench::doNotOptimize(bus.latestValue(Signal::RadarDistance)); });
+    runner.run("bus/latest_state", 1, [&] { bench::doNotOptimize(latestVehicleState(bus)); });
+
+    SignalSubscription subscription(bus, Signal::RadarDistance);
+    runner.run("bus/publish_and_drain_64", 64, [&] {
+        for (int i = 0; i < 64; ++i) {
+            bus.publish(Signal::RadarDistance, value += 0.5, 0);
+        }
+        double sum = 0.0;
+        subscription.drain([&](const SignalSample& sample) { sum += sample.value; });
+        bench::doNotOptimize(sum);
+    });
+}
+
+void benchSubsystems(bench::Runner& runner, Logger& logger) {
+    Components c;
+    SignalBus bus;
+    c.publish(bus);
+    Dashboard dashboard(bus, logger);
+    VehicleDiagnostics diagnostics(bus, logger);
+    diagnostics.setConsoleOutput(false);
+    CruiseControlSystem cruiseControl(bus, c.engine, c.brake);
+
+    {
+        SilenceStdout silence;
+        runner.run("dashboard/display", 1, [&] { dashboard.display(); });
+    }
+    benchDashboardRendering(runner);
+    runner.run("diagnostics/run", 1, [&] { diagnostics.runDiagnostics(); });
+    runner.run("acc/adaptive_cruise_control", 1, [&] { cruiseControl.adaptiveCruiseControl(); });
+}
+
+void benchRules(bench::Runner& runner) {
+    RuleEngine single(RuleSet::defaults(), 1);
+    std::vector<RuleEvent> events;
+    double values[kSignalCount] = {80.0, 50.0, 85.0, 70.0, 30.0, 60.0, 40.0, 0.0, 3.0};
+    runner.run("rules/evaluate_vehicle", 1, [&] {
+        events.clear();
+        single.evaluate(0, values, events);
+        bench::doNotOptimize(events.size());
+    });
+
+    const std::size_t vehicles = 100000;
+    Fleet fleet(vehicles, kSeed);
+    fleet.tick();
+    RuleEngine batch(RuleSet::defaults(), vehicles);
+    runner.run("rules/evaluate_batch/vehicles:100000", vehicles, [&] {
+        events.clear();
+        batch.evaluateBatch(fleet, 0, vehicles, 0, events);
+        bench::doNotOptimize(events.size());
+    });
+
+    // Windowed aggregates: each evaluation pushes one sample into every window
+    std::istringstream windowedRules("engine_temperature:rate(50) > 2\n"
+                                     "speed:mean(50) > 120\n"
+                                     "speed:stddev(50) > 20\n"
+                                     "radar_distance:min(50) < 10\n"
+                                     "fuel_level:ewma(0.1) < 5\n");
+    const RuleSet windowed = RuleSet::parse(windowedRules, "bench");
+    std::uint64_t now = 0;
+    RuleEngine windowedSingle(windowed, 1);
+    runner.run("rules/observe_and_evaluate_windowed", 1, [&] {
+        now += 10000000;
+        windowedSingle.observe(0, Signal::Speed, now, values[0] += 0.01);
+        windowedSingle.observe(0, Signal::EngineTemperature, now, values[2]);
+        windowedSingle.observe(0, Signal::RadarDistance, now, values[5]);
+        windowedSingle.observe(0, Signal::FuelLevel, now, values[1]);
+        events.clear();
+        windowedSingle.evaluate(0, values, events);
+        bench::doNotOptimize(events.size());
+    });
+    if (runner.selected("rules/evaluate_batch_windowed/vehicles:10000")) {
+        const std::size_t windowedVehicles = 10000;
+        Fleet windowedFleet(windowedVehicles, kSeed);
+        windowedFleet.tick();
+        RuleEngine windowedBatch(windowed, windowedVehicles);
+        now = 0;
+        runner.run("rules/evaluate_batch_windowed/vehicles:10000", windowedVehicles, [&] {
+            events.clear();
+            windowedBatch.evaluateBatch(windowedFleet, 0, windowedVehicles, now += 10000000, events);
+            bench::doNotOptimize(events.size());
+        });
+    }
+}
+
+// Appends fleet signals to the compressed history at 100 Hz, then decodes a series back
+void benchHistory(bench::Runner& runner) {
+    if (!runner.selected("history/append_fleet/vehicles:1000") && !runner.selected("history/decode")) {
+        return;
+    }
+    const std::size_t vehicles = 1000;
+    Fleet fleet(vehicles, kSeed);
+    HistoryConfig config;
+    config.retention = std::chrono::minutes(1);
+    config.valueResolution = 0.01;
+    SignalHistory history(vehicles, config);
+    std::uint64_t now = 0;
+    fleet.tick();
+    runner.run("history/append_fleet/vehicles:1000", vehicles * kSignalCount, [&] {
+        history.appendFleet(fleet, 0, vehicles, now += 10000000);
+    });
+
+    std::vector<HistorySample> samples;
+    const std::size_t perSeries = history.of(0, Signal::Speed).sampleCount();
+    runner.run("history/decode", perSeries, [&] {
+        samples.clear();
+        history.of(0, Signal::Speed).decode(0, UINT64_MAX, samples, history.config());
+        bench::doNotOptimize(samples.data());
+    });
+}
+
+// Fleet rule transitions into the exporter's counts, and full scrapes of the pre-rendered page
+void benchMetrics(bench::Runner& runner, const std::string& socketPath) {
+    if (!runner.selected("metrics/")) {
+        return;
+    }
+    const RuleSet rules = RuleSet::defaults();
+    MetricsExporter exporter(socketPath, rules, 100000);
+    std::vector<RuleEvent> events;
+    for (std::uint32_t i = 0; i < 64; ++i) {
+        events.push_back(RuleEvent{i, static_cast<std::uint32_t>(i % rules.size()), (i & 1) == 0, 0.0});
+    }
+    runner.run("metrics/record_events_64", events.size(), [&] { exporter.recordEvents(events); });
+
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+    const char request[] = "GET /metrics HTTP/1.0\r\n\r\n";
+    char response[16384];
+    runner.run("metrics/scrape_unix_socket", 1, [&] {
+        const int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        std::size_t received = 0;
+        if (connect(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) == 0 &&
+            send(fd, request, sizeof(request) - 1, MSG_NOSIGNAL) > 0) {
+            ssize_t n;
+            while ((n = recv(fd, response, sizeof(response), 0)) > 0) {
+                received += static_cast<std::size_t>(n);
+            }
+        }
+        close(fd);
+        bench::doNotOptimize(received);
+    });
+}
+
+// Snapshot capture into the columnar exporter (the writer thread compresses meanwhile), and the column codec alone
+void benchColumnar(bench::Runner& runner, const std::string& path) {
+    if (!runner.selected("columnar/")) {
+        return;
+    }
+    const std::size_t vehicles = 1000;
+    const std::size_t snapshots = 64;
+    Fleet fleet(vehicles, kSeed);
+    std::vector<double> speed;
+    for (std::size_t s = 0; s < snapshots; ++s) {
+        fleet.tick();
+        speed.insert(speed.end(), fleet.columns().speed.begin(), fleet.columns().speed.end());
+    }
+
+    {
+        ColumnarExporter exporter(path, vehicles, 1, std::chrono::milliseconds(10));
+        std::uint64_t tick = 0;
+        runner.run("columnar/capture_fleet/vehicles:1000", vehicles, [&] {
+            exporter.capture(fleet, 0, vehicles);
+            exporter.commit(tick, tick * 10000000);
+            ++tick;
+        });
+    }
+    std::remove(path.c_str());
+
+    std::vector<unsigned char> encoded;
+    runner.run("columnar/encode_column", speed.size(), [&] {
+        encodeXorBytes(speed.data(), snapshots, vehicles, encoded);
+        bench::doNotOptimize(encoded.data());
+    });
+    std::vector<double> decoded(speed.size());
+    runner.run("columnar/decode_column", speed.size(), [&] {
+        decodeXorBytes(encoded.data(), encoded.size(), snapshots, vehicles, decoded.data());
+        bench::doNotOptimize(decoded.data());
+    });
+}
+
+// Saving and restoring the complete state of a 100k-vehicle fleet run, against simulating one tick of it
+void benchCheckpoint(bench::Runner& runner, const std::string& path) {
+    if (!runner.selected("checkpoint/")) {
+        return;
+    }
+    const std::size_t vehicles = 100000;
+    Fleet fleet(vehicles, kSeed);
+    RuleEngine rules(RuleSet::defaults(), vehicles);
+    std::vector<RuleEvent> events;
+    for (int tick = 0; tick < 10; ++tick) {
+        fleet.tick();
+        events.clear();
+        rules.evaluateBatch(fleet, 0, vehicles, fleet.tickIndex(), events);
+    }
+    runner.run("checkpoint/save_fleet/vehicles:100000", vehicles, [&] {
+        bench::doNotOptimize(saveFleetCheckpoint(path, fleet, rules, std::chrono::milliseconds(10)));
+    });
+    Fleet restored(vehicles, kSeed);
+    RuleEngine restoredRules(RuleSet::defaults(), vehicles);
+    runner.run("checkpoint/restore_fleet/vehicles:100000", vehicles, [&] {
+        restoreFleetCheckpoint(path, restored, restoredRules);
+        bench::doNotOptimize(restored.columns().speed.data());
+    });
+    std::remove(path.c_str());
+}
+
+// Records a minute of sensor frames, then replays it through the bus, alone and driving ACC
+void benchReplay(bench::Runner& runner, const std::string& recordingPath) {
+    if (!runner.selected("replay/publish_frame") && !runner.selected("replay/frame_with_acc")) {
+        return;
+    }
+    {
+        Components c;
+        SignalBus bus;
+        SensorRecorder recorder(recordingPath, bus, kRecordingPeriod, kSeed);
+        for (int frame = 0; frame < 6000; ++frame) {
+            c.sensors.get<RadarSensor>().update();
+            c.sensors.get<SpeedSensor>().update();
+            c.publish(bus);
+            recorder.record();
+        }
+    }
+
+    SensorReplay replay(recordingPath);
+    SignalBus bus;
+    runner.run("replay/publish_frame", 1, [&] {
+        if (!replay.publishNext(bus)) {
+            replay.rewind();
+        }
+    });
+
+    Components c;
+    CruiseControlSystem cruiseControl(bus, c.engine, c.brake);
+    runner.run("replay/frame_with_acc", 1, [&] {
+        if (!replay.publishNext(bus)) {
+            replay.rewind();
+        }
+        cruiseControl.adaptiveCruiseControl();
+    });
+    std::remove(recordingPath.c_str());
+}
+
+void benchVehicleTick(bench::Runner& runner, const std::string& logPath) {
+    Vehicle vehicle(logPath, 0, kSeed);
+    vehicle.setConsoleOutput(false);
+    SilenceStdout silence;
+    runner.run("vehicle/tick", 1, [&] {
+        vehicle.updateSensors();
+        vehicle.adaptiveCruiseControl();
+        vehicle.displayDashboard();
+        vehicle.runDiagnostics();
+    });
+}
+
+// Building and destroying 1,000 full vehicles, each on the heap versus all in one VehiclePool arena
+void benchVehicleConstruction(bench::Runner& runner, const std::string& logPath) {
+    const std::size_t vehicles = 1000;
+    runner.run("vehicle/heap_build_teardown/vehicles:1000", vehicles, [&] {
+        std::vector<std::unique_ptr<Vehicle>> fleet;
+        fleet.reserve(vehicles);
+        for (std::size_t i = 0; i < vehicles; ++i) {
+            fleet.push_back(std::make_unique<Vehicle>(logPath, static_cast<std::uint32_t>(i), kSeed));
+        }
+        bench::doNotOptimize(fleet.data());
+    });
+    runner.run("vehicle/pool_build_teardown/vehicles:1000", vehicles, [&] {
+        VehiclePool pool(vehicles, logPath, kSeed);
+        bench::doNotOptimize(&pool[0]);
+    });
+}
+
+// One control step of a controller over every vehicle of a fleet's radar and speed columns
+template <typename Controller>
+void benchAccController(bench::Runner& runner, const Fleet& fleet, std::vector<double>& throttle,
+                        std::vector<double>& brake) {
+    const std::size_t vehicles = fleet.size();
+    std::vector<typename Controller::State> states(vehicles);
+    const FleetColumns& data = fleet.columns();
+    runner.run(std::string("acc/batch/") + Controller::kName + "/vehicles:" + std::to_string(vehicles), vehicles, [&] {
+        acc::runBatch<Controller>(data.radarDistance.data(), data.speed.data(), vehicle_model::kAccPeriodSeconds,
+                                  states.data(), throttle.data(), brake.data(), vehicles);
+        bench::doNotOptimize(throttle[vehicles - 1]);
+    });
+}
+
+void benchAccControllers(bench::Runner& runner) {
+    if (!runner.selected("acc/simd_band/vehicles:100000") && !runner.selected("acc/batch/band/vehicles:100000") &&
+        !runner.selected("acc/batch/pid/vehicles:100000") && !runner.selected("acc/batch/cth/vehicles:100000") &&
+        !runner.selected("simd/clamp/vehicles:100000")) {
+        return;
+    }
+    const std::size_t vehicles = 100000;
+    Fleet fleet(vehicles, kSeed);
+    fleet.tick();
+    std::vector<double> throttle(vehicles);
+    std::vector<double> brake(vehicles);
+    runner.run("acc/simd_band/vehicles:100000", vehicles, [&] {
+        simd::accBand(fleet.columns().radarDistance.data(), throttle.data(), brake.data(), vehicles);
+        bench::doNotOptimize(throttle[vehicles - 1]);
+    });
+    benchAccController<acc::BandController<>>(runner, fleet, throttle, brake);
+    benchAccController<acc::TimeGapPid<>>(runner, fleet, throttle, brake);
+    benchAccController<acc::ConstantTimeHeadway<>>(runner, fleet, throttle, brake);
+
+    // The ECU's actuator clamp over commands spread beyond the actuator range
+    std::vector<double> commands(vehicles);
+    for (std::size_t i = 0; i < vehicles; ++i) {
+        commands[i] = fleet.columns().radarDistance[i] - 50.0;
+    }
+    runner.run("simd/clamp/vehicles:100000", vehicles, [&] {
+        simd::clamp(commands.data(), vehicle_model::kActuatorMin, vehicle_model::kActuatorMax, vehicles);
+        bench::doNotOptimize(commands[vehicles - 1]);
+    });
+}
+
+void benchFleetScaling(bench::Runner& runner) {
+    for (std::size_t vehicles : {1000u, 10000u, 100000u}) {
+        const std::string name = "fleet/tick/vehicles:" + std::to_string(vehicles);
+        if (!runner.selected(name)) {
+            continue;
+        }
+        Fleet fleet(vehicles, kSeed);
+        runner.run(name, vehicles, [&] { fleet.tick(); });
+    }
+
+    const std::size_t vehicles = 100000;
+    const std::size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+    std::size_t previous = 0;
+    for (std::size_t threads : {std::size_t(1), std::size_t(2), std::size_t(4), hardware}) {
+        if (threads == previous || (threads > hardware && threads != 1)) {
+            continue;
+        }
+        previous = threads;
+        const std::string name = "tick_engine/vehicles:" + std::to_string(vehicles) + "/threads:" + std::to_string(threads);
+        if (!runner.selected(name)) {
+            continue;
+        }
+        Fleet fleet(vehicles, kSeed);
+        TickEngineConfig config;
+        config.threads = threads;
+        TickEngine engine(fleet, config);
+        runner.run(name, vehicles, [&] { engine.tick(); });
+    }
+}
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program
+              << " [--filter SUBSTRING] [--min-time SECONDS] [--repetitions N] [--out FILE] [--log FILE]" << std::endl;
+}
+}
+
+/// Runs the microbenchmarks and writes the results as JSON (to stdout unless --out is given).
+int main(int argc, char* argv[]) {
+    bench::Options options;
+    std::string outPath;
+    std::string logPath = "bench.log";
+    try {
+        for (int i = 1; i < argc; ++i) {
+            if (i + 1 >= argc) {
+                printUsage(argv[0]);
+                return 2;
+            }
+            if (std::strcmp(argv[i], "--filter") == 0) {
+                options.filter = argv[++i];
+            } else if (std::strcmp(argv[i], "--min-time") == 0) {
+                options.minTimeSeconds = std::stod(argv[++i]);
+            } else if (std::strcmp(argv[i], "--repetitions") == 0) {
+                options.repetitions = std::stoi(argv[++i]);
+            } else if (std::strcmp(argv[i], "--out") == 0) {
+                outPath = argv[++i];
+            } else if (std::strcmp(argv[i], "--log") == 0) {
+                logPath = argv[++i];
+            } else {
+                printUsage(argv[0]);
+                return 2;
+            }
+        }
+    } catch (const std::exception&) {
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // Start from an empty log so file-backed results do not depend on earlier runs
+    std::ofstream(logPath, std::ios::trunc).close();
+    Logger& logger = Logger::GetInstance(logPath);
+
+    bench::Runner runner(options);
+    benchLogger(runner, logger);
+    benchInstrumentation(runner);
+    benchRng(runner);
+    benchSensors(runner);
+    benchSignalBus(runner);
+    benchSubsystems(runner, logger);
+    benchRules(runner);
+    benchHistory(runner);
+    benchMetrics(runner, logPath + ".metrics");
+    benchColumnar(runner, logPath + ".vtc");
+    benchCheckpoint(runner, logPath + ".ckpt");
+    benchReplay(runner, logPath + ".vrec");
+    benchVehicleTick(runner, logPath);
+    benchVehicleConstruction(runner, logPath);
+    benchAccControllers(runner);
+    benchFleetScaling(runner);
+
+    const std::vector<std::pair<std::string, std::string>> context = {
+        {"compiler", __VERSION__},
+        {"simd", simd::isaName(simd::activeIsa())},
+        {"rng", rng::DefaultGenerator::kName},
+        {"hardware_threads", std::to_string(std::thread::hardware_concurrency())},
+        {"seed", std::to_string(kSeed)},
+    };
+    if (outPath.empty()) {
+        runner.writeJson(std::cout, context);
+    } else {
+        std::ofstream out(outPath);
+        runner.writeJson(out, context);
+    }
+
+    logger.Shutdown();
+    std::remove(logPath.c_str());
+    return 0;
+}
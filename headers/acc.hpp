@@ -1,28 +1,33 @@
 #ifndef CRUISE_CONTROL_SYSTEM_H
 #define CRUISE_CONTROL_SYSTEM_H
 
-#include <memory>
-#include <sstream>
-#include <iostream>
+#include <cstdint>
 
-#include "sensors.hpp"
+#include "acc_controllers.hpp"
 #include "ecu.hpp"
-#include "logger.hpp"
+#include "signal_bus.hpp"
+#include "telemetry_log.hpp"
+
+// The controller the vehicle runs, chosen at compile time; e.g. acc::TimeGapPid<>
+// or acc::ConstantTimeHeadway<> (with default or custom gains)
+using VehicleAccController = acc::BandController<>;
 
 class CruiseControlSystem {
 public:
-    CruiseControlSystem(const std::shared_ptr<RadarSensor>& radarSensor,
-                       const std::shared_ptr<EngineControlUnit>& engineECU,
-                       const std::shared_ptr<BrakeControlUnit>& brakeECU,
-                       Logger& logger);
+    // The ECUs are not owned; they must outlive the system (in a Vehicle they are its siblings)
+    CruiseControlSystem(SignalBus& bus,
+                       EngineControlUnit& engineECU,
+                       BrakeControlUnit& brakeECU,
+                       std::uint32_t vehicleId = 0);
 
     void adaptiveCruiseControl();
 
 private:
-    std::shared_ptr<RadarSensor> radarSensor;
-    std::shared_ptr<EngineControlUnit> engineECU;
-    std::shared_ptr<BrakeControlUnit> brakeECU;
-    Logger& logger;
+    SignalBus& bus;
+    EngineControlUnit& engineECU;
+    BrakeControlUnit& brakeECU;
+    std::uint32_t vehicleId;
+    VehicleAccController::State controllerState;
 };
 
-#endif // CRUISE_CONTROL_SYSTEM_H
\ No newline at end of file
+#endif // CRUISE_CONTROL_SYSTEM_H
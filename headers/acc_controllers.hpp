@@ -0,0 +1,175 @@
+#ifndef ACC_CONTROLLERS_HPP
+#define ACC_CONTROLLERS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include "ecu.hpp"
+#include "vehicle_model.hpp"
+
+// Adaptive cruise control policies, selected at compile time.
+//
+// A controller is a type with
+//   struct State;                          // Per-vehicle memory (empty if stateless)
+//   static constexpr const char* kName;
+//   static vehicle_model::AccCommand step(double distance, double speedKmh, double dtSeconds, State& state);
+//
+// Gains and limits are static constexpr members of a parameter struct passed as
+// the template argument, so every variant is a distinct type the compiler fully
+// inlines: no virtual dispatch, no logging and no branches in step() (selects
+// compile to conditional moves or blends), which lets runBatch() vectorize.
+// Controllers with custom gains work the same; instantiate their runBatch() in
+// a file built like acc_controllers.cpp to get the vectorized loop.
+namespace acc {
+
+/// Clamps a command to the actuator range, as the ECU does.
+inline double clampActuator(double value) {
+    return ::clamp(value, vehicle_model::kActuatorMin, vehicle_model::kActuatorMax);
+}
+
+/// Band of a command for telemetry: 0 = braking, 1 = holding, 2 = accelerating.
+inline int commandBand(double throttle, double brake) {
+    return brake > 0.0 ? 0 : (throttle > vehicle_model::kAccMaintainThrottle ? 2 : 1);
+}
+
+// The original three-band rule: slow down, maintain or speed up by distance alone
+struct BandGains {
+    static constexpr double kSlowDownDistance = vehicle_model::kAccSlowDownDistance;
+    static constexpr double kSpeedUpDistance = vehicle_model::kAccSpeedUpDistance;
+    static constexpr double kSlowDownThrottle = vehicle_model::kAccSlowDownThrottle;
+    static constexpr double kSlowDownBrake = vehicle_model::kAccSlowDownBrake;
+    static constexpr double kMaintainThrottle = vehicle_model::kAccMaintainThrottle;
+    static constexpr double kSpeedUpThrottle = vehicle_model::kAccSpeedUpThrottle;
+};
+
+template <typename Gains = BandGains>
+struct BandController {
+    struct State {};
+    static constexpr const char* kName = "band";
+
+    static vehicle_model::AccCommand step(double distance, double /*speedKmh*/, double /*dtSeconds*/, State&) {
+        const bool slow = distance < Gains::kSlowDownDistance;
+        const bool fast = distance >= Gains::kSpeedUpDistance;
+        const double throttle = slow ? Gains::kSlowDownThrottle : (fast ? Gains::kSpeedUpThrottle : Gains::kMaintainThrottle);
+        const double brake = slow ? Gains::kSlowDownBrake : 0.0;
+        return {clampActuator(throttle), clampActuator(brake), static_cast<int>(!slow) + static_cast<int>(fast)};
+    }
+};
+
+// PID on the error between the distance and a speed-dependent time gap
+struct TimeGapPidGains {
+    static constexpr double kTimeGap = 1.8;          // s of travel to keep to the vehicle ahead
+    static constexpr double kStandstillGap = 5.0;    // m
+    static constexpr double kProportional = 1.0;     // % per m of gap error
+    static constexpr double kIntegral = 0.1;         // % per m*s
+    static constexpr double kDerivative = 0.5;       // % per m/s
+    static constexpr double kIntegralLimit = 200.0;  // m*s, anti-windup
+    static constexpr double kCruiseThrottle = vehicle_model::kAccMaintainThrottle;   // Feed-forward at zero error
+};
+
+template <typename Gains = TimeGapPidGains>
+struct TimeGapPid {
+    struct State {
+        double integral = 0.0;
+        double previousError = 0.0;
+        double primed = 0.0;   // 0 until the first step, so the derivative does not kick
+    };
+    static constexpr const char* kName = "pid";
+
+    static vehicle_model::AccCommand step(double distance, double speedKmh, double dtSeconds, State& state) {
+        const double desired = Gains::kStandstillGap + Gains::kTimeGap * (speedKmh / 3.6);
+        const double error = distance - desired;
+        state.integral = ::clamp(state.integral + error * dtSeconds, -Gains::kIntegralLimit, Gains::kIntegralLimit);
+        const double derivative = state.primed * (error - state.previousError) / dtSeconds;
+        state.previousError = error;
+        state.primed = 1.0;
+
+        const double output = Gains::kCruiseThrottle + Gains::kProportional * error + Gains::kIntegral * state.integral +
+                              Gains::kDerivative * derivative;
+        const double throttle = clampActuator(output);
+        const double brake = clampActuator(-output);
+        return {throttle, brake, commandBand(throttle, brake)};
+    }
+};
+
+// Constant-time-headway spacing policy: desired acceleration
+// a = (range rate + lambda * spacing error) / headway, mapped to pedal positions
+struct ConstantTimeHeadwayGains {
+    static constexpr double kHeadway = 1.5;           // s
+    static constexpr double kStandstillGap = 5.0;     // m
+    static constexpr double kLambda = 0.4;            // 1/s, spacing error convergence rate
+    static constexpr double kMaxAcceleration = 2.0;   // m/s^2
+    static constexpr double kMaxDeceleration = 6.0;   // m/s^2
+    static constexpr double kThrottlePerMps2 = 10.0;  // % per m/s^2
+    static constexpr double kBrakePerMps2 = 15.0;     // % per m/s^2
+    static constexpr double kCruiseThrottle = vehicle_model::kAccMaintainThrottle;
+};
+
+template <typename Gains = ConstantTimeHeadwayGains>
+struct ConstantTimeHeadway {
+    struct State {
+        double previousDistance = 0.0;
+        double primed = 0.0;   // 0 until the first step: no range rate yet
+    };
+    static constexpr const char* kName = "cth";
+
+    static vehicle_model::AccCommand step(double distance, double speedKmh, double dtSeconds, State& state) {
+        const double spacingError = distance - (Gains::kStandstillGap + Gains::kHeadway * (speedKmh / 3.6));
+        const double rangeRate = state.primed * (distance - state.previousDistance) / dtSeconds;
+        state.previousDistance = distance;
+        state.primed = 1.0;
+
+        const double acceleration = ::clamp((rangeRate + Gains::kLambda * spacingError) / Gains::kHeadway,
+                                            -Gains::kMaxDeceleration, Gains::kMaxAcceleration);
+        const double throttle = clampActuator(Gains::kCruiseThrottle + acceleration * Gains::kThrottlePerMps2);
+        const double brake = clampActuator(-acceleration * Gains::kBrakePerMps2);
+        return {throttle, brake, commandBand(throttle, brake)};
+    }
+};
+
+/// Runs one control step of a controller for n vehicles.
+/// @param distance Radar distances in meters.
+/// @param speedKmh Speeds in km/h.
+/// @param dtSeconds Time since the previous step; must be positive.
+/// @param states One state per vehicle; may be nullptr for stateless controllers.
+/// @param throttle Receives the throttle commands.
+/// @param brake Receives the brake commands.
+template <typename Controller>
+void runBatch(const double* distance, const double* speedKmh, double dtSeconds, typename Controller::State* states,
+              double* throttle, double* brake, std::size_t n) {
+    if constexpr (std::is_empty<typename Controller::State>::value) {
+        typename Controller::State none;
+        for (std::size_t i = 0; i < n; ++i) {
+            const vehicle_model::AccCommand command = Controller::step(distance[i], speedKmh[i], dtSeconds, none);
+            throttle[i] = command.throttle;
+            brake[i] = command.brake;
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            const vehicle_model::AccCommand command = Controller::step(distance[i], speedKmh[i], dtSeconds, states[i]);
+            throttle[i] = command.throttle;
+            brake[i] = command.brake;
+        }
+    }
+}
+
+// The controllers a Fleet can run, chosen at run time per fleet (--acc). The band rule runs on the
+// simd::accBand kernel; the stateful controllers step through runBatch()
+enum class ControllerKind : std::uint8_t { Band, TimeGapPid, ConstantTimeHeadway };
+
+/// @return The controller's kName: band, pid or cth.
+const char* controllerName(ControllerKind kind);
+/// Parses a controller's kName; throws std::runtime_error for unknown names.
+ControllerKind parseController(const std::string& name);
+
+// Instantiated in acc_controllers.cpp, which is compiled so these loops vectorize
+extern template void runBatch<TimeGapPid<>>(const double*, const double*, double, TimeGapPid<>::State*, double*,
+                                            double*, std::size_t);
+extern template void runBatch<ConstantTimeHeadway<>>(const double*, const double*, double,
+                                                     ConstantTimeHeadway<>::State*, double*, double*, std::size_t);
+
+} // namespace acc
+
+#endif // ACC_CONTROLLERS_HPP
@@ -0,0 +1,74 @@
+#ifndef ARENA_HPP
+#define ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+
+// Bump allocator for objects that all share one lifetime, such as the
+// components of every vehicle in a VehiclePool. Allocation is a pointer bump;
+// nothing is freed individually, and the blocks are released together when the
+// arena is destroyed. Objects placed in it must be destroyed by their owner
+// before that (the arena runs no destructors). Not thread-safe.
+class Arena {
+public:
+    // Blocks are at least blockBytes; reserve the expected total up front for a single block
+    explicit Arena(std::size_t blockBytes = std::size_t{1} << 20) : blockBytes(blockBytes == 0 ? 1 : blockBytes) {}
+    ~Arena() {
+        for (const Block& block : blocks) {
+            ::operator delete(block.data, std::align_val_t{kBlockAlignment});
+        }
+    }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // Uninitialized storage; alignment must be a power of two no larger than kBlockAlignment
+    void* allocate(std::size_t bytes, std::size_t alignment = alignof(std::max_align_t)) {
+        std::size_t offset = (used + alignment - 1) & ~(alignment - 1);
+        if (blocks.empty() || offset + bytes > blocks.back().size) {
+            addBlock(bytes);
+            offset = 0;
+        }
+        used = offset + bytes;
+        allocated += bytes;
+        return blocks.back().data + offset;
+    }
+    template <typename T>
+    T* allocate(std::size_t count) {
+        static_assert(alignof(T) <= kBlockAlignment, "Arena blocks are not aligned enough for T");
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    std::size_t blockCount() const { return blocks.size(); }
+    std::size_t bytesAllocated() const { return allocated; }
+    std::size_t bytesReserved() const {
+        std::size_t total = 0;
+        for (const Block& block : blocks) {
+            total += block.size;
+        }
+        return total;
+    }
+
+    static constexpr std::size_t kBlockAlignment = 64;
+
+private:
+    struct Block {
+        unsigned char* data;
+        std::size_t size;
+    };
+
+    void addBlock(std::size_t minBytes) {
+        const std::size_t size = minBytes > blockBytes ? minBytes : blockBytes;
+        blocks.push_back(Block{static_cast<unsigned char*>(::operator new(size, std::align_val_t{kBlockAlignment})),
+                               size});
+    }
+
+    std::size_t blockBytes;
+    std::vector<Block> blocks;
+    std::size_t used = 0;        // Bytes taken from the last block
+    std::size_t allocated = 0;
+};
+
+#endif // ARENA_HPP
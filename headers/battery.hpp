@@ -3,19 +3,30 @@
 
 #include <iostream>
 #include <iomanip>      // For formatted output
-#include <random>
+
+#include "rng.hpp"
+#include "vehicle_model.hpp"
 
 class Battery {
 public:
-    Battery();
-    void update();
-    double readCharge() const;
-    double readTemperature() const;
+    Battery(std::uint64_t seed = 0, std::uint32_t vehicleId = 0);
+    /// Simulates battery usage by decreasing the charge level and randomly adjusting the temperature.
+    void update() {
+        chargeLevel = vehicle_model::drain(chargeLevel,
+                                           usageRng.next(vehicle_model::kBatteryUseMin, vehicle_model::kBatteryUseMax));
+        temperature += temperatureRng.next(-vehicle_model::kBatteryTempStep, vehicle_model::kBatteryTempStep);
+    }
+    /// @return The current charge level in percentage.
+    double readCharge() const { return chargeLevel; }
+    /// @return The current temperature in degrees Celsius.
+    double readTemperature() const { return temperature; }
     friend std::ostream& operator<<(std::ostream& os, const Battery& battery);
 
 private:
     double chargeLevel;
     double temperature;
+    RandomStream usageRng;
+    RandomStream temperatureRng;
 };
 
 #endif // BATTERY_HPP
\ No newline at end of file
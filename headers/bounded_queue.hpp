@@ -0,0 +1,117 @@
+#ifndef BOUNDED_QUEUE_HPP
+#define BOUNDED_QUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+
+// Bounded lock-free multi-producer / multi-consumer queue (declaration)
+// Each slot carries a sequence number that tells producers and consumers
+// whether the slot is free or holds data for the current lap of the ring.
+template <typename T>
+class BoundedQueue {
+public:
+    explicit BoundedQueue(std::size_t requestedCapacity);
+
+    BoundedQueue(const BoundedQueue&) = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+
+    bool tryPush(T&& value);
+    bool tryPop(T& value);
+
+    std::size_t capacity() const { return mask + 1; }
+    std::size_t sizeApprox() const;
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    static std::size_t roundUpToPowerOfTwo(std::size_t value);
+
+    std::size_t mask;
+    std::unique_ptr<Slot[]> slots;
+    alignas(64) std::atomic<std::size_t> enqueuePos;
+    alignas(64) std::atomic<std::size_t> dequeuePos;
+};
+
+/// Creates a queue whose capacity is the requested size rounded up to a power of two.
+/// @param requestedCapacity Minimum number of elements the queue must hold.
+template <typename T>
+BoundedQueue<T>::BoundedQueue(std::size_t requestedCapacity)
+    : mask(roundUpToPowerOfTwo(requestedCapacity < 2 ? 2 : requestedCapacity) - 1),
+      slots(new Slot[mask + 1]), enqueuePos(0), dequeuePos(0) {
+    for (std::size_t i = 0; i <= mask; ++i) {
+        slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+/// Attempts to enqueue a value without blocking.
+/// @param value The value to move into the queue.
+/// @return false if the queue is full.
+template <typename T>
+bool BoundedQueue<T>::tryPush(T&& value) {
+    std::size_t pos = enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[pos & mask];
+        std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                slot.value = std::move(value);
+                slot.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/// Attempts to dequeue a value without blocking.
+/// @param value Receives the dequeued value.
+/// @return false if the queue is empty.
+template <typename T>
+bool BoundedQueue<T>::tryPop(T& value) {
+    std::size_t pos = dequeuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        Slot& slot = slots[pos & mask];
+        std::size_t seq = slot.sequence.load(std::memory_order_acquire);
+        auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+        if (diff == 0) {
+            if (dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                value = std::move(slot.value);
+                slot.sequence.store(pos + mask + 1, std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = dequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/// Returns the number of queued elements; only exact when no other thread is active.
+template <typename T>
+std::size_t BoundedQueue<T>::sizeApprox() const {
+    std::size_t tail = enqueuePos.load(std::memory_order_relaxed);
+    std::size_t head = dequeuePos.load(std::memory_order_relaxed);
+    return tail >= head ? tail - head : 0;
+}
+
+template <typename T>
+std::size_t BoundedQueue<T>::roundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+
+#endif // BOUNDED_QUEUE_HPP
@@ -0,0 +1,138 @@
+#ifndef CHECKPOINT_HPP
+#define CHECKPOINT_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+class Fleet;
+class RuleEngine;
+
+// Binary image of a fleet simulation's complete state, from which a run can be
+// resumed exactly where it stopped:
+//
+//   CheckpointHeader
+//   { CheckpointSection, data (padded to 8 bytes) } x sectionCount
+//
+// Sections are named arrays written and read back in a fixed order by the
+// classes that own the state (Fleet::saveState(), RuleEngine::saveState()...),
+// each with its element size, count and CRC32, so restoring into objects of a
+// different size or layout fails instead of misreading. Random draws are pure
+// functions of (seed, vehicle, channel, tick), so the tick is every stream's
+// position and no generator state is stored.
+//
+// The reader maps the file and copies each array straight into place, so a
+// restore costs about as much as reading the file. Integers and doubles are
+// stored in the host's native (little-endian) byte order.
+
+constexpr std::uint32_t kCheckpointMagic = 0x4B435456;   // "VTCK"
+constexpr std::uint16_t kCheckpointVersion = 1;
+
+struct CheckpointHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t generator;        // rng::DefaultGenerator::kId of the build that wrote it
+    std::uint64_t vehicleCount;
+    std::uint64_t seed;
+    std::uint64_t tick;             // Ticks completed
+    std::uint64_t dtNs;             // Simulated time per tick
+    std::uint32_t rulesFingerprint; // RuleSet::fingerprint() of the diagnostic rules
+    std::uint32_t sectionCount;
+};
+
+struct CheckpointSection {
+    char name[24];                  // NUL-terminated
+    std::uint32_t elementSize;
+    std::uint32_t crc32;            // Of the data
+    std::uint64_t count;
+    std::uint64_t reserved;
+};
+
+static_assert(sizeof(CheckpointHeader) == 48, "CheckpointHeader layout changed");
+static_assert(sizeof(CheckpointSection) == 48, "CheckpointSection layout changed");
+
+// Writes a checkpoint to a temporary file next to the destination and renames it
+// into place on finish(), so an interrupted write never replaces a good checkpoint.
+class CheckpointWriter {
+public:
+    // Throws std::runtime_error if the file cannot be created
+    CheckpointWriter(const std::string& path, const CheckpointHeader& header);
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    template <typename T>
+    void write(const char* name, const T* data, std::size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "Checkpoint sections hold plain arrays");
+        writeBytes(name, data, sizeof(T), count);
+    }
+    template <typename T>
+    void write(const char* name, const std::vector<T>& values) { write(name, values.data(), values.size()); }
+
+    // Completes the header and moves the file into place; throws std::runtime_error on write errors
+    void finish();
+
+    std::uint64_t bytesWritten() const { return bytes; }
+
+private:
+    void writeBytes(const char* name, const void* data, std::size_t elementSize, std::size_t count);
+
+    std::string path;
+    std::string tempPath;
+    std::ofstream file;
+    CheckpointHeader header;
+    std::uint64_t bytes = 0;
+    bool finished = false;
+};
+
+// Memory-mapped checkpoint; sections are read back in the order they were written.
+class CheckpointReader {
+public:
+    // Maps the file and checks the header; throws std::runtime_error if it is not a checkpoint
+    explicit CheckpointReader(const std::string& path);
+    ~CheckpointReader();
+
+    CheckpointReader(const CheckpointReader&) = delete;
+    CheckpointReader& operator=(const CheckpointReader&) = delete;
+
+    const CheckpointHeader& header() const { return fileHeader; }
+
+    // Copies the next section into count elements; throws std::runtime_error unless it has
+    // this name, element size and count and an intact CRC
+    template <typename T>
+    void read(const char* name, T* data, std::size_t count) {
+        static_assert(std::is_trivially_copyable<T>::value, "Checkpoint sections hold plain arrays");
+        readBytes(name, data, sizeof(T), count);
+    }
+    template <typename T>
+    void read(const char* name, std::vector<T>& values) { read(name, values.data(), values.size()); }
+
+private:
+    void readBytes(const char* name, void* data, std::size_t elementSize, std::size_t count);
+
+    std::string path;
+    const unsigned char* base = nullptr;
+    std::size_t size = 0;
+    std::size_t position = 0;
+    std::uint32_t sectionsRead = 0;
+    CheckpointHeader fileHeader{};
+};
+
+// Saves a fleet run after `fleet.tickIndex()` ticks: the fleet's state and the rule engine's
+// per-vehicle state. Returns the checkpoint's size in bytes.
+std::uint64_t saveFleetCheckpoint(const std::string& path, const Fleet& fleet, const RuleEngine& rules,
+                                  std::chrono::nanoseconds dt);
+
+// Reads only a checkpoint's header, to size the Fleet and RuleEngine to restore into
+CheckpointHeader readCheckpointHeader(const std::string& path);
+
+// Restores a checkpoint into a fleet and rule engine of its vehicle count, seed, rules and generator;
+// throws std::runtime_error if they do not match or the file is damaged
+void restoreFleetCheckpoint(const std::string& path, Fleet& fleet, RuleEngine& rules);
+
+#endif // CHECKPOINT_HPP
@@ -0,0 +1,97 @@
+#ifndef COLUMNAR_EXPORTER_HPP
+#define COLUMNAR_EXPORTER_HPP
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "columnar_format.hpp"
+#include "vehicle_state.hpp"
+
+class Fleet;
+
+// Sizes and progress of a columnar export
+struct ColumnarStats {
+    std::uint64_t snapshots = 0;   // Snapshots handed to the writer
+    std::uint64_t groups = 0;      // Row groups written
+    std::uint64_t bytes = 0;       // File size so far
+    std::uint64_t rawBytes = 0;    // Column data before compression
+    std::uint64_t stalls = 0;      // Commits that waited for the writer
+};
+
+// Writes the state of every vehicle every N ticks to a columnar file (see
+// columnar_format.hpp) for offline analysis.
+//
+// Snapshots are captured into one of two in-memory row groups while a writer
+// thread compresses and writes the other, so the tick only pays for copying
+// the values. capture() may be called concurrently for disjoint vehicle ranges
+// (e.g. from a TickEngine chunk observer); commit() then closes the snapshot on
+// a single thread. A commit only waits if the writer is still busy with the
+// previous row group when the next one fills up.
+class ColumnarExporter {
+public:
+    // Creates (or truncates) the file; snapshotsPerGroup = 0 picks about 2 MiB of values per row group.
+    // Throws std::runtime_error if the file cannot be created.
+    ColumnarExporter(const std::string& path, std::size_t vehicleCount, std::uint64_t everyTicks,
+                     std::chrono::nanoseconds dt, std::size_t snapshotsPerGroup = 0);
+    ~ColumnarExporter();
+
+    ColumnarExporter(const ColumnarExporter&) = delete;
+    ColumnarExporter& operator=(const ColumnarExporter&) = delete;
+
+    // Whether a tick is one the export keeps
+    bool due(std::uint64_t tick) const { return tick % every == 0; }
+
+    // Copies vehicles [begin, end) of a fleet into the current snapshot
+    void capture(const Fleet& fleet, std::size_t begin, std::size_t end);
+    // Copies one vehicle's state into the current snapshot
+    void capture(std::size_t vehicle, const VehicleState& state);
+
+    // Closes the current snapshot once every vehicle has been captured
+    void commit(std::uint64_t tick, std::uint64_t timestampNs);
+
+    // Writes the last partial row group and the footer; later calls do nothing
+    void close();
+
+    ColumnarStats stats() const;
+    std::size_t snapshotsPerGroup() const { return groupCapacity; }
+
+private:
+    // One row group being filled or written; values are column-major, one groupCapacity x vehicles block per column
+    struct RowGroup {
+        std::vector<double> values;
+        std::vector<std::uint64_t> ticks;
+        std::vector<std::uint64_t> timestampsNs;
+    };
+
+    double* slot(std::size_t column) { return &filling->values[(column * groupCapacity + filling->ticks.size()) * vehicles]; }
+    void handOff();
+    void run();
+    void write(const RowGroup& group);
+
+    std::size_t vehicles;
+    std::uint64_t every;
+    std::size_t groupCapacity;
+    std::ofstream file;
+    RowGroup buffers[2];
+    RowGroup* filling = &buffers[0];
+    RowGroup* pending = nullptr;       // Handed to the writer, not yet written
+
+    mutable std::mutex mutex;
+    std::condition_variable changed;
+    bool stopRequested = false;
+    bool closed = false;
+    ColumnarStats progress;            // Guarded by mutex
+    std::vector<ColumnarGroupIndex> index;             // Writer thread only
+    std::vector<std::vector<unsigned char>> encoded;   // Writer thread only, per column
+    std::vector<unsigned char> meta;                   // Writer thread only
+    std::thread writer;
+};
+
+#endif // COLUMNAR_EXPORTER_HPP
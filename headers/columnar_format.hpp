@@ -0,0 +1,333 @@
+#ifndef COLUMNAR_FORMAT_HPP
+#define COLUMNAR_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "signals.hpp"
+#include "telemetry_format.hpp"
+
+// Layout of the columnar fleet snapshot file and a header-only loader for it.
+// External tools only need this header (and signals.hpp, telemetry_format.hpp).
+//
+//   ColumnarFileHeader
+//   ColumnarColumnInfo[columnCount]
+//   { row group } ...
+//   ColumnarGroupIndex[groupCount]
+//   ColumnarFooter
+//
+// A snapshot is the state of every vehicle at one tick; a row group holds a
+// run of consecutive snapshots, stored one column at a time:
+//
+//   ColumnarGroupHeader
+//   std::uint64_t ticks[snapshotCount]
+//   std::uint64_t timestampsNs[snapshotCount]
+//   ColumnarChunkInfo[columnCount]        // Offset, size, min/max and CRC of each column
+//   column chunk ...
+//
+// Column c holds Signal c (gear as a whole number), snapshot-major: the values
+// of vehicles 0..vehicleCount-1 at the group's first snapshot, then at the next.
+// The footer indexes the row groups, so a reader can decode one column of the
+// groups whose min/max it needs without touching the other columns. A file
+// whose writer died has no footer; its complete row groups are found by
+// walking the group headers from the start.
+//
+// Chunks use the XOR-bytes codec: each value's bits are XORed with the same
+// vehicle's value one snapshot earlier (0 for the group's first snapshot, so
+// groups decode independently) and only the low bytes up to the highest
+// non-zero one are kept. The byte counts come first, two 4-bit counts per byte
+// (even values in the low nibble), followed by the kept bytes, little-endian.
+// Unchanged readings (gear, throttle, a drained battery) take half a byte.
+//
+// Integers and doubles are stored in the host's native (little-endian) byte order.
+
+constexpr std::uint32_t kColumnarFileMagic = 0x46435456;    // "VTCF"
+constexpr std::uint32_t kColumnarGroupMagic = 0x47525456;   // "VTRG"
+constexpr std::uint32_t kColumnarFooterMagic = 0x54465456;  // "VTFT"
+constexpr std::uint16_t kColumnarFormatVersion = 1;
+constexpr std::uint8_t kColumnarCodecXorBytes = 1;
+
+struct ColumnarFileHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t columnCount;
+    std::uint32_t vehicleCount;
+    std::uint32_t snapshotEvery;   // Ticks between snapshots
+    std::uint64_t dtNs;            // Simulated time per tick
+};
+
+struct ColumnarColumnInfo {
+    char name[24];                 // signalKey(), NUL-terminated
+    std::uint8_t codec;
+    std::uint8_t reserved[7];
+};
+
+struct ColumnarGroupHeader {
+    std::uint32_t magic;
+    std::uint32_t snapshotCount;
+    std::uint64_t groupBytes;      // Whole group, header included
+    std::uint64_t firstTick;
+    std::uint32_t metaCrc32;       // Of the ticks, timestamps and chunk infos
+    std::uint32_t reserved;
+};
+
+struct ColumnarChunkInfo {
+    std::uint64_t offset;          // From the start of the group
+    std::uint64_t bytes;
+    double min;                    // Over the chunk's values, NaN excluded
+    double max;
+    std::uint32_t crc32;           // Of the chunk's bytes
+    std::uint32_t reserved;
+};
+
+struct ColumnarGroupIndex {
+    std::uint64_t offset;          // From the start of the file
+    std::uint64_t firstTick;
+    std::uint32_t snapshotCount;
+    std::uint32_t reserved;
+};
+
+struct ColumnarFooter {
+    std::uint64_t indexOffset;
+    std::uint32_t groupCount;
+    std::uint32_t magic;
+};
+
+static_assert(sizeof(ColumnarFileHeader) == 24, "ColumnarFileHeader layout changed");
+static_assert(sizeof(ColumnarColumnInfo) == 32, "ColumnarColumnInfo layout changed");
+static_assert(sizeof(ColumnarGroupHeader) == 32, "ColumnarGroupHeader layout changed");
+static_assert(sizeof(ColumnarChunkInfo) == 40, "ColumnarChunkInfo layout changed");
+static_assert(sizeof(ColumnarGroupIndex) == 24, "ColumnarGroupIndex layout changed");
+static_assert(sizeof(ColumnarFooter) == 16, "ColumnarFooter layout changed");
+
+/// Bytes of a row group's ticks, timestamps and chunk infos.
+inline std::size_t columnarGroupMetaBytes(std::size_t snapshots, std::size_t columns) {
+    return 2 * snapshots * sizeof(std::uint64_t) + columns * sizeof(ColumnarChunkInfo);
+}
+
+/// Encodes one column chunk with the XOR-bytes codec.
+/// @param values The chunk's values, snapshot-major.
+/// @param snapshots Number of snapshots in the chunk.
+/// @param vehicles Values per snapshot.
+/// @param out Receives the encoded bytes (replacing its contents).
+inline void encodeXorBytes(const double* values, std::size_t snapshots, std::size_t vehicles,
+                           std::vector<unsigned char>& out) {
+    const std::size_t count = snapshots * vehicles;
+    out.assign((count + 1) / 2, 0);
+    out.reserve(out.size() + count * sizeof(double));
+    for (std::size_t i = 0; i < count; ++i) {
+        std::uint64_t bits;
+        std::memcpy(&bits, &values[i], sizeof(bits));
+        if (i >= vehicles) {
+            std::uint64_t previous;
+            std::memcpy(&previous, &values[i - vehicles], sizeof(previous));
+            bits ^= previous;
+        }
+        const unsigned length = bits == 0 ? 0 : 8 - static_cast<unsigned>(__builtin_clzll(bits)) / 8;
+        out[i / 2] |= static_cast<unsigned char>(length << (4 * (i & 1)));
+        unsigned char bytes[sizeof(bits)];
+        std::memcpy(bytes, &bits, sizeof(bits));
+        out.insert(out.end(), bytes, bytes + length);
+    }
+}
+
+/// Decodes a column chunk written by encodeXorBytes().
+/// @param data The encoded bytes.
+/// @param size Number of encoded bytes.
+/// @param snapshots Number of snapshots in the chunk.
+/// @param vehicles Values per snapshot.
+/// @param values Receives snapshots * vehicles values, snapshot-major.
+/// @return false if the bytes are too short for the chunk.
+inline bool decodeXorBytes(const unsigned char* data, std::size_t size, std::size_t snapshots, std::size_t vehicles,
+                           double* values) {
+    const std::size_t count = snapshots * vehicles;
+    std::size_t position = (count + 1) / 2;
+    if (position > size) {
+        return false;
+    }
+    for (std::size_t i = 0; i < count; ++i) {
+        const unsigned length = (data[i / 2] >> (4 * (i & 1))) & 0x0F;
+        if (length > 8 || position + length > size) {
+            return false;
+        }
+        std::uint64_t bits = 0;
+        std::memcpy(&bits, data + position, length);
+        position += length;
+        if (i >= vehicles) {
+            std::uint64_t previous;
+            std::memcpy(&previous, &values[i - vehicles], sizeof(previous));
+            bits ^= previous;
+        }
+        std::memcpy(&values[i], &bits, sizeof(bits));
+    }
+    return true;
+}
+
+// Read-only view of a columnar snapshot file, memory-mapped so that reading
+// one column only touches that column's pages. Row groups are not padded, so
+// headers and metadata can sit at any offset; they are copied out of the
+// mapping rather than read in place.
+class ColumnarReader {
+public:
+    // One row group's metadata, copied out of the mapping
+    struct Group {
+        std::uint64_t firstTick;
+        std::uint32_t snapshotCount;
+        std::vector<std::uint64_t> ticks;
+        std::vector<std::uint64_t> timestampsNs;
+        std::vector<ColumnarChunkInfo> chunks;   // Indexed by column
+    };
+
+    // Maps the file and indexes its row groups; throws std::runtime_error if it is not a columnar file
+    explicit ColumnarReader(const std::string& path) {
+        const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open columnar file: " + path);
+        }
+        struct stat info{};
+        if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(ColumnarFileHeader)) {
+            close(fd);
+            throw std::runtime_error("Not a columnar file: " + path);
+        }
+        size = static_cast<std::size_t>(info.st_size);
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Failed to map columnar file: " + path);
+        }
+        base = static_cast<const unsigned char*>(mapping);
+        try {
+            index(path);
+        } catch (...) {
+            munmap(const_cast<unsigned char*>(base), size);
+            throw;
+        }
+    }
+    ~ColumnarReader() { munmap(const_cast<unsigned char*>(base), size); }
+
+    ColumnarReader(const ColumnarReader&) = delete;
+    ColumnarReader& operator=(const ColumnarReader&) = delete;
+
+    const ColumnarFileHeader& header() const { return fileHeader; }
+    std::size_t vehicleCount() const { return fileHeader.vehicleCount; }
+    std::size_t columnCount() const { return fileHeader.columnCount; }
+    const ColumnarColumnInfo& column(std::size_t c) const { return columns[c]; }
+    // Index of the column with a name, or columnCount() if there is none
+    std::size_t findColumn(const std::string& name) const {
+        std::size_t c = 0;
+        while (c < columnCount() && name != columns[c].name) {
+            ++c;
+        }
+        return c;
+    }
+
+    std::size_t groupCount() const { return groups.size(); }
+    const Group& group(std::size_t g) const { return groups[g]; }
+    // Whether the footer was missing or damaged and the row groups were found by walking the file
+    bool recovered() const { return walked; }
+
+    // Decodes one column of one row group (snapshotCount * vehicleCount() values, snapshot-major).
+    // Throws std::runtime_error if the chunk is damaged.
+    void readColumn(std::size_t g, std::size_t c, std::vector<double>& values) const {
+        const Group& rowGroup = groups[g];
+        const ColumnarChunkInfo& chunk = rowGroup.chunks[c];
+        const unsigned char* data = groupBase[g] + chunk.offset;
+        values.resize(static_cast<std::size_t>(rowGroup.snapshotCount) * vehicleCount());
+        if (crc32(data, chunk.bytes) != chunk.crc32 ||
+            !decodeXorBytes(data, chunk.bytes, rowGroup.snapshotCount, vehicleCount(), values.data())) {
+            throw std::runtime_error("Damaged column chunk: group " + std::to_string(g) + ", column " +
+                                     columns[c].name);
+        }
+    }
+
+private:
+    void index(const std::string& path) {
+        std::memcpy(&fileHeader, base, sizeof(fileHeader));
+        const std::size_t columnsEnd = sizeof(fileHeader) + fileHeader.columnCount * sizeof(ColumnarColumnInfo);
+        if (fileHeader.magic != kColumnarFileMagic || fileHeader.version != kColumnarFormatVersion ||
+            columnsEnd > size) {
+            throw std::runtime_error("Not a columnar file: " + path);
+        }
+        columns.resize(fileHeader.columnCount);
+        std::memcpy(columns.data(), base + sizeof(fileHeader), columns.size() * sizeof(ColumnarColumnInfo));
+
+        ColumnarFooter footer{};
+        if (size >= columnsEnd + sizeof(footer)) {
+            std::memcpy(&footer, base + size - sizeof(footer), sizeof(footer));
+        }
+        const bool indexed = footer.magic == kColumnarFooterMagic && footer.indexOffset >= columnsEnd &&
+                             footer.indexOffset + footer.groupCount * sizeof(ColumnarGroupIndex) + sizeof(footer) == size;
+        if (indexed) {
+            for (std::uint32_t g = 0; g < footer.groupCount; ++g) {
+                ColumnarGroupIndex entry;
+                std::memcpy(&entry, base + footer.indexOffset + g * sizeof(entry), sizeof(entry));
+                if (!addGroup(entry.offset, footer.indexOffset)) {
+                    throw std::runtime_error("Damaged row group index: " + path);
+                }
+            }
+            return;
+        }
+        // No footer: keep every complete row group from the start
+        walked = true;
+        std::uint64_t offset = columnsEnd;
+        std::uint64_t groupBytes = 0;
+        while (addGroup(offset, size, &groupBytes)) {
+            offset += groupBytes;
+        }
+    }
+
+    bool addGroup(std::uint64_t offset, std::uint64_t limit, std::uint64_t* groupBytes = nullptr) {
+        ColumnarGroupHeader header;
+        if (offset + sizeof(header) > limit) {
+            return false;
+        }
+        std::memcpy(&header, base + offset, sizeof(header));
+        const std::size_t metaBytes = columnarGroupMetaBytes(header.snapshotCount, fileHeader.columnCount);
+        if (header.magic != kColumnarGroupMagic || header.groupBytes < sizeof(header) + metaBytes ||
+            offset + header.groupBytes > limit ||
+            crc32(base + offset + sizeof(header), metaBytes) != header.metaCrc32) {
+            return false;
+        }
+        const unsigned char* meta = base + offset + sizeof(header);
+        Group group;
+        group.firstTick = header.firstTick;
+        group.snapshotCount = header.snapshotCount;
+        group.ticks.resize(header.snapshotCount);
+        group.timestampsNs.resize(header.snapshotCount);
+        group.chunks.resize(fileHeader.columnCount);
+        const std::size_t tickBytes = header.snapshotCount * sizeof(std::uint64_t);
+        std::memcpy(group.ticks.data(), meta, tickBytes);
+        std::memcpy(group.timestampsNs.data(), meta + tickBytes, tickBytes);
+        std::memcpy(group.chunks.data(), meta + 2 * tickBytes, group.chunks.size() * sizeof(ColumnarChunkInfo));
+        for (const ColumnarChunkInfo& chunk : group.chunks) {
+            if (chunk.offset + chunk.bytes > header.groupBytes) {
+                return false;
+            }
+        }
+        groups.push_back(std::move(group));
+        groupBase.push_back(base + offset);
+        if (groupBytes != nullptr) {
+            *groupBytes = header.groupBytes;
+        }
+        return true;
+    }
+
+    const unsigned char* base = nullptr;
+    std::size_t size = 0;
+    ColumnarFileHeader fileHeader{};
+    std::vector<ColumnarColumnInfo> columns;
+    std::vector<Group> groups;
+    std::vector<const unsigned char*> groupBase;
+    bool walked = false;
+};
+
+#endif // COLUMNAR_FORMAT_HPP
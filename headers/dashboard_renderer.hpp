@@ -0,0 +1,86 @@
+#ifndef DASHBOARD_RENDERER_HPP
+#define DASHBOARD_RENDERER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "signals.hpp"
+#include "vehicle_state.hpp"
+
+// Draws one dashboard panel per vehicle on a terminal, redrawing only what changed.
+//
+// Values are formatted with std::to_chars into fixed-width slots of a buffer
+// allocated once at construction. The first frame draws the whole layout and
+// reserves the panels' rows at the top of the screen (other console output
+// scrolls underneath); later frames compare each slot with the previous frame
+// and emit only an ANSI cursor move plus the new text for slots that changed.
+// Each flush() is a single write() to the file descriptor.
+//
+// Without ANSI (e.g. output redirected to a file) every flush writes the full
+// panels as plain text instead.
+class DashboardRenderer {
+public:
+    // Characters reserved for each value; longer values are shown as '#'
+    static constexpr std::size_t kValueWidth = 8;
+
+    // ansi < 0 detects a terminal on fd; 0 or 1 forces plain text or ANSI
+    explicit DashboardRenderer(std::size_t panels = 1, int fd = 1, int ansi = -1);
+    ~DashboardRenderer();
+
+    DashboardRenderer(const DashboardRenderer&) = delete;
+    DashboardRenderer& operator=(const DashboardRenderer&) = delete;
+
+    // Formats a panel's changed fields into the pending frame
+    void update(std::size_t panel, const VehicleState& state);
+
+    // Writes the pending frame with one write() call
+    // @return Bytes written
+    std::size_t flush();
+
+    // update() then flush() for a single-panel dashboard
+    std::size_t render(const VehicleState& state) {
+        update(0, state);
+        return flush();
+    }
+
+    std::size_t panelCount() const { return panels; }
+    std::size_t panelHeight() const { return layout.size(); }
+    bool usesAnsi() const { return ansi; }
+
+private:
+    // One value slot per signal, indexed by Signal
+    static constexpr std::size_t FieldCount = kSignalCount;
+
+    // Where a value slot starts within a panel
+    struct Slot {
+        std::size_t row;
+        std::size_t column;  // 0-based byte offset of the slot within the row's text
+    };
+    // Text shown in one slot on the last frame
+    struct SlotText {
+        char text[kValueWidth];
+        bool drawn = false;
+    };
+
+    void buildLayout();
+    void beginFrame();
+    void formatSlots(const VehicleState& state, char (&out)[FieldCount][kValueWidth]) const;
+    void appendPanel(std::size_t panel, const char (&values)[FieldCount][kValueWidth]);
+    void appendRow(std::size_t panel, std::size_t row);
+    void appendCursor(std::size_t row, std::size_t column);
+    void append(const char* text, std::size_t length);
+
+    std::size_t panels;
+    int fd;
+    bool ansi;
+    bool screenPrepared = false;
+    std::vector<std::string> layout;  // Static text of each panel row, with blank value slots
+    Slot slots[FieldCount];
+    std::vector<SlotText> previous;   // panels * FieldCount
+    std::vector<char> buffer;
+    std::size_t used = 0;
+};
+
+#endif // DASHBOARD_RENDERER_HPP
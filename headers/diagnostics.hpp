@@ -3,31 +3,46 @@
 
 #include <memory>
 #include <sstream>
+#include <string>
 #include <iostream>
 #include <iomanip>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
-#include "sensors.hpp"
-#include "battery.hpp"
 #include "logger.hpp"
+#include "signals.hpp"
+#include "signal_bus.hpp"
+#include "telemetry_log.hpp"
+#include "rule_engine.hpp"
 
 class VehicleDiagnostics {
 public:
-    VehicleDiagnostics(const std::shared_ptr<SpeedSensor>& speedSensor,
-                       const std::shared_ptr<FuelSensor>& fuelSensor,
-                       const std::shared_ptr<TemperatureSensor>& tempSensor,
-                       const std::shared_ptr<Battery>& battery,
-                       const std::shared_ptr<RadarSensor>& radarSensor,
-                       Logger& logger);
+    VehicleDiagnostics(const SignalBus& bus, Logger& logger, std::uint32_t vehicleId = 0);
 
     void runDiagnostics();
 
+    // Replace the rules (vehicle_model::kDiagnosticChecks by default); all rules start cleared
+    void setRules(RuleSet rules);
+    const RuleEngine& ruleEngine() const { return engine; }
+
+    // Print the report to the console as well as the log (on by default)
+    void setConsoleOutput(bool enabled) { consoleOutput = enabled; }
+
 private:
-    std::shared_ptr<SpeedSensor> speedSensor;
-    std::shared_ptr<FuelSensor> fuelSensor;
-    std::shared_ptr<TemperatureSensor> tempSensor;
-    std::shared_ptr<Battery> battery;
-    std::shared_ptr<RadarSensor> radarSensor;
+    void report(const RuleEvent& event);
+    // Subscribes to every signal the rules aggregate, starting after the samples already published
+    void subscribeAggregatedSignals();
+
+    const SignalBus& bus;
     Logger& logger;
+    std::uint32_t vehicleId;
+    bool consoleOutput = true;
+    RuleEngine engine;
+    std::vector<RuleEvent> events;
+    std::string consoleLine;   // Reused for the console report
+    // Samples of aggregated signals are fed to the rule windows in order, not just the latest
+    std::vector<std::pair<Signal, SignalSubscription>> subscriptions;
 };
 
 #endif // VEHICLE_DIAGNOSTICS_H
\ No newline at end of file
@@ -3,8 +3,13 @@
 
 #include <algorithm>
 
+#include "vehicle_model.hpp"
+
+// Raise to low, then cap at high: NaN passes through, and the two selects
+// if-convert in batch loops (see acc_controllers.hpp)
 inline double clamp(double value, double low, double high) {
-    return value < low ? low : (value > high ? high : value);
+    const double raised = value < low ? low : value;
+    return raised > high ? high : raised;
 }
 
 class EngineControlUnit {
@@ -0,0 +1,118 @@
+#ifndef FLEET_HPP
+#define FLEET_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "acc_controllers.hpp"
+#include "rng.hpp"
+#include "vehicle_model.hpp"
+#include "vehicle_state.hpp"
+
+// Per-field arrays holding the state of every vehicle in a Fleet; index i is vehicle i
+struct FleetColumns {
+    std::vector<double> speed;
+    std::vector<double> fuelLevel;
+    std::vector<double> engineTemperature;
+    std::vector<double> batteryCharge;
+    std::vector<double> batteryTemperature;
+    std::vector<double> radarDistance;
+    std::vector<double> throttle;
+    std::vector<double> brakePressure;
+    std::vector<int> gear;
+    // Bit i is set when vehicle_model::kDiagnosticChecks[i] raised a warning on the last diagnostics pass
+    std::vector<std::uint32_t> warnings;
+};
+
+class CheckpointReader;
+class CheckpointWriter;
+class FleetVehicle;
+
+// Struct-of-arrays simulation of many vehicles with the same semantics as Vehicle
+class Fleet {
+public:
+    // Vehicles processed per batch; sizes the stack buffer of random draws
+    static constexpr std::size_t kKernelBlock = 512;
+
+    explicit Fleet(std::size_t vehicleCount, std::uint64_t seed = std::random_device{}());
+
+    std::size_t size() const { return count; }
+
+    // Stage kernels over the vehicle range [begin, end)
+    void updateSensors(std::size_t begin, std::size_t end) { updateSensors(begin, end, currentTick); }
+    // Sensor update with the draws of a given tick, for stepping vehicles apart from the fleet (FleetVehicle)
+    void updateSensors(std::size_t begin, std::size_t end, std::uint64_t tick);
+    void adaptiveCruiseControl(std::size_t begin, std::size_t end);
+    void runDiagnostics(std::size_t begin, std::size_t end);
+
+    // Selects the ACC controller (the band rule on the SIMD kernel by default). Stateful controllers
+    // get a state per vehicle, reset here; dtSeconds is the time between their steps (one tick).
+    void setAccController(acc::ControllerKind kind, double dtSeconds = vehicle_model::kAccPeriodSeconds);
+    acc::ControllerKind accController() const { return accKind; }
+
+    // Runs all stages over every vehicle, in the same order as the single-vehicle loop, then advances the tick
+    void tick();
+
+    // Moves the random streams on to the next tick; call once after all ranges of a tick are done
+    void advanceTick() { ++currentTick; }
+    std::uint64_t tickIndex() const { return currentTick; }
+    std::uint64_t seed() const { return rngSeed; }
+
+    VehicleState state(std::size_t index) const;
+    FleetVehicle vehicle(std::size_t index);
+
+    FleetColumns& columns() { return data; }
+    const FleetColumns& columns() const { return data; }
+
+    // Column holding a signal, or nullptr for signals not stored as doubles
+    const std::vector<double>* column(Signal signal) const;
+
+    // Write every column and the ACC controller's states to a checkpoint, or read them back and resume
+    // at the checkpoint's tick (see checkpoint.hpp); the random streams need no state of their own
+    void saveState(CheckpointWriter& writer) const;
+    void restoreState(CheckpointReader& reader);
+
+private:
+    std::vector<double>* column(Signal signal);   // Mutable overload, for restoreState
+
+    std::size_t count;
+    FleetColumns data;
+    std::uint64_t rngSeed;
+    std::uint64_t currentTick = 0;
+    acc::ControllerKind accKind = acc::ControllerKind::Band;
+    double accDtSeconds = vehicle_model::kAccPeriodSeconds;
+    std::vector<acc::TimeGapPid<>::State> pidStates;             // Sized only while the PID runs
+    std::vector<acc::ConstantTimeHeadway<>::State> cthStates;    // Likewise for constant time headway
+};
+
+// Adapter exposing one vehicle of a Fleet through the Vehicle interface.
+//
+// Like a Vehicle, the adapter steps its vehicle on a tick of its own: it starts
+// at the fleet's current tick and each updateSensors() draws that tick's values
+// and moves on, so repeated updates do not redraw the same readings. Vehicle i
+// stepped through an adapter follows the same trajectory as a Vehicle with id i.
+// Stepping a vehicle both through an adapter and with Fleet::tick() replays draws.
+class FleetVehicle {
+public:
+    FleetVehicle(Fleet& fleet, std::size_t index);
+
+    void updateSensors();
+    void adaptiveCruiseControl();
+    void displayDashboard();
+    void runDiagnostics();
+
+    VehicleState state() const;
+    std::uint32_t warnings() const;
+    std::size_t index() const { return vehicleIndex; }
+    // Tick the next updateSensors() draws for
+    std::uint64_t tickIndex() const { return tick; }
+
+private:
+    Fleet& fleet;
+    std::size_t vehicleIndex;
+    std::uint64_t tick;
+};
+
+#endif // FLEET_HPP
@@ -0,0 +1,86 @@
+#ifndef HEADLESS_HPP
+#define HEADLESS_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "acc_controllers.hpp"
+#include "columnar_exporter.hpp"
+#include "instrumentation.hpp"
+#include "signal_history.hpp"
+
+// Options for a headless run
+struct HeadlessConfig {
+    std::uint64_t ticks = 100000;
+    std::chrono::nanoseconds dt = std::chrono::milliseconds(10);  // Simulated time per tick
+    std::uint64_t seed = 0;
+    std::size_t vehicles = 1;         // 1 = a full Vehicle with logging; more = a Fleet on the TickEngine
+    std::size_t threads = 0;          // Fleet runs only; 0 = hardware concurrency
+    acc::ControllerKind acc = acc::ControllerKind::Band;   // Fleet runs only; a Vehicle runs VehicleAccController
+    std::string logPath = "headless.log";
+    std::string logLevels;            // Logger::Configure spec, e.g. "info,sensors=debug"; empty = Info everywhere
+    std::string telemetryPath;        // Binary telemetry file; empty = none
+    std::string rulesPath;            // Diagnostic rules file; empty = built-in rules
+    std::string shmName;              // Live state shared-memory segment; empty = none
+    std::string metricsEndpoint;      // Prometheus metrics socket path or localhost port; empty = none
+    std::string columnarPath;         // Columnar snapshot file of every vehicle's state; empty = none
+    std::uint64_t columnarEvery = 100;  // Ticks between columnar snapshots
+    std::string checkpointPath;       // Checkpoint written at the end of the run; empty = none (fleet runs only)
+    std::uint64_t checkpointEvery = 0;  // Also rewrite it every N ticks; 0 = only at the end
+    std::string restorePath;          // Checkpoint to resume from; its vehicles, seed and dt replace the options'
+    std::string recordPath;           // Sensor recording to write; empty = none (single vehicle only)
+    double historySeconds = 0.0;      // Compressed signal history retention; 0 = no history
+    double historyResolution = 0.01;  // Values kept in the history are rounded to this; 0 = exact
+    std::string replayPath;           // Sensor recording to drive the vehicle from; the run ends with it (single vehicle only)
+};
+
+// Wall time spent in one stage of the pipeline
+struct StageReport {
+    std::string name;
+    std::uint64_t calls = 0;
+    std::uint64_t totalNs = 0;
+};
+
+// Throughput and latency summary of a headless run
+struct HeadlessReport {
+    HeadlessConfig config;
+    double simulatedSeconds = 0.0;
+    double wallSeconds = 0.0;
+    std::vector<StageReport> stages;
+    std::uint64_t logBytes = 0;
+    std::uint64_t telemetryBytes = 0;
+    std::uint64_t ruleTransitions = 0;  // Diagnostic rules raised or cleared (fleet runs)
+    std::uint64_t historySamples = 0;   // Samples retained in the signal history at the end
+    std::uint64_t historyBytes = 0;     // Memory held by the signal history
+    ColumnarStats columnar;             // Columnar export sizes (when columnarPath is set)
+    std::uint64_t firstTick = 0;        // Tick the run started at (restored runs)
+    double restoreSeconds = 0.0;        // Wall time spent restoring the checkpoint
+    std::uint64_t checkpoints = 0;      // Checkpoints written
+    std::uint64_t checkpointBytes = 0;  // Size of the last one
+    double checkpointSeconds = 0.0;     // Wall time spent writing them, included in wallSeconds
+    InstrumentationSnapshot latency;    // Probe latencies and counters at the end of the run
+
+    double ticksPerSecond() const { return wallSeconds > 0.0 ? config.ticks / wallSeconds : 0.0; }
+    double vehicleTicksPerSecond() const { return ticksPerSecond() * config.vehicles; }
+    double realtimeFactor() const { return wallSeconds > 0.0 ? simulatedSeconds / wallSeconds : 0.0; }
+};
+
+// Runs the simulation for a fixed number of ticks in virtual time, as fast as
+// possible and without console output.
+//
+// A single vehicle runs the same multi-rate task schedule as the interactive
+// mode (minus the dashboard), advanced by dt of virtual time per tick. A fleet
+// advances every vehicle through all stages once per tick on the TickEngine.
+HeadlessReport runHeadless(const HeadlessConfig& config);
+
+// Builds the history settings of a run
+HistoryConfig historyConfig(const HeadlessConfig& config);
+
+// Prints the report as aligned text
+void printHeadlessReport(std::ostream& os, const HeadlessReport& report);
+
+#endif // HEADLESS_HPP
@@ -0,0 +1,207 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <mutex>
+#include <vector>
+
+// Hot-path latency instrumentation.
+//
+//   void Vehicle::runDiagnostics() {
+//       VT_PROBE(Diagnostics);   // Times the rest of the scope
+//       ...
+//   }
+//
+// Each thread records into histograms of its own, so a probe takes no lock and
+// shares no cache line with other threads; Snapshot() merges every thread's
+// histograms per probe for reporting. Time comes from the TSC when the CPU has
+// an invariant one (calibrated against steady_clock on first use), otherwise
+// from steady_clock. SetEnabled(false) turns every probe into a relaxed load
+// and a branch; building with VT_INSTRUMENTATION=0 removes them altogether.
+
+#ifndef VT_INSTRUMENTATION
+#define VT_INSTRUMENTATION 1
+#endif
+
+// Instrumented stages. In fleet runs Sensors, Acc, Diagnostics, Rules and Export
+// time one chunk of vehicles; in single-vehicle runs they time one task activation.
+// Rules is rule evaluation alone; Export is the shm, history, metrics and columnar
+// work done with a chunk after it.
+enum class Probe : std::uint8_t {
+    Tick, Sensors, Acc, Diagnostics, Rules, Export, Dashboard, Telemetry, Log, LogWrite, Count
+};
+
+// Event counts kept next to the latencies
+enum class Counter : std::uint8_t { LogRecords, LogBytes, LogDropped, WarningsRaised, Count };
+
+constexpr std::size_t kProbeCount = static_cast<std::size_t>(Probe::Count);
+constexpr std::size_t kCounterCount = static_cast<std::size_t>(Counter::Count);
+
+/// Returns the name of a probe, as used in reports.
+inline const char* probeName(Probe probe) {
+    switch (probe) {
+        case Probe::Tick: return "tick";
+        case Probe::Sensors: return "sensors";
+        case Probe::Acc: return "acc";
+        case Probe::Diagnostics: return "diagnostics";
+        case Probe::Rules: return "rules";
+        case Probe::Export: return "export";
+        case Probe::Dashboard: return "dashboard";
+        case Probe::Telemetry: return "telemetry";
+        case Probe::Log: return "log";
+        case Probe::LogWrite: return "log-write";
+        default: return "unknown";
+    }
+}
+
+/// Returns the name of a counter, as used in reports.
+inline const char* counterName(Counter counter) {
+    switch (counter) {
+        case Counter::LogRecords: return "log records";
+        case Counter::LogBytes: return "log bytes";
+        case Counter::LogDropped: return "log dropped";
+        case Counter::WarningsRaised: return "warnings raised";
+        default: return "unknown";
+    }
+}
+
+// Histogram of durations in log-scaled buckets (as in HdrHistogram): exact below
+// 64 ns, then 32 buckets per power of two, so a percentile is at most ~3% high.
+// Durations of 2^36 ns (about 69 s) and more share the last bucket.
+class LatencyHistogram {
+public:
+    static constexpr unsigned kSubBucketBits = 5;
+    static constexpr std::size_t kSubBuckets = std::size_t{1} << kSubBucketBits;
+    static constexpr unsigned kMaxBits = 36;
+    static constexpr std::size_t kBucketCount = (kMaxBits - kSubBucketBits + 1) * kSubBuckets;
+
+    static std::size_t bucketIndex(std::uint64_t ns) {
+        if (ns < 2 * kSubBuckets) {
+            return static_cast<std::size_t>(ns);
+        }
+        if (ns >> kMaxBits != 0) {
+            return kBucketCount - 1;
+        }
+        const unsigned shift = 63 - static_cast<unsigned>(__builtin_clzll(ns)) - kSubBucketBits;
+        return shift * kSubBuckets + static_cast<std::size_t>(ns >> shift);
+    }
+    // Highest duration that falls into a bucket
+    static std::uint64_t bucketUpperBound(std::size_t index);
+
+    void record(std::uint64_t ns);
+    // Adds count durations to one bucket; with include() this rebuilds a histogram from its parts
+    void recordBucket(std::size_t index, std::uint64_t count) { buckets[index] += count; total += count; }
+    // Widens the extremes and adds to the sum, for durations added with recordBucket()
+    void include(std::uint64_t minNs, std::uint64_t maxNs, std::uint64_t sumNs);
+    void merge(const LatencyHistogram& other);
+    void reset();
+
+    std::uint64_t count() const { return total; }
+    std::uint64_t minNs() const { return total > 0 ? lowest : 0; }
+    std::uint64_t maxNs() const { return highest; }
+    std::uint64_t sumNs() const { return sum; }
+    double meanNs() const { return total > 0 ? static_cast<double>(sum) / total : 0.0; }
+    // Duration at or below which `percent` percent of the recorded durations fall, e.g. 99.9
+    std::uint64_t percentileNs(double percent) const;
+
+private:
+    std::array<std::uint64_t, kBucketCount> buckets{};
+    std::uint64_t total = 0;
+    std::uint64_t sum = 0;
+    std::uint64_t lowest = UINT64_MAX;
+    std::uint64_t highest = 0;
+};
+
+// Merged view of every thread's measurements
+struct InstrumentationSnapshot {
+    std::vector<LatencyHistogram> probes = std::vector<LatencyHistogram>(kProbeCount);
+    std::array<std::uint64_t, kCounterCount> counters{};
+    const char* clock = "";   // "tsc" or "steady_clock"
+
+    const LatencyHistogram& probe(Probe p) const { return probes[static_cast<std::size_t>(p)]; }
+    std::uint64_t counter(Counter c) const { return counters[static_cast<std::size_t>(c)]; }
+};
+
+class Instrumentation {
+public:
+    // Get the process-wide instance; the first call picks and calibrates the clock
+    static Instrumentation& GetInstance();
+
+    // Whether probes record; on by default
+    static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+    static void SetEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+
+    // Current time in clock ticks, for measuring a duration with TicksToNs()
+    std::uint64_t Now() const;
+    std::uint64_t TicksToNs(std::uint64_t ticks) const {
+        return static_cast<std::uint64_t>((static_cast<unsigned __int128>(ticks) * nsPerTickQ32) >> 32);
+    }
+    const char* ClockName() const { return useTsc ? "tsc" : "steady_clock"; }
+
+    // Record a duration or count events on the calling thread (declarations); no-ops while disabled
+    static void Record(Probe probe, std::uint64_t ns);
+    static void Add(Counter counter, std::uint64_t n = 1);
+
+    // Merge the histograms and counters of every thread that has recorded (declaration)
+    InstrumentationSnapshot Snapshot() const;
+
+private:
+    struct ThreadMetrics;
+
+    Instrumentation();
+    Instrumentation(const Instrumentation&) = delete;
+    Instrumentation& operator=(const Instrumentation&) = delete;
+
+    static ThreadMetrics& Local();
+
+    static inline std::atomic<bool> enabled{true};
+    bool useTsc = false;
+    std::uint64_t nsPerTickQ32 = std::uint64_t{1} << 32;   // ns per tick, 32.32 fixed point
+    mutable std::mutex registryMutex;
+    std::vector<ThreadMetrics*> threads;   // Never freed: a thread's counts outlive it
+};
+
+// Times its scope into a probe's histogram; started only if instrumentation is enabled
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Probe probe)
+        : probe(probe), start(Instrumentation::IsEnabled() ? Instrumentation::GetInstance().Now() : 0) {}
+    ~ScopedTimer() {
+        if (start != 0) {
+            const Instrumentation& instrumentation = Instrumentation::GetInstance();
+            Instrumentation::Record(probe, instrumentation.TicksToNs(instrumentation.Now() - start));
+        }
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Probe probe;
+    std::uint64_t start;   // 0 = not timing
+};
+
+// Writes the merged latencies (p50/p99/p99.9/max per probe) and counters as an aligned table
+void printInstrumentationReport(std::ostream& os, const InstrumentationSnapshot& snapshot);
+
+#define VT_PROBE_CONCAT_(a, b) a##b
+#define VT_PROBE_CONCAT(a, b) VT_PROBE_CONCAT_(a, b)
+
+#if VT_INSTRUMENTATION
+// Times the rest of the enclosing scope, e.g. VT_PROBE(Diagnostics)
+#define VT_PROBE(probe) ScopedTimer VT_PROBE_CONCAT(vtProbe, __LINE__)(Probe::probe)
+// Records a duration measured by the caller, e.g. VT_RECORD(Acc, elapsedNs)
+#define VT_RECORD(probe, ns) Instrumentation::Record(Probe::probe, (ns))
+// Adds to a counter, e.g. VT_COUNT(LogBytes, size)
+#define VT_COUNT(counter, n) Instrumentation::Add(Counter::counter, (n))
+#else
+#define VT_PROBE(probe) static_cast<void>(0)
+#define VT_RECORD(probe, ns) static_cast<void>(0)
+#define VT_COUNT(counter, n) static_cast<void>(0)
+#endif
+
+#endif // INSTRUMENTATION_HPP
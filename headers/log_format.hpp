@@ -0,0 +1,172 @@
+#ifndef LOG_FORMAT_HPP
+#define LOG_FORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Format strings for Logger::Log, checked at compile time.
+//
+//   logger.Log(VT_FMT("Radar distance: {:.2f} m, gear {}"), distance, gear);
+//
+// Placeholders are {} (any argument) and {:.Nf} (a floating-point argument
+// with N = 0-99 decimals); {{ and }} are literal braces. VT_FMT wraps the
+// literal in a type of its own, so the placeholder count, brace balance and
+// precision specs are checked against the argument types with static_assert.
+//
+// Arguments may be bool, char, integers, floating point, or text (const char*,
+// std::string, std::string_view). They are captured as typed Arg values and
+// only turned into text when the line is written; the logger copies them into
+// a fixed-size record payload for its asynchronous queue (see encode()).
+namespace log_format {
+
+// Base of the types VT_FMT creates
+struct FormatTag {};
+
+enum class ArgType : std::uint8_t { Bool, Char, Signed, Unsigned, Double, Text };
+
+// One argument, viewed without copying its text; only the member for its type is set
+struct Arg {
+    ArgType type;
+    std::int64_t integer;           // Bool, Char, Signed
+    std::uint64_t unsignedInteger;
+    double number;
+    std::string_view text;
+};
+
+// Most arguments a single message may have
+constexpr std::size_t kMaxArgs = 16;
+// Bytes of argument payload a queued record carries
+constexpr std::size_t kPayloadBytes = 96;
+
+template <typename T>
+constexpr bool isText = std::is_convertible<const T&, std::string_view>::value;
+
+template <typename T>
+constexpr bool isLoggable = std::is_arithmetic<T>::value || isText<T>;
+
+template <typename T>
+Arg makeArg(const T& value) {
+    static_assert(isLoggable<T>, "log argument must be bool, char, an integer, floating point or text");
+    Arg arg{};
+    if constexpr (std::is_same<T, bool>::value) {
+        arg.type = ArgType::Bool;
+        arg.integer = value;
+    } else if constexpr (std::is_same<T, char>::value) {
+        arg.type = ArgType::Char;
+        arg.integer = value;
+    } else if constexpr (std::is_floating_point<T>::value) {
+        arg.type = ArgType::Double;
+        arg.number = static_cast<double>(value);
+    } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+        arg.type = ArgType::Signed;
+        arg.integer = value;
+    } else if constexpr (std::is_integral<T>::value) {
+        arg.type = ArgType::Unsigned;
+        arg.unsignedInteger = value;
+    } else if constexpr (std::is_pointer<T>::value) {
+        arg.type = ArgType::Text;
+        arg.text = value != nullptr ? std::string_view(value) : std::string_view("(null)");
+    } else {
+        arg.type = ArgType::Text;
+        arg.text = std::string_view(value);
+    }
+    return arg;
+}
+
+enum class FormatError { None, UnmatchedBrace, BadSpec, TooFewArguments, TooManyArguments, PrecisionNeedsFloat };
+
+// Validates a format against its arguments; floating[i] tells whether argument i is floating point
+constexpr FormatError check(const char* format, const bool* floating, std::size_t count) {
+    std::size_t next = 0;
+    for (const char* p = format; *p != '\0'; ++p) {
+        if (*p == '}') {
+            if (p[1] != '}') {
+                return FormatError::UnmatchedBrace;
+            }
+            ++p;
+            continue;
+        }
+        if (*p != '{') {
+            continue;
+        }
+        if (p[1] == '{') {
+            ++p;
+            continue;
+        }
+        ++p;
+        if (*p == ':') {
+            if (p[1] != '.' || p[2] < '0' || p[2] > '9') {
+                return FormatError::BadSpec;
+            }
+            p += 3;
+            if (*p >= '0' && *p <= '9') {
+                ++p;
+            }
+            if (*p != 'f') {
+                return FormatError::BadSpec;
+            }
+            ++p;
+            if (next < count && !floating[next]) {
+                return FormatError::PrecisionNeedsFloat;
+            }
+        }
+        if (*p != '}') {
+            return *p == '\0' ? FormatError::UnmatchedBrace : FormatError::BadSpec;
+        }
+        if (next == count) {
+            return FormatError::TooFewArguments;
+        }
+        ++next;
+    }
+    return next == count ? FormatError::None : FormatError::TooManyArguments;
+}
+
+// Fails compilation if Format (from VT_FMT) does not match the argument types
+template <typename Format, typename... Args>
+constexpr void validate() {
+    static_assert(std::is_base_of<FormatTag, Format>::value, "log formats must be written as VT_FMT(\"...\")");
+    static_assert(sizeof...(Args) <= kMaxArgs, "too many log arguments");
+    constexpr bool floating[] = {std::is_floating_point<Args>::value..., false};
+    constexpr FormatError error = check(Format::text(), floating, sizeof...(Args));
+    static_assert(error != FormatError::UnmatchedBrace, "log format has an unmatched '{' or '}' (use {{ and }})");
+    static_assert(error != FormatError::BadSpec, "log format placeholders must be {} or {:.Nf}");
+    static_assert(error != FormatError::TooFewArguments, "log format has more placeholders than arguments");
+    static_assert(error != FormatError::TooManyArguments, "log format has fewer placeholders than arguments");
+    static_assert(error != FormatError::PrecisionNeedsFloat, "{:.Nf} needs a floating-point argument");
+}
+
+// Appends a format with its arguments substituted to out
+void format(std::string& out, const char* format, const Arg* args, std::size_t count);
+
+// Copies arguments into a record payload: per argument a type byte and the value,
+// text as a 16-bit length and its bytes. Sets used to the bytes taken.
+// @return false if they do not fit in kPayloadBytes
+bool encode(unsigned char (&payload)[kPayloadBytes], std::uint16_t& used, const Arg* args, std::size_t count);
+
+// Reads back arguments written by encode(); text views point into the payload
+// @return Number of arguments
+std::size_t decode(const unsigned char* payload, std::size_t used, Arg (&args)[kMaxArgs]);
+
+// Formats a VT_FMT format with its arguments into out, e.g. for console output
+template <typename Format, typename... Args>
+void formatTo(std::string& out, Format, const Args&... args) {
+    validate<Format, Args...>();
+    const Arg packed[] = {makeArg(args)..., Arg{}};
+    format(out, Format::text(), packed, sizeof...(Args));
+}
+
+} // namespace log_format
+
+// A compile-time checked log format string; see log_format.hpp
+#define VT_FMT(literal)                                                       \
+    [] {                                                                      \
+        struct Format : log_format::FormatTag {                               \
+            static constexpr const char* text() { return literal; }           \
+        };                                                                    \
+        return Format{};                                                      \
+    }()
+
+#endif // LOG_FORMAT_HPP
@@ -6,15 +6,133 @@
 #include <iostream>
 #include <chrono>
 #include <iomanip>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+#include "bounded_queue.hpp"
+#include "instrumentation.hpp"
+#include "log_format.hpp"
+
+// Levels below this are compiled out of the VT_LOG macros (0 trace, 1 debug, 2 info, 3 warning, 4 error)
+#ifndef VT_LOG_MIN_LEVEL
+#define VT_LOG_MIN_LEVEL 0
+#endif
+
+// Severity of a message; a category's threshold of Off disables it
+enum class LogLevel : std::uint8_t { Trace, Debug, Info, Warning, Error, Off };
+
+// Subsystem a message comes from, each with its own threshold
+enum class LogCategory : std::uint8_t { General, Sensors, Acc, Diagnostics, Dashboard, Count };
+
+constexpr std::size_t kLogCategoryCount = static_cast<std::size_t>(LogCategory::Count);
+
+// Lowest level the VT_LOG macros compile in
+constexpr LogLevel kCompiledLogLevel = static_cast<LogLevel>(VT_LOG_MIN_LEVEL);
+
+/// Returns the lowercase name of a level, as used in log lines and --log-level.
+inline const char* logLevelName(LogLevel level) {
+    switch (level) {
+        case LogLevel::Trace: return "trace";
+        case LogLevel::Debug: return "debug";
+        case LogLevel::Info: return "info";
+        case LogLevel::Warning: return "warning";
+        case LogLevel::Error: return "error";
+        case LogLevel::Off: return "off";
+        default: return "unknown";
+    }
+}
+
+/// Returns the lowercase name of a category, as used in log lines and --log-level.
+inline const char* logCategoryName(LogCategory category) {
+    switch (category) {
+        case LogCategory::General: return "general";
+        case LogCategory::Sensors: return "sensors";
+        case LogCategory::Acc: return "acc";
+        case LogCategory::Diagnostics: return "diagnostics";
+        case LogCategory::Dashboard: return "dashboard";
+        default: return "unknown";
+    }
+}
+
+// What Log() does when the asynchronous queue is full
+enum class OverflowPolicy {
+    Block,       // Wait for the writer thread to make room
+    DropNewest,  // Discard the message being logged
+    DropOldest   // Discard the oldest queued message to make room
+};
 
 class Logger {
 public:
     // Get the Singleton instance and set the log file path (declaration)
     static Logger& GetInstance(const std::string& filePath = "");
 
-    // Method to log a message (declaration)
+    // Method to log a message at Info level in the General category (declaration)
     void Log(const std::string& message);
 
+    // Log a message formatted from a VT_FMT format string, e.g.
+    // Log(LogLevel::Info, LogCategory::Acc, VT_FMT("Radar distance: {:.2f} m"), distance).
+    // The format is checked against the arguments at compile time; the arguments
+    // are captured as typed values and formatted only when the line is written.
+    // Does not allocate unless the arguments' text exceeds log_format::kPayloadBytes.
+    // Prefer the VT_LOG macros, which skip evaluating the arguments of disabled messages.
+    template <typename Format, typename... Args,
+              typename = std::enable_if_t<std::is_base_of<log_format::FormatTag, Format>::value>>
+    void Log(LogLevel level, LogCategory category, Format, const Args&... args) {
+        log_format::validate<Format, Args...>();
+        if (!IsEnabled(category, level)) {
+            return;
+        }
+        const log_format::Arg packed[] = {log_format::makeArg(args)..., log_format::Arg{}};
+        Write(level, category, Format::text(), packed, sizeof...(Args));
+    }
+
+    // The same at Info level in the General category
+    template <typename Format, typename... Args,
+              typename = std::enable_if_t<std::is_base_of<log_format::FormatTag, Format>::value>>
+    void Log(Format format, const Args&... args) {
+        Log(LogLevel::Info, LogCategory::General, format, args...);
+    }
+
+    // Whether messages of a level in a category are currently written
+    bool IsEnabled(LogCategory category, LogLevel level) const {
+        return level >= thresholds[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+    }
+
+    // Set the lowest level written, for every category or for one (declarations)
+    void SetLevel(LogLevel level);
+    void SetLevel(LogCategory category, LogLevel level);
+    LogLevel GetLevel(LogCategory category) const;
+
+    // Apply thresholds from a spec such as "info,sensors=debug,dashboard=off": a bare
+    // level applies to every category, category=level to one (declaration).
+    // Throws std::runtime_error on unknown names.
+    void Configure(std::string_view spec);
+
+    // Switch to asynchronous mode with a background writer thread (declaration)
+    void EnableAsync(std::size_t queueCapacity = 8192, OverflowPolicy policy = OverflowPolicy::Block);
+
+    // Block until every message logged so far has reached the file (declaration)
+    void Flush();
+
+    // Drain the queue, stop the writer thread and return to synchronous mode (declaration)
+    void Shutdown();
+
+    // Number of messages discarded by the overflow policy (declaration)
+    std::uint64_t GetDroppedCount() const;
+
+    // Number of bytes written to the log file so far (declaration)
+    std::uint64_t GetBytesWritten() const;
+
+    // Number of messages queued but not yet written; 0 in synchronous mode (declaration)
+    std::uint64_t GetQueueDepth() const;
+
     private:
     // Private constructor and destructor (declarations)
     Logger();
@@ -24,11 +142,123 @@ public:
     Logger(const Logger&) = delete;
     Logger& operator=(const Logger&) = delete;
 
+    // A message waiting in the asynchronous queue: its format and raw arguments,
+    // formatted by the writer thread
+    struct LogRecord {
+        std::chrono::system_clock::time_point time;
+        const char* format = nullptr;   // Static VT_FMT text; nullptr if the message is in spill
+        LogLevel level = LogLevel::Info;
+        LogCategory category = LogCategory::General;
+        std::uint16_t argBytes = 0;
+        unsigned char args[log_format::kPayloadBytes];
+        std::string spill;              // The formatted message when its arguments did not fit in args
+    };
+
+    // Formats "YYYY-MM-DD HH:MM:SS" once per second instead of once per message
+    struct TimestampCache {
+        std::time_t second = -1;
+        char text[32] = {};
+        std::size_t length = 0;
+        const char* format(std::chrono::system_clock::time_point time);
+    };
+
     std::ofstream logFile;
     bool isInitialized = false;
+    std::atomic<LogLevel> thresholds[kLogCategoryCount];
+
+    // Asynchronous mode state
+    std::unique_ptr<BoundedQueue<LogRecord>> queue;
+    std::thread writerThread;
+    std::atomic<bool> asyncEnabled{false};
+    std::atomic<bool> stopRequested{false};
+    std::atomic<bool> writerSleeping{false};
+    OverflowPolicy overflowPolicy = OverflowPolicy::Block;
+    std::mutex asyncMutex;
+    std::condition_variable writerWakeup;
+    std::condition_variable flushDone;
+    std::atomic<std::uint64_t> pushedCount{0};
+    std::atomic<std::uint64_t> processedCount{0};
+    std::atomic<std::uint64_t> droppedCount{0};
+    std::atomic<std::uint64_t> bytesWritten{0};
+    TimestampCache timestampCache;
+    std::string batchBuffer;
 
     // Set the log file path (declaration, forward declaration for Logger)
     void SetLogFile(const std::string& filePath);
+
+    void Write(LogLevel level, LogCategory category, const char* format, const log_format::Arg* args,
+               std::size_t count);
+    static void AppendTag(std::string& out, LogLevel level, LogCategory category);
+    void Enqueue(LogRecord&& record);
+    void WakeWriter();
+    void WriterLoop();
+    std::size_t DrainBatch();
+    void AppendLine(std::string& out, const LogRecord& record);
+};
+
+// Per-call-site state of VT_LOG_EVERY_N: lets the 1st, (n+1)th, (2n+1)th... enabled call through
+class LogEveryN {
+public:
+    bool ShouldLog(std::uint64_t n) {
+        return calls.fetch_add(1, std::memory_order_relaxed) % (n == 0 ? 1 : n) == 0;
+    }
+
+private:
+    std::atomic<std::uint64_t> calls{0};
+};
+
+// Per-call-site state of VT_LOG_RATE_LIMITED: at most `limit` messages per wall-clock second
+class LogRateLimiter {
+public:
+    bool ShouldLog(std::uint32_t limit);
+
+private:
+    std::atomic<std::int64_t> window{-1};   // Steady-clock second being counted
+    std::atomic<std::uint32_t> passed{0};
 };
 
-#endif // LOGGER_HPP
\ No newline at end of file
+// Logging macros. A level below VT_LOG_MIN_LEVEL compiles to nothing (the format
+// is still checked); otherwise the category's threshold is checked first, and the
+// arguments are only evaluated for messages that will be written, e.g.
+//   VT_LOG_WARNING(logger, Diagnostics, "{} read {:.2f}", name, value);
+//   VT_LOG_EVERY_N(logger, Debug, Sensors, 100, "{} updated.", name);   // 1 in 100
+//   VT_LOG_RATE_LIMITED(logger, Info, Acc, 5, "Braking at {:.1f} m", distance);   // 5 per second
+#define VT_LOG(logger, level, category, format, ...)                                                 \
+    do {                                                                                             \
+        if constexpr (LogLevel::level >= kCompiledLogLevel) {                                        \
+            Logger& vtLogger = (logger);                                                             \
+            if (vtLogger.IsEnabled(LogCategory::category, LogLevel::level)) {                        \
+                vtLogger.Log(LogLevel::level, LogCategory::category, VT_FMT(format), ##__VA_ARGS__); \
+            }                                                                                        \
+        }                                                                                            \
+    } while (false)
+
+#define VT_LOG_EVERY_N(logger, level, category, n, format, ...)                                         \
+    do {                                                                                                \
+        if constexpr (LogLevel::level >= kCompiledLogLevel) {                                           \
+            Logger& vtLogger = (logger);                                                                \
+            static LogEveryN vtSampler;                                                                 \
+            if (vtLogger.IsEnabled(LogCategory::category, LogLevel::level) && vtSampler.ShouldLog(n)) { \
+                vtLogger.Log(LogLevel::level, LogCategory::category, VT_FMT(format), ##__VA_ARGS__);    \
+            }                                                                                           \
+        }                                                                                               \
+    } while (false)
+
+#define VT_LOG_RATE_LIMITED(logger, level, category, perSecond, format, ...)                                    \
+    do {                                                                                                        \
+        if constexpr (LogLevel::level >= kCompiledLogLevel) {                                                   \
+            Logger& vtLogger = (logger);                                                                        \
+            static LogRateLimiter vtLimiter;                                                                    \
+            if (vtLogger.IsEnabled(LogCategory::category, LogLevel::level) && vtLimiter.ShouldLog(perSecond)) { \
+                vtLogger.Log(LogLevel::level, LogCategory::category, VT_FMT(format), ##__VA_ARGS__);            \
+            }                                                                                                   \
+        }                                                                                                       \
+    } while (false)
+
+#define VT_LOG_TRACE(logger, category, format, ...) VT_LOG(logger, Trace, category, format, ##__VA_ARGS__)
+#define VT_LOG_DEBUG(logger, category, format, ...) VT_LOG(logger, Debug, category, format, ##__VA_ARGS__)
+#define VT_LOG_INFO(logger, category, format, ...) VT_LOG(logger, Info, category, format, ##__VA_ARGS__)
+#define VT_LOG_WARNING(logger, category, format, ...) VT_LOG(logger, Warning, category, format, ##__VA_ARGS__)
+#define VT_LOG_ERROR(logger, category, format, ...) VT_LOG(logger, Error, category, format, ##__VA_ARGS__)
+
+#endif // LOGGER_HPP
@@ -0,0 +1,73 @@
+#ifndef METRICS_EXPORTER_HPP
+#define METRICS_EXPORTER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "rule_engine.hpp"
+
+// Serves the simulator's current metrics in the Prometheus text format
+// (version 0.0.4) on a Unix domain socket or a localhost TCP port:
+//
+//   curl --unix-socket /tmp/vehicle.metrics http://localhost/metrics
+//   curl http://127.0.0.1:9464/metrics
+//
+// Exported: vehicles with each diagnostic rule raised (with the default rules:
+// low fuel, overheating, vehicle ahead too close...), per-stage latency
+// summaries and counters from Instrumentation, the logger's queue depth and the
+// ticks run. A background thread renders the page every refreshPeriod and
+// answers scrapes with the last rendering, so a scrape costs O(metrics) and never
+// touches the simulation. The simulation threads only update per-rule counts
+// from rule transitions, which costs nothing per vehicle while states hold.
+class MetricsExporter {
+public:
+    // endpoint is a socket path, or a port number to listen on 127.0.0.1.
+    // Throws std::runtime_error if the endpoint cannot be opened.
+    MetricsExporter(const std::string& endpoint, const RuleSet& rules, std::size_t vehicleCount,
+                    std::chrono::milliseconds refreshPeriod = std::chrono::seconds(1));
+    ~MetricsExporter();
+
+    MetricsExporter(const MetricsExporter&) = delete;
+    MetricsExporter& operator=(const MetricsExporter&) = delete;
+
+    // Applies rule transitions to the per-rule vehicle counts; may be called from several threads at once
+    void recordEvents(const std::vector<RuleEvent>& events);
+
+    // Recounts the vehicles with each rule raised; O(vehicles x rules), for single-vehicle runs
+    // and to seed the counts of a run restored from a checkpoint
+    void countActive(const RuleEngine& engine);
+
+    // Number of ticks completed, for runs that have ticks
+    void setTicks(std::uint64_t ticks) { tickCount.store(ticks, std::memory_order_relaxed); }
+
+    std::uint64_t scrapeCount() const { return scrapes.load(std::memory_order_relaxed); }
+    const std::string& endpoint() const { return endpointName; }
+
+private:
+    void run();
+    void render(std::string& out) const;
+    void serve(int client);
+
+    std::string endpointName;
+    std::string socketPath;   // Unlinked on destruction; empty for TCP
+    RuleSet rules;
+    std::size_t vehicles;
+    std::chrono::milliseconds refreshPeriod;
+    std::unique_ptr<std::atomic<std::int64_t>[]> activeVehicles;   // Per rule
+    std::atomic<std::uint64_t> tickCount{UINT64_MAX};                // UINT64_MAX until setTicks()
+    std::atomic<std::uint64_t> scrapes{0};
+    std::atomic<bool> stopRequested{false};
+    int listenFd = -1;
+    int wakeFds[2] = {-1, -1};   // Pipe that wakes the server thread to stop
+    std::string page;            // Last rendering, only touched by the server thread
+    std::string nextPage;
+    std::thread server;
+};
+
+#endif // METRICS_EXPORTER_HPP
@@ -0,0 +1,175 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Counter-based random numbers.
+//
+// A draw is a pure function of (seed, vehicle id, channel, tick): there is no
+// generator state to share, lock or seed per thread, and any draw can be
+// recomputed in any order. The generator is a policy with a block function
+// mapping a 128-bit counter and a 64-bit key to 128 random bits: Philox4x32-10
+// (the default) or Threefry4x32-20. One block yields two doubles, used by the
+// vehicle pair (2k, 2k + 1), so bulk generation over consecutive vehicles
+// wastes nothing:
+//
+//   counter = {tick low, tick high, vehicle / 2, channel}
+//   key     = {seed low, seed high}
+//   draw    = output double (vehicle % 2) of Generator::block(counter, key)
+//
+// rng::DefaultGenerator is what Vehicle and Fleet draw from; build with
+// VT_RNG_THREEFRY=1 (make RNG=threefry) to switch both to Threefry.
+
+#ifndef VT_RNG_THREEFRY
+#define VT_RNG_THREEFRY 0
+#endif
+
+// Independent random stream per sensor quantity
+enum class RandomChannel : std::uint32_t {
+    Speed,
+    FuelUse,
+    EngineTemperatureNoise,
+    BatteryUse,
+    BatteryTemperatureStep,
+    RadarDistance
+};
+
+namespace rng {
+
+constexpr std::uint32_t kPhiloxM0 = 0xD2511F53u;
+constexpr std::uint32_t kPhiloxM1 = 0xCD9E8D57u;
+constexpr std::uint32_t kPhiloxW0 = 0x9E3779B9u;
+constexpr std::uint32_t kPhiloxW1 = 0xBB67AE85u;
+constexpr int kPhiloxRounds = 10;
+
+/// Philox4x32-10 block function; transforms ctr in place.
+inline void philox4x32(std::uint32_t ctr[4], std::uint32_t key0, std::uint32_t key1) {
+    for (int round = 0; round < kPhiloxRounds; ++round) {
+        const std::uint64_t p0 = static_cast<std::uint64_t>(kPhiloxM0) * ctr[0];
+        const std::uint64_t p1 = static_cast<std::uint64_t>(kPhiloxM1) * ctr[2];
+        const std::uint32_t hi0 = static_cast<std::uint32_t>(p0 >> 32);
+        const std::uint32_t lo0 = static_cast<std::uint32_t>(p0);
+        const std::uint32_t hi1 = static_cast<std::uint32_t>(p1 >> 32);
+        const std::uint32_t lo1 = static_cast<std::uint32_t>(p1);
+        ctr[0] = hi1 ^ ctr[1] ^ key0;
+        ctr[1] = lo1;
+        ctr[2] = hi0 ^ ctr[3] ^ key1;
+        ctr[3] = lo0;
+        key0 += kPhiloxW0;
+        key1 += kPhiloxW1;
+    }
+}
+
+template <int R>
+inline std::uint32_t rotl32(std::uint32_t x) {
+    return (x << R) | (x >> (32 - R));
+}
+
+/// Four Threefry4x32 rounds with rotation constants A..H, then key injection number S.
+template <int A, int B, int C, int D, int E, int F, int G, int H, std::uint32_t S>
+inline void threefryRounds(std::uint32_t x[4], const std::uint32_t ks[5]) {
+    x[0] += x[1]; x[1] = rotl32<A>(x[1]) ^ x[0]; x[2] += x[3]; x[3] = rotl32<B>(x[3]) ^ x[2];
+    x[0] += x[3]; x[3] = rotl32<C>(x[3]) ^ x[0]; x[2] += x[1]; x[1] = rotl32<D>(x[1]) ^ x[2];
+    x[0] += x[1]; x[1] = rotl32<E>(x[1]) ^ x[0]; x[2] += x[3]; x[3] = rotl32<F>(x[3]) ^ x[2];
+    x[0] += x[3]; x[3] = rotl32<G>(x[3]) ^ x[0]; x[2] += x[1]; x[1] = rotl32<H>(x[1]) ^ x[2];
+    x[0] += ks[S % 5];
+    x[1] += ks[(S + 1) % 5];
+    x[2] += ks[(S + 2) % 5];
+    x[3] += ks[(S + 3) % 5] + S;
+}
+
+/// Threefry4x32-20 block function (Random123): ctr is the plaintext, encrypted in place
+/// under the 128-bit key {key0, key1, 0, 0}.
+inline void threefry4x32(std::uint32_t ctr[4], std::uint32_t key0, std::uint32_t key1) {
+    const std::uint32_t ks[5] = {key0, key1, 0, 0, 0x1BD11BDAu ^ key0 ^ key1};
+    ctr[0] += ks[0];
+    ctr[1] += ks[1];
+    threefryRounds<10, 26, 11, 21, 13, 27, 23, 5, 1>(ctr, ks);
+    threefryRounds<6, 20, 17, 11, 25, 10, 18, 20, 2>(ctr, ks);
+    threefryRounds<10, 26, 11, 21, 13, 27, 23, 5, 3>(ctr, ks);
+    threefryRounds<6, 20, 17, 11, 25, 10, 18, 20, 4>(ctr, ks);
+    threefryRounds<10, 26, 11, 21, 13, 27, 23, 5, 5>(ctr, ks);
+}
+
+// Generator policies: a name, an id stored in checkpoints, and the block function
+struct Philox4x32 {
+    static constexpr const char* kName = "philox4x32-10";
+    static constexpr std::uint16_t kId = 0;
+    static void block(std::uint32_t ctr[4], std::uint32_t key0, std::uint32_t key1) { philox4x32(ctr, key0, key1); }
+};
+
+struct Threefry4x32 {
+    static constexpr const char* kName = "threefry4x32-20";
+    static constexpr std::uint16_t kId = 1;
+    static void block(std::uint32_t ctr[4], std::uint32_t key0, std::uint32_t key1) { threefry4x32(ctr, key0, key1); }
+};
+
+#if VT_RNG_THREEFRY
+using DefaultGenerator = Threefry4x32;
+#else
+using DefaultGenerator = Philox4x32;
+#endif
+
+/// Maps 64 random bits to a double in [0, 1) with 52 bits of resolution.
+/// Uses the exponent trick so vector code can produce identical results.
+inline double toUnit(std::uint64_t bits) {
+    const std::uint64_t pattern = 0x3FF0000000000000ull | (bits >> 12);
+    double value;
+    std::memcpy(&value, &pattern, sizeof(value));
+    return value - 1.0;
+}
+
+/// Computes the draw of one (seed, vehicle, channel, tick).
+/// @return A uniform double in [0, 1).
+template <typename Generator = DefaultGenerator>
+inline double uniformAt(std::uint64_t seed, std::uint32_t vehicleId, RandomChannel channel, std::uint64_t tick) {
+    std::uint32_t ctr[4] = {static_cast<std::uint32_t>(tick), static_cast<std::uint32_t>(tick >> 32),
+                            vehicleId >> 1, static_cast<std::uint32_t>(channel)};
+    Generator::block(ctr, static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32));
+    const std::uint64_t bits = (vehicleId & 1u)
+        ? (static_cast<std::uint64_t>(ctr[3]) << 32) | ctr[2]
+        : (static_cast<std::uint64_t>(ctr[1]) << 32) | ctr[0];
+    return toUnit(bits);
+}
+
+/// Fills out[i] with uniformAt(seed, firstVehicle + i, channel, tick), one scalar block at a time.
+/// simd::uniform() computes the same values, with vector instructions for Philox.
+template <typename Generator = DefaultGenerator>
+inline void fillUniformScalar(std::uint64_t seed, RandomChannel channel, std::uint64_t tick,
+                              std::uint32_t firstVehicle, double* out, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = uniformAt<Generator>(seed, firstVehicle + static_cast<std::uint32_t>(i), channel, tick);
+    }
+}
+
+} // namespace rng
+
+// Sequential view of one (seed, vehicle, channel) stream, used by the per-vehicle sensor classes
+template <typename Generator>
+class BasicRandomStream {
+public:
+    BasicRandomStream(std::uint64_t seed = 0, std::uint32_t vehicleId = 0,
+                      RandomChannel channel = RandomChannel::Speed, std::uint64_t tick = 0)
+        : seed(seed), vehicleId(vehicleId), channel(channel), tick(tick) {}
+
+    /// @return The draw for the current tick in [0, 1), then advances to the next tick.
+    double next() { return rng::uniformAt<Generator>(seed, vehicleId, channel, tick++); }
+
+    /// @return The draw for the current tick scaled to [low, high), then advances.
+    double next(double low, double high) { return low + (high - low) * next(); }
+
+    std::uint64_t position() const { return tick; }
+    void seek(std::uint64_t newTick) { tick = newTick; }
+
+private:
+    std::uint64_t seed;
+    std::uint32_t vehicleId;
+    RandomChannel channel;
+    std::uint64_t tick;
+};
+
+using RandomStream = BasicRandomStream<rng::DefaultGenerator>;
+
+#endif // RNG_HPP
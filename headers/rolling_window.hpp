@@ -0,0 +1,88 @@
+#ifndef ROLLING_WINDOW_HPP
+#define ROLLING_WINDOW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class CheckpointReader;
+class CheckpointWriter;
+
+// A pool of sliding windows over the last `length` samples of a stream each,
+// e.g. one window per vehicle for the same signal. All ring storage is
+// allocated up front; a push never allocates.
+//
+// Every push updates the window's statistics incrementally:
+//   - mean and variance with a sliding Welford update (the evicted sample is
+//     removed exactly, nothing is re-summed)
+//   - min and max with monotonic deques of sample numbers, so each sample is
+//     pushed and popped at most once (amortized O(1))
+//   - rate of change as (newest - oldest) / elapsed time
+//
+// Statistics read NaN until a window has filled, so a rule on a 50-sample
+// mean is not evaluated over its first 3 samples.
+class RollingWindows {
+public:
+    RollingWindows(std::size_t windowCount, std::uint32_t length);
+
+    // Appends a sample, evicting the oldest once the window is full; timestamps must not decrease
+    void push(std::size_t window, std::uint64_t timestampNs, double value);
+
+    // Forgets every sample of a window
+    void reset(std::size_t window);
+
+    bool full(std::size_t window) const { return states[window].pushed >= windowLength; }
+    std::size_t size(std::size_t window) const {
+        return states[window].pushed < windowLength ? static_cast<std::size_t>(states[window].pushed) : windowLength;
+    }
+
+    double mean(std::size_t window) const;
+    double variance(std::size_t window) const;   // Population variance
+    double stddev(std::size_t window) const;
+    double min(std::size_t window) const;
+    double max(std::size_t window) const;
+    double rate(std::size_t window) const;       // Units per second
+
+    std::size_t windowCount() const { return states.size(); }
+    std::uint32_t length() const { return windowLength; }
+    std::size_t memoryBytes() const;
+
+    // Write or read back every window's samples and statistics (see checkpoint.hpp)
+    void saveState(CheckpointWriter& writer) const;
+    void restoreState(CheckpointReader& reader);
+
+private:
+    struct State {
+        std::uint64_t pushed = 0;   // Samples pushed so far; sample n lives in slot n % length
+        double mean = 0.0;
+        double m2 = 0.0;            // Sum of squared deviations from the mean
+        // Deques of sample numbers in slots [head, tail) mod length: the min deque
+        // holds increasing values, the max deque decreasing ones, oldest first
+        std::uint64_t minHead = 0;
+        std::uint64_t minTail = 0;
+        std::uint64_t maxHead = 0;
+        std::uint64_t maxTail = 0;
+    };
+
+    std::size_t base(std::size_t window) const { return window * windowLength; }
+
+    std::uint32_t windowLength;
+    std::vector<State> states;
+    std::vector<double> values;              // windowCount * length rings
+    std::vector<std::uint64_t> timestamps;
+    std::vector<std::uint64_t> minQueue;
+    std::vector<std::uint64_t> maxQueue;
+};
+
+// Exponentially weighted moving average; the first sample seeds it
+struct Ewma {
+    double value = 0.0;
+    bool seeded = false;
+
+    void push(double sample, double alpha) {
+        value = seeded ? value + alpha * (sample - value) : sample;
+        seeded = true;
+    }
+};
+
+#endif // ROLLING_WINDOW_HPP
@@ -0,0 +1,178 @@
+#ifndef RULE_ENGINE_HPP
+#define RULE_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "rolling_window.hpp"
+#include "signals.hpp"
+
+class CheckpointReader;
+class CheckpointWriter;
+class Fleet;
+
+enum class Comparator : std::uint8_t { Greater, GreaterEqual, Less, LessEqual };
+
+enum class Severity : std::uint8_t { Info, Warning, Critical };
+
+// What of a signal a rule compares: the reading itself, or an aggregate over a
+// sliding window of its last N samples, or its exponentially weighted average
+enum class Aggregate : std::uint8_t { Value, Mean, Variance, StdDev, Min, Max, Rate, Ewma };
+
+/// @return "info", "warning" or "critical".
+const char* severityName(Severity severity);
+
+/// @return "value", "mean", "variance", "stddev", "min", "max", "rate" or "ewma".
+const char* aggregateName(Aggregate aggregate);
+
+// One threshold rule as written in a rules file
+struct RuleSpec {
+    Signal signal = Signal::Speed;
+    Aggregate aggregate = Aggregate::Value;
+    std::uint32_t window = 0;     // Samples per window, for the windowed aggregates
+    double alpha = 0.0;           // Smoothing factor, for Aggregate::Ewma
+    Comparator comparator = Comparator::Greater;
+    double limit = 0.0;
+    double hysteresis = 0.0;      // How far back past the limit the value must go to clear
+    std::uint32_t debounce = 1;   // Consecutive evaluations needed to raise or to clear
+    Severity severity = Severity::Warning;
+    std::string message;
+};
+
+/// @return The signal's display name, followed by the aggregate if any, e.g. "Engine temperature rate(100)".
+std::string ruleInputName(const RuleSpec& spec);
+
+// A rule changing state for one vehicle
+struct RuleEvent {
+    std::uint32_t vehicleId;
+    std::uint32_t rule;           // Index into the RuleSet
+    bool raised;                  // false: cleared
+    double value;                 // The reading (or aggregate) that completed the transition
+};
+
+// An immutable set of rules, compiled into a flat table of plain comparisons.
+//
+// Rules file format, one rule per line ('#' starts a comment):
+//
+//   <signal>[:<aggregate>(<n>)] <comparator> <limit> [hysteresis=H] [debounce=N] [severity=S] [message...]
+//
+// e.g.  engine_temperature > 90 hysteresis=2 debounce=3 severity=critical Engine overheating!
+//       fuel_level:rate(30) < -0.5 severity=warning Fuel dropping fast!
+//
+// <signal> is a signalKey() identifier, <comparator> one of > >= < <=.
+// <aggregate> is mean, variance, stddev, min, max or rate over the last <n>
+// samples of the signal, or ewma with smoothing factor <n> (0 < n <= 1).
+class RuleSet {
+public:
+    // A sliding window, shared by every rule aggregating the same signal over the same length
+    struct WindowSpec {
+        Signal signal;
+        std::uint32_t length;
+    };
+
+    // A moving average, shared by every rule on the same signal and smoothing factor
+    struct EwmaSpec {
+        Signal signal;
+        double alpha;
+    };
+
+    // Compiled form of a rule; the raise test is "value <cmp> raiseLimit" and the
+    // clear test is "not value <cmp> clearLimit", where clearLimit is the limit
+    // moved back by the hysteresis band
+    struct CompiledRule {
+        Signal signal;
+        Aggregate aggregate;
+        std::uint32_t source;   // Index into windows() or ewmas() for aggregated rules
+        bool above;        // Greater/GreaterEqual
+        bool inclusive;    // GreaterEqual/LessEqual
+        double raiseLimit;
+        double clearLimit;
+        std::uint32_t debounce;
+    };
+
+    RuleSet() = default;
+    explicit RuleSet(std::vector<RuleSpec> specs);
+
+    // The built-in checks of vehicle_model::kDiagnosticChecks, without hysteresis or debounce
+    static RuleSet defaults();
+
+    // Parses a rules file; throws std::runtime_error naming the file and line on errors
+    static RuleSet fromFile(const std::string& filePath);
+    static RuleSet parse(std::istream& input, const std::string& sourceName);
+
+    std::size_t size() const { return specs.size(); }
+    const RuleSpec& spec(std::size_t rule) const { return specs[rule]; }
+    const std::vector<CompiledRule>& table() const { return compiled; }
+    const std::vector<WindowSpec>& windows() const { return windowSpecs; }
+    const std::vector<EwmaSpec>& ewmas() const { return ewmaSpecs; }
+
+    // Whether any rule aggregates the signal, i.e. needs every sample rather than the latest
+    bool aggregates(Signal signal) const;
+
+    // CRC32 of every rule's settings and message; equal for rule sets that behave the same
+    std::uint32_t fingerprint() const;
+
+private:
+    std::vector<RuleSpec> specs;
+    std::vector<CompiledRule> compiled;
+    std::vector<WindowSpec> windowSpecs;
+    std::vector<EwmaSpec> ewmaSpecs;
+};
+
+// Evaluates a RuleSet for a number of vehicles, keeping per-vehicle rule state
+// (active flag and debounce counter) and reporting only transitions.
+//
+// Steady-state evaluation is comparisons and counter updates; no strings are
+// touched until a caller formats an event. Aggregated rules read windows that
+// are updated incrementally as samples are observed, so their cost does not
+// grow with the window length.
+class RuleEngine {
+public:
+    explicit RuleEngine(RuleSet rules = RuleSet::defaults(), std::size_t vehicleCount = 1);
+
+    // Feeds one sample to the windows and averages of the rules aggregating its signal;
+    // call for every sample of those signals, oldest first, before evaluate()
+    void observe(std::uint32_t vehicle, Signal signal, std::uint64_t timestampNs, double value);
+
+    // Evaluates every rule for one vehicle; values are indexed by Signal
+    void evaluate(std::uint32_t vehicle, const double (&values)[kSignalCount], std::vector<RuleEvent>& events);
+
+    // Observes the current readings of fleet vehicles [begin, end) at timestampNs, then
+    // evaluates every rule for them, one rule at a time down each column.
+    // Disjoint ranges may be evaluated concurrently (with separate event vectors).
+    void evaluateBatch(const Fleet& fleet, std::size_t begin, std::size_t end, std::uint64_t timestampNs,
+                       std::vector<RuleEvent>& events);
+
+    bool isActive(std::uint32_t vehicle, std::size_t rule) const {
+        return states[rule * vehicles + vehicle].active != 0;
+    }
+
+    const RuleSet& rules() const { return ruleSet; }
+    std::size_t vehicleCount() const { return vehicles; }
+    // Bytes held by the windows and averages of aggregated rules
+    std::size_t aggregateMemoryBytes() const;
+
+    // Write or read back every vehicle's rule states, windows and averages (see checkpoint.hpp)
+    void saveState(CheckpointWriter& writer) const;
+    void restoreState(CheckpointReader& reader);
+
+private:
+    struct RuleState {
+        std::uint32_t counter = 0;
+        std::uint8_t active = 0;
+    };
+
+    // The rule's input for one vehicle; NaN while its window is filling
+    double aggregateValue(const RuleSet::CompiledRule& rule, std::uint32_t vehicle) const;
+
+    RuleSet ruleSet;
+    std::size_t vehicles;
+    std::vector<RuleState> states;     // Rule-major: states[rule * vehicles + vehicle]
+    std::vector<RollingWindows> windows;   // One pool per RuleSet window, one window per vehicle
+    std::vector<Ewma> ewmas;           // Spec-major: ewmas[spec * vehicles + vehicle]
+};
+
+#endif // RULE_ENGINE_HPP
@@ -0,0 +1,94 @@
+#ifndef SCHEDULER_HPP
+#define SCHEDULER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// What a task does when it falls behind its deadlines
+enum class MissPolicy {
+    Skip,     // Drop the missed activations and resume on the next future deadline
+    CatchUp   // Run the missed activations back to back (bounded by kMaxCatchUpPeriods)
+};
+
+// Per-task timing counters
+struct TaskStats {
+    std::uint64_t runs = 0;
+    std::uint64_t overruns = 0;      // Runs that finished after the task's next deadline
+    std::uint64_t skipped = 0;       // Activations dropped by MissPolicy::Skip or the catch-up bound
+    std::int64_t totalJitterNs = 0;  // Sum of (start - deadline)
+    std::int64_t maxJitterNs = 0;
+    std::int64_t totalDurationNs = 0;  // Sum of the body's run times
+    std::int64_t maxDurationNs = 0;
+
+    double meanJitterNs() const { return runs ? static_cast<double>(totalJitterNs) / runs : 0.0; }
+    double meanDurationNs() const { return runs ? static_cast<double>(totalDurationNs) / runs : 0.0; }
+};
+
+// Runs registered tasks at independent fixed rates on absolute deadlines.
+//
+// Each task's deadlines are phase + k * period from the scheduler's start
+// time, so the period does not drift by the time the task bodies take.
+// Tasks due at the same instant run in registration order.
+class TaskScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TaskId = std::size_t;
+
+    // Behind by more than this many periods, a CatchUp task skips instead of bursting
+    static constexpr std::int64_t kMaxCatchUpPeriods = 10;
+
+    TaskId addTask(const std::string& name, std::chrono::nanoseconds period, std::function<void()> body,
+                   MissPolicy policy = MissPolicy::Skip,
+                   std::chrono::nanoseconds phase = std::chrono::nanoseconds::zero());
+
+    // Runs until stop becomes true (checked between task activations)
+    void run(const std::atomic<bool>& stop);
+
+    // Runs until the given amount of scheduler time has elapsed
+    void runFor(std::chrono::nanoseconds duration);
+
+    // Virtual time: runs, without sleeping, every activation due at or before
+    // virtualTime (measured from a virtual start of zero). Jitter is zero and
+    // bodies take no virtual time, so nothing overruns. Not to be mixed with
+    // run() or runFor() on the same scheduler.
+    void advanceTo(std::chrono::nanoseconds virtualTime);
+
+    std::size_t taskCount() const { return tasks.size(); }
+    const std::string& taskName(TaskId id) const { return tasks[id].name; }
+    const TaskStats& stats(TaskId id) const { return tasks[id].stats; }
+
+    // Prints one line of counters per task
+    void printStats(std::ostream& os) const;
+
+private:
+    struct Task {
+        std::string name;
+        std::chrono::nanoseconds period;
+        std::chrono::nanoseconds phase;
+        std::function<void()> body;
+        MissPolicy policy;
+        Clock::time_point nextDeadline;
+        TaskStats stats;
+    };
+
+    Clock::time_point now() const;
+    void start(Clock::time_point origin);
+    std::size_t earliestTask() const;
+    bool runNext(const std::atomic<bool>* stop, Clock::time_point end);
+    Clock::time_point execute(Task& task, Clock::time_point deadline);
+    void sleepUntil(Clock::time_point deadline);
+
+    std::vector<Task> tasks;
+    Clock::time_point startTime;
+    bool started = false;
+    bool virtualClock = false;
+    Clock::time_point virtualNow;   // Virtual time reached so far, when virtualClock
+};
+
+#endif // SCHEDULER_HPP
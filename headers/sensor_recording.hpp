@@ -0,0 +1,114 @@
+#ifndef SENSOR_RECORDING_HPP
+#define SENSOR_RECORDING_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+#include "signal_bus.hpp"
+
+// On-disk layout of a sensor recording:
+//
+//   RecordingHeader
+//   RecordingFrame ...
+//
+// One frame per radar sample holds that sample and the latest value of every
+// other recorded sensor signal (all of which are slower than the radar).
+// The frame count follows from the file size, so a recording cut short by a
+// crash still replays up to its last complete frame. Native byte order.
+
+constexpr std::uint32_t kRecordingMagic = 0x43455256;   // "VREC"
+constexpr std::uint16_t kRecordingFormatVersion = 1;
+
+// Frame period used by the simulator: the fastest sensor (radar) rate, so every sample is captured
+constexpr std::chrono::nanoseconds kRecordingPeriod = std::chrono::milliseconds(10);
+// The signal whose samples the frames follow, one frame each
+constexpr Signal kRecordingPaceSignal = Signal::RadarDistance;
+
+// The signals a recording holds, in frame order; actuator signals are left to the controllers under test
+constexpr Signal kRecordedSignals[] = {Signal::Speed, Signal::FuelLevel, Signal::EngineTemperature,
+                                       Signal::BatteryCharge, Signal::BatteryTemperature, Signal::RadarDistance};
+constexpr std::size_t kRecordedSignalCount = sizeof(kRecordedSignals) / sizeof(kRecordedSignals[0]);
+
+struct RecordingHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t signalCount;
+    std::uint64_t periodNs;       // Time between frames
+    std::uint64_t seed;           // Seed of the recorded run, for reference
+    std::uint64_t reserved;
+};
+
+struct RecordingFrame {
+    double values[kRecordedSignalCount];   // In kRecordedSignals order
+};
+
+static_assert(sizeof(RecordingHeader) == 32, "RecordingHeader layout changed");
+static_assert(sizeof(RecordingFrame) == 48, "RecordingFrame layout changed");
+
+// Appends one frame per radar sample published to a bus, so a recording does
+// not depend on when record() runs relative to the radar
+class SensorRecorder {
+public:
+    // Creates the file and starts following the bus, which must outlive the recorder;
+    // throws std::runtime_error if the file cannot be opened
+    SensorRecorder(const std::string& filePath, const SignalBus& bus, std::chrono::nanoseconds period,
+                   std::uint64_t seed);
+
+    // Writes a frame for every radar sample published since the last call. Call it at least
+    // once per bus history (256 radar periods by default), ideally right after each radar update.
+    void record();
+    void close();
+
+    std::uint64_t frameCount() const { return frames; }
+    // Radar samples overwritten on the bus before record() could write them
+    std::uint64_t lostSamples() const { return pace.lost(); }
+    std::chrono::nanoseconds period() const { return framePeriod; }
+
+private:
+    std::ofstream file;
+    const SignalBus& bus;
+    SignalSubscription pace;
+    std::chrono::nanoseconds framePeriod;
+    std::uint64_t frames = 0;
+};
+
+// A memory-mapped recording that publishes its frames to a signal bus in place
+// of the sensors, one frame per period. publishNext() runs on one thread; finished()
+// and position() may be read from others.
+class SensorReplay {
+public:
+    // Maps and validates the file; throws std::runtime_error if it is missing or not a recording
+    explicit SensorReplay(const std::string& filePath);
+    ~SensorReplay();
+
+    SensorReplay(const SensorReplay&) = delete;
+    SensorReplay& operator=(const SensorReplay&) = delete;
+
+    // Publishes the next frame; returns false once every frame has been published
+    bool publishNext(SignalBus& bus);
+    void rewind() { cursor.store(0, std::memory_order_release); }
+
+    bool finished() const { return position() >= frames; }
+    std::size_t position() const { return cursor.load(std::memory_order_acquire); }
+    std::size_t frameCount() const { return frames; }
+    std::chrono::nanoseconds period() const { return std::chrono::nanoseconds(header().periodNs); }
+    std::uint64_t seed() const { return header().seed; }
+    const RecordingFrame& frame(std::size_t index) const { return framesBegin()[index]; }
+
+private:
+    const RecordingHeader& header() const { return *reinterpret_cast<const RecordingHeader*>(base); }
+    const RecordingFrame* framesBegin() const {
+        return reinterpret_cast<const RecordingFrame*>(base + sizeof(RecordingHeader));
+    }
+
+    const unsigned char* base = nullptr;
+    std::size_t size = 0;
+    std::size_t frames = 0;
+    std::atomic<std::size_t> cursor{0};   // Next frame; only the publishing thread advances it
+};
+
+#endif // SENSOR_RECORDING_HPP
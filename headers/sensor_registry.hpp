@@ -0,0 +1,198 @@
+#ifndef SENSOR_REGISTRY_HPP
+#define SENSOR_REGISTRY_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "battery.hpp"
+#include "sensors.hpp"
+#include "signal_bus.hpp"
+
+// Compile-time list of the vehicle's sensors.
+//
+// Every sensor type describes itself in a SensorTraits specialization: the
+// signals it publishes (with the accessor that reads each one and its
+// dashboard label), its task name and period, and how it is updated. A
+// SensorSet<Sensors...> stores the sensors by value in a tuple and expands
+// its loops over the list with fold expressions, so the update loop, the
+// scheduled tasks, the bus publishing and the dashboard layout are all
+// generated from the list with every call resolved (and inlined) statically.
+// Diagnostics bind to the published signals by Signal, so they follow too.
+//
+// Sensors that are only known at run time implement the Sensor interface
+// instead (see Vehicle::addSensor()); SensorAdapter wraps a registry sensor in
+// that interface.
+
+// One signal a sensor publishes
+template <typename S>
+struct SensorField {
+    Signal signal;
+    double (S::*read)() const;
+    const char* label;   // Dashboard text before the value...
+    const char* unit;    // ...and after it
+};
+
+// Specialized for every sensor type; see the specializations below for the members
+template <typename S>
+struct SensorTraits;
+
+template <>
+struct SensorTraits<SpeedSensor> {
+    static constexpr const char* kName = "speed";          // Scheduler task name
+    static constexpr std::chrono::milliseconds kPeriod{20};
+    static constexpr bool kControlLoop = false;            // Runs with ACC on the control scheduler
+    static constexpr const char* kDescription = "Speed sensor";   // Logged as "<description> updated."
+    static constexpr SensorField<SpeedSensor> kFields[] = {
+        {Signal::Speed, &SpeedSensor::readData, "Speed: ", " km/h"},
+    };
+    static void update(SpeedSensor& sensor, const SignalBus&) { sensor.update(); }
+};
+
+template <>
+struct SensorTraits<FuelSensor> {
+    static constexpr const char* kName = "fuel";
+    static constexpr std::chrono::milliseconds kPeriod{1000};
+    static constexpr bool kControlLoop = false;
+    static constexpr const char* kDescription = "Fuel sensor";
+    static constexpr SensorField<FuelSensor> kFields[] = {
+        {Signal::FuelLevel, &FuelSensor::readData, "Fuel Level: ", " liters"},
+    };
+    static void update(FuelSensor& sensor, const SignalBus&) { sensor.update(); }
+};
+
+template <>
+struct SensorTraits<TemperatureSensor> {
+    static constexpr const char* kName = "temperature";
+    static constexpr std::chrono::milliseconds kPeriod{20};
+    static constexpr bool kControlLoop = false;
+    static constexpr const char* kDescription = "Temperature sensor";
+    static constexpr SensorField<TemperatureSensor> kFields[] = {
+        {Signal::EngineTemperature, &TemperatureSensor::readData, "Engine Temperature: ", " °C"},
+    };
+    // Engine temperature follows the speed, so it is listed (and scheduled) after the speed sensor
+    static void update(TemperatureSensor& sensor, const SignalBus& bus) {
+        sensor.setSpeed(bus.latestValue(Signal::Speed));
+        sensor.update();
+    }
+};
+
+template <>
+struct SensorTraits<Battery> {
+    static constexpr const char* kName = "battery";
+    static constexpr std::chrono::milliseconds kPeriod{1000};
+    static constexpr bool kControlLoop = false;
+    static constexpr const char* kDescription = "Battery";
+    static constexpr SensorField<Battery> kFields[] = {
+        {Signal::BatteryCharge, &Battery::readCharge, "Battery Charge: ", "%, "},
+        {Signal::BatteryTemperature, &Battery::readTemperature, "Battery Temperature: ", " °C"},
+    };
+    static void update(Battery& battery, const SignalBus&) { battery.update(); }
+};
+
+template <>
+struct SensorTraits<RadarSensor> {
+    static constexpr const char* kName = "radar";
+    static constexpr std::chrono::milliseconds kPeriod{10};
+    static constexpr bool kControlLoop = true;
+    static constexpr const char* kDescription = "Radar sensor";
+    static constexpr SensorField<RadarSensor> kFields[] = {
+        {Signal::RadarDistance, &RadarSensor::readData, "Front Vehicle Distance: ", " meters"},
+    };
+    static void update(RadarSensor& sensor, const SignalBus&) { sensor.update(); }
+};
+
+// Publishes every field of a registry sensor
+template <typename S>
+void publishReadings(const S& sensor, SignalBus& bus, std::uint64_t timestampNs) {
+    for (const SensorField<S>& field : SensorTraits<S>::kFields) {
+        bus.publish(field.signal, (sensor.*field.read)(), timestampNs);
+    }
+}
+
+template <typename... Sensors>
+class SensorSet {
+public:
+    // Every sensor is constructed from the simulation seed and the vehicle id
+    SensorSet(std::uint64_t seed, std::uint32_t vehicleId) : sensors(Sensors(seed, vehicleId)...) {}
+
+    static constexpr std::size_t size() { return sizeof...(Sensors); }
+
+    template <typename S>
+    S& get() { return std::get<S>(sensors); }
+    template <typename S>
+    const S& get() const { return std::get<S>(sensors); }
+
+    // Calls visit(sensor) for every sensor, in list order
+    template <typename Visit>
+    void forEach(Visit&& visit) {
+        std::apply([&](Sensors&... sensor) { (visit(sensor), ...); }, sensors);
+    }
+    template <typename Visit>
+    void forEach(Visit&& visit) const {
+        std::apply([&](const Sensors&... sensor) { (visit(sensor), ...); }, sensors);
+    }
+
+    // Calls visit(field, firstOfSensor) for every field of every sensor type, in list order
+    template <typename Visit>
+    static void forEachField(Visit&& visit) {
+        (visitFields<Sensors>(visit), ...);
+    }
+
+    // Updates one sensor and publishes its readings stamped with the bus time
+    template <typename S>
+    void update(SignalBus& bus) {
+        S& sensor = get<S>();
+        SensorTraits<S>::update(sensor, bus);
+        publishReadings(sensor, bus, bus.now());
+    }
+
+    // Updates and publishes every sensor, in list order
+    void updateAll(SignalBus& bus) { (update<Sensors>(bus), ...); }
+
+    // Publishes every sensor's current readings without updating them
+    void publishAll(SignalBus& bus, std::uint64_t timestampNs) const {
+        forEach([&](const auto& sensor) { publishReadings(sensor, bus, timestampNs); });
+    }
+
+private:
+    template <typename S, typename Visit>
+    static void visitFields(Visit& visit) {
+        bool first = true;
+        for (const SensorField<S>& field : SensorTraits<S>::kFields) {
+            visit(field, first);
+            first = false;
+        }
+    }
+
+    std::tuple<Sensors...> sensors;
+};
+
+// The vehicle's sensors; the order is the update order and the dashboard row order
+using VehicleSensors = SensorSet<SpeedSensor, FuelSensor, TemperatureSensor, Battery, RadarSensor>;
+
+// Runs a registry sensor through the plug-in Sensor interface, updated through its SensorTraits;
+// readData() returns its first field
+template <typename S>
+class SensorAdapter final : public Sensor {
+public:
+    template <typename... Args>
+    explicit SensorAdapter(Args&&... args) : sensor(std::forward<Args>(args)...) {}
+
+    void update(const SignalBus& bus) override { SensorTraits<S>::update(sensor, bus); }
+    double readData() const override { return (sensor.*SensorTraits<S>::kFields[0].read)(); }
+    void publish(SignalBus& bus, std::uint64_t timestampNs) const override {
+        publishReadings(sensor, bus, timestampNs);
+    }
+
+    S& get() { return sensor; }
+    const S& get() const { return sensor; }
+
+private:
+    S sensor;
+};
+
+#endif // SENSOR_REGISTRY_HPP
@@ -1,62 +1,91 @@
 #ifndef SENSORS_HPP
 #define SENSORS_HPP
 
-#include <random>
 #include <cmath>
 #include <iostream>
 #include <iomanip>      // For formatted output
 
-// Sensors interface
+#include "rng.hpp"
+#include "vehicle_model.hpp"
+
+class SignalBus;
+
+// Plug-in sensor interface. The built-in sensors below do not derive from it:
+// they are listed at compile time in sensor_registry.hpp and called directly,
+// with update() and readData() inlined. SensorAdapter runs one through this
+// interface where runtime polymorphism is wanted, and Vehicle::addSensor()
+// hosts sensors that are only known at run time.
 class Sensor {
 public:
-    virtual void update() = 0;
+    // Takes a new reading; inputs such as the speed behind the engine temperature come from the bus
+    virtual void update(const SignalBus& bus) = 0;
     virtual double readData() const = 0;
+    // Publishes every reading, stamped with timestampNs
+    virtual void publish(SignalBus& bus, std::uint64_t timestampNs) const = 0;
     virtual ~Sensor() = default;
 };
 
 // Speed Sensor Class (declaration)
-class SpeedSensor : public Sensor {
+class SpeedSensor {
 private:
     double speed;  // Speed in km/h
+    RandomStream rng;
 public:
-    SpeedSensor();
-    void update() override;
-    double readData() const override;
+    SpeedSensor(std::uint64_t seed = 0, std::uint32_t vehicleId = 0);
+    /// Updates the speed sensor with a randomly generated value between 0 and 200 km/h.
+    void update() { speed = rng.next(vehicle_model::kSpeedMin, vehicle_model::kSpeedMax); }
+    /// @return The current speed in km/h.
+    double readData() const { return speed; }
     friend std::ostream& operator<<(std::ostream& os, const SpeedSensor& sensor);
 };
 
 // Fuel Sensor Class (declaration)
-class FuelSensor : public Sensor {
+class FuelSensor {
 private:
     double fuelLevel;  // Fuel level in liters
+    RandomStream rng;
 public:
-    FuelSensor();
-    void update() override;
-    double readData() const override;
+    FuelSensor(std::uint64_t seed = 0, std::uint32_t vehicleId = 0);
+    /// Updates the fuel sensor by simulating fuel consumption; the level does not go below 0.
+    void update() {
+        fuelLevel = vehicle_model::drain(fuelLevel, rng.next(vehicle_model::kFuelUseMin, vehicle_model::kFuelUseMax));
+    }
+    /// @return The current fuel level in liters.
+    double readData() const { return fuelLevel; }
     friend std::ostream& operator<<(std::ostream& os, const FuelSensor& sensor);
 };
 
 // Temperature Sensor Class (declaration)
-class TemperatureSensor : public Sensor {
+class TemperatureSensor {
 private:
     double temperature;  // Engine temperature in °C
     double speed; // Store the speed to simulate increasing temp with increasing the speed
+    RandomStream rng;
 public:
-    TemperatureSensor();
-    void update() override;
-    double readData() const override;
-    void setSpeed(double newSpeed);
+    TemperatureSensor(std::uint64_t seed = 0, std::uint32_t vehicleId = 0);
+    /// Updates the temperature sensor based on current speed and random fluctuations.
+    void update() {
+        const double noise = rng.next(-vehicle_model::kEngineTempNoise, vehicle_model::kEngineTempNoise);
+        temperature = vehicle_model::engineTemperature(speed, noise);
+    }
+    /// @return The current temperature in degrees Celsius.
+    double readData() const { return temperature; }
+    /// Sets the speed used for temperature calculations.
+    void setSpeed(double newSpeed) { speed = newSpeed; }
     friend std::ostream& operator<<(std::ostream& os, const TemperatureSensor& sensor);
 };
 
 // Radar Sensor Class for Adaptive Cruise Control (declaration)
-class RadarSensor : public Sensor {
+class RadarSensor {
 private:
     double distance;  // Distance to the vehicle ahead in meters
+    RandomStream rng;
 public:
-    RadarSensor();
-    void update() override;
-    double readData() const override;
+    RadarSensor(std::uint64_t seed = 0, std::uint32_t vehicleId = 0);
+    /// Updates the radar sensor with a randomly generated distance between 10 and 200 meters.
+    void update() { distance = rng.next(vehicle_model::kRadarMin, vehicle_model::kRadarMax); }
+    /// @return The current distance in meters.
+    double readData() const { return distance; }
     friend std::ostream& operator<<(std::ostream& os, const RadarSensor& sensor);
 };
 
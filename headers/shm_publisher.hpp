@@ -0,0 +1,54 @@
+#ifndef SHM_PUBLISHER_HPP
+#define SHM_PUBLISHER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "shm_snapshot.hpp"
+#include "rule_engine.hpp"
+#include "vehicle_state.hpp"
+
+class Fleet;
+
+// Creates the live-state shared-memory segment (see shm_snapshot.hpp) and
+// publishes vehicle states into it. External processes read it with
+// ShmSnapshotReader while the simulation runs.
+//
+// Each vehicle slot must only be published from one thread at a time; separate
+// slots may be published concurrently. The segment is removed on destruction.
+class ShmPublisher {
+public:
+    // Creates (or replaces) the segment; the rule labels describe the warning bits.
+    // Throws std::runtime_error if the segment cannot be created.
+    ShmPublisher(const std::string& name, std::size_t vehicleCount, const RuleSet& rules);
+    ~ShmPublisher();
+
+    ShmPublisher(const ShmPublisher&) = delete;
+    ShmPublisher& operator=(const ShmPublisher&) = delete;
+
+    // Publishes one vehicle's state and the active rules of the engine's vehicle engineVehicle
+    void publish(std::size_t slot, std::uint32_t vehicleId, std::uint64_t timestampNs, const VehicleState& state,
+                 const RuleEngine& rules, std::uint32_t engineVehicle = 0);
+
+    // Publishes fleet vehicles [begin, end) into the slots of the same index
+    void publishFleet(const Fleet& fleet, const RuleEngine& rules, std::size_t begin, std::size_t end,
+                      std::uint64_t timestampNs);
+
+    std::size_t vehicleCount() const { return vehicles; }
+    const std::string& name() const { return segmentName; }
+
+private:
+    void write(std::size_t slot, std::uint32_t vehicleId, std::uint64_t timestampNs, const double* values,
+               std::uint64_t warnings);
+    std::uint64_t activeWarnings(const RuleEngine& rules, std::uint32_t vehicle) const;
+
+    std::string segmentName;
+    std::size_t vehicles;
+    std::size_t size;
+    unsigned char* base;
+    ShmHeader* header;
+    ShmVehicleSlot* slots;
+};
+
+#endif // SHM_PUBLISHER_HPP
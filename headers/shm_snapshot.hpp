@@ -0,0 +1,162 @@
+#ifndef SHM_SNAPSHOT_HPP
+#define SHM_SNAPSHOT_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "signals.hpp"
+
+// Layout of the live-state shared-memory segment and a header-only reader for it.
+// External tools only need this header (and signals.hpp).
+//
+//   ShmHeader
+//   ShmWarningLabel[kShmMaxWarnings]
+//   ShmVehicleSlot[vehicleCount]
+//
+// The simulator is the only writer. Every vehicle slot is a seqlock: the writer
+// makes the sequence odd, updates the fields and makes it even again, and a
+// reader that saw an odd or changed sequence simply reads again. Readers never
+// block the writer and never make a system call after opening the segment.
+
+constexpr std::uint32_t kShmMagic = 0x4D485356;   // "VSHM"
+constexpr std::uint16_t kShmFormatVersion = 1;
+constexpr std::size_t kShmMaxWarnings = 64;       // One bit of ShmVehicleSlot::activeWarnings per rule
+constexpr const char* kShmDefaultName = "/vehicle-telemetry";
+
+struct ShmHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t signalCount;
+    std::uint32_t vehicleCount;
+    std::uint32_t warningCount;       // Diagnostic rules described by the warning labels
+    std::uint32_t slotSize;
+    std::uint32_t reserved;
+    std::atomic<std::uint64_t> publishCount;  // Bumped after every published vehicle update
+    std::uint64_t padding[4];         // Keeps the vehicle slots cache-line aligned
+};
+
+// Describes bit i of activeWarnings: the diagnostic rule i
+struct ShmWarningLabel {
+    std::uint8_t signal;              // Signal the rule watches
+    std::uint8_t severity;            // 0 info, 1 warning, 2 critical
+    char message[62];                 // NUL-terminated, truncated if longer
+};
+
+struct alignas(64) ShmVehicleSlot {
+    std::atomic<std::uint64_t> sequence;
+    std::atomic<std::uint64_t> timestampNs;
+    std::atomic<std::uint64_t> activeWarnings;
+    std::atomic<std::uint32_t> vehicleId;
+    std::atomic<double> values[kSignalCount];   // Indexed by Signal; gear as a whole number
+};
+
+static_assert(sizeof(ShmHeader) == 64, "ShmHeader layout changed");
+static_assert(sizeof(ShmWarningLabel) == 64, "ShmWarningLabel layout changed");
+static_assert(std::atomic<double>::is_always_lock_free && std::atomic<std::uint64_t>::is_always_lock_free,
+              "the shared-memory protocol needs lock-free atomics");
+
+constexpr std::size_t shmSegmentSize(std::size_t vehicleCount) {
+    return sizeof(ShmHeader) + kShmMaxWarnings * sizeof(ShmWarningLabel) + vehicleCount * sizeof(ShmVehicleSlot);
+}
+
+// A consistent copy of one vehicle's slot
+struct ShmVehicleSnapshot {
+    std::uint32_t vehicleId = 0;
+    std::uint64_t timestampNs = 0;    // Monotonic (steady clock) or simulated nanoseconds
+    std::uint64_t activeWarnings = 0;
+    std::uint64_t sequence = 0;       // Even; grows by 2 per update, so readers can tell what changed
+    double values[kSignalCount] = {};
+
+    double value(Signal signal) const { return values[static_cast<std::size_t>(signal)]; }
+    bool warningActive(std::size_t rule) const { return rule < 64 && (activeWarnings >> rule) & 1; }
+};
+
+// Maps a segment read-only and takes consistent snapshots of its vehicles
+class ShmSnapshotReader {
+public:
+    // Opens and validates the segment; throws std::runtime_error if it is missing or incompatible
+    explicit ShmSnapshotReader(const std::string& name = kShmDefaultName) {
+        const int fd = shm_open(name.c_str(), O_RDONLY, 0);
+        if (fd < 0) {
+            throw std::runtime_error("Failed to open shared memory segment: " + name);
+        }
+        struct stat info {};
+        if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < shmSegmentSize(0)) {
+            close(fd);
+            throw std::runtime_error("Shared memory segment is too small: " + name);
+        }
+        size = static_cast<std::size_t>(info.st_size);
+        void* mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Failed to map shared memory segment: " + name);
+        }
+        base = static_cast<const unsigned char*>(mapping);
+
+        const ShmHeader& h = header();
+        if (h.magic != kShmMagic || h.version != kShmFormatVersion || h.signalCount != kSignalCount ||
+            h.slotSize != sizeof(ShmVehicleSlot) || size < shmSegmentSize(h.vehicleCount)) {
+            munmap(const_cast<unsigned char*>(base), size);
+            throw std::runtime_error("Incompatible shared memory segment: " + name);
+        }
+    }
+
+    ~ShmSnapshotReader() { munmap(const_cast<unsigned char*>(base), size); }
+
+    ShmSnapshotReader(const ShmSnapshotReader&) = delete;
+    ShmSnapshotReader& operator=(const ShmSnapshotReader&) = delete;
+
+    std::size_t vehicleCount() const { return header().vehicleCount; }
+    std::size_t warningCount() const { return header().warningCount; }
+    const ShmWarningLabel& warning(std::size_t rule) const {
+        return reinterpret_cast<const ShmWarningLabel*>(base + sizeof(ShmHeader))[rule];
+    }
+
+    // Total vehicle updates published so far; unchanged means nothing new to read
+    std::uint64_t publishCount() const { return header().publishCount.load(std::memory_order_acquire); }
+
+    // Copies one vehicle's state. Returns false if the writer kept it busy for
+    // maxAttempts reads in a row or it has never been published.
+    bool read(std::size_t vehicle, ShmVehicleSnapshot& snapshot, int maxAttempts = 64) const {
+        const ShmVehicleSlot& slot = slots()[vehicle];
+        for (int attempt = 0; attempt < maxAttempts; ++attempt) {
+            const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+            if (before == 0) {
+                return false;
+            }
+            if (before & 1) {
+                continue;
+            }
+            snapshot.vehicleId = slot.vehicleId.load(std::memory_order_relaxed);
+            snapshot.timestampNs = slot.timestampNs.load(std::memory_order_relaxed);
+            snapshot.activeWarnings = slot.activeWarnings.load(std::memory_order_relaxed);
+            for (std::size_t s = 0; s < kSignalCount; ++s) {
+                snapshot.values[s] = slot.values[s].load(std::memory_order_relaxed);
+            }
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) == before) {
+                snapshot.sequence = before;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    const ShmHeader& header() const { return *reinterpret_cast<const ShmHeader*>(base); }
+    const ShmVehicleSlot* slots() const {
+        return reinterpret_cast<const ShmVehicleSlot*>(base + sizeof(ShmHeader) + kShmMaxWarnings * sizeof(ShmWarningLabel));
+    }
+
+    const unsigned char* base = nullptr;
+    std::size_t size = 0;
+};
+
+#endif // SHM_SNAPSHOT_HPP
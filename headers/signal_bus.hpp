@@ -0,0 +1,157 @@
+#ifndef SIGNAL_BUS_HPP
+#define SIGNAL_BUS_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+#include "arena.hpp"
+#include "signals.hpp"
+#include "vehicle_state.hpp"
+
+// One published reading of a signal
+struct SignalSample {
+    std::uint64_t timestampNs = 0;
+    double value = 0.0;
+    std::uint64_t sequence = 0;   // 0 for the first sample published on the signal
+};
+
+// Single-producer ring of timestamped samples that any number of readers can
+// read without locks and without ever blocking the producer.
+//
+// Each slot is a seqlock: the producer marks it odd while writing and even
+// (2 * sequence + 2) when done, and readers retry or skip samples whose slot
+// changed under them. When the ring is full the oldest samples are overwritten.
+class SignalRing {
+public:
+    struct Slot {
+        std::atomic<std::uint64_t> sequence{0};
+        std::atomic<std::uint64_t> timestampNs{0};
+        std::atomic<double> value{0.0};
+    };
+
+    // capacity is rounded up to a power of two
+    explicit SignalRing(std::size_t capacity);
+
+    // Appends a sample; only one thread may publish to a ring
+    void publish(std::uint64_t timestampNs, double value);
+
+    // Reads the most recent sample; false if nothing has been published yet
+    bool latest(SignalSample& sample) const;
+
+    // Reads sample number sequence; false if it is not published yet or already overwritten
+    bool read(std::uint64_t sequence, SignalSample& sample) const;
+
+    // Number of samples published so far
+    std::uint64_t published() const { return head.load(std::memory_order_acquire); }
+    std::size_t capacity() const { return mask + 1; }
+
+    // Capacity a request is rounded up to
+    static std::size_t roundCapacity(std::size_t capacity);
+
+private:
+    friend class SignalBus;
+
+    // Unusable until attach(); lets SignalBus keep its rings inline
+    SignalRing() = default;
+    // Uses capacity (a power of two) slots of storage owned by someone else
+    void attach(Slot* storage, std::size_t capacity) { slots = storage; mask = capacity - 1; }
+
+    std::size_t mask = 0;
+    std::unique_ptr<Slot[]> owned;   // Empty when the slots belong to the bus
+    Slot* slots = nullptr;
+    alignas(64) std::atomic<std::uint64_t> head{0};
+};
+
+// A ring per Signal. Producers (the vehicle's sensor updates and the ECUs'
+// commands) publish samples; consumers such as ACC, the dashboard and the
+// diagnostics read the latest value or drain history through a
+// SignalSubscription, each at its own rate and on its own thread.
+//
+// The rings live inside the bus and all their slots come from one allocation,
+// from an Arena when one is given (which must then outlive the bus).
+class SignalBus {
+public:
+    static constexpr std::size_t kDefaultHistory = 256;
+
+    explicit SignalBus(std::size_t historyCapacity = kDefaultHistory, Arena* arena = nullptr);
+
+    SignalBus(const SignalBus&) = delete;
+    SignalBus& operator=(const SignalBus&) = delete;
+
+    // Publishes a value stamped with now(); one producer thread per signal
+    void publish(Signal signal, double value) { publish(signal, value, now()); }
+    void publish(Signal signal, double value, std::uint64_t timestampNs);
+
+    bool latest(Signal signal, SignalSample& sample) const;
+
+    // Latest value of a signal, or fallback if none has been published
+    double latestValue(Signal signal, double fallback = 0.0) const;
+
+    const SignalRing& ring(Signal signal) const { return rings[static_cast<std::size_t>(signal)]; }
+
+    // Bytes of slot storage a bus with this history takes from an Arena
+    static std::size_t storageBytes(std::size_t historyCapacity) {
+        return kSignalCount * SignalRing::roundCapacity(historyCapacity) * sizeof(SignalRing::Slot);
+    }
+
+    // Monotonic timestamp used for samples
+    static std::uint64_t nowNs();
+
+    // Stamps samples with a virtual time from now on instead of nowNs() (headless runs)
+    void setVirtualTimeNs(std::uint64_t timeNs);
+    // The time samples published now are stamped with
+    std::uint64_t now() const {
+        return useVirtualTime.load(std::memory_order_relaxed) ? virtualTimeNs.load(std::memory_order_relaxed) : nowNs();
+    }
+
+private:
+    SignalRing rings[kSignalCount];
+    std::unique_ptr<SignalRing::Slot[]> ownedSlots;   // Empty when the slots are in an Arena
+    std::atomic<bool> useVirtualTime{false};
+    std::atomic<std::uint64_t> virtualTimeNs{0};
+};
+
+// A consumer's cursor into one signal's history
+class SignalSubscription {
+public:
+    // Starts after the samples already published
+    SignalSubscription(const SignalBus& bus, Signal signal)
+        : ring(&bus.ring(signal)), next(ring->published()) {}
+
+    // Calls onSample(const SignalSample&) for every sample published since the last drain, oldest first.
+    // Samples overwritten before they could be read are skipped and counted in lost().
+    // @return The number of samples delivered.
+    template <typename OnSample>
+    std::size_t drain(OnSample&& onSample) {
+        const std::uint64_t end = ring->published();
+        if (end - next > ring->capacity()) {
+            lostSamples += end - ring->capacity() - next;
+            next = end - ring->capacity();
+        }
+        std::size_t delivered = 0;
+        SignalSample sample;
+        for (; next < end; ++next) {
+            if (!ring->read(next, sample)) {
+                ++lostSamples;
+                continue;
+            }
+            onSample(sample);
+            ++delivered;
+        }
+        return delivered;
+    }
+
+    std::uint64_t lost() const { return lostSamples; }
+
+private:
+    const SignalRing* ring;
+    std::uint64_t next;
+    std::uint64_t lostSamples = 0;
+};
+
+// Snapshot of the latest value of every signal; unpublished signals read as 0
+VehicleState latestVehicleState(const SignalBus& bus);
+
+#endif // SIGNAL_BUS_HPP
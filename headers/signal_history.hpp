@@ -0,0 +1,206 @@
+#ifndef SIGNAL_HISTORY_HPP
+#define SIGNAL_HISTORY_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "signals.hpp"
+
+class Fleet;
+
+// One decoded sample
+struct HistorySample {
+    std::uint64_t timestampNs;
+    double value;
+};
+
+// Retention and precision of a history store
+struct HistoryConfig {
+    std::chrono::nanoseconds retention = std::chrono::hours(1);   // Older blocks are dropped
+    std::uint64_t resolutionNs = 1000;   // Timestamps are stored in these units (1 us by default)
+    // Values are rounded to multiples of this (e.g. 0.01) and stored as whole
+    // multiples, whose XORs have long zero runs; 0 stores them exactly
+    double valueResolution = 0.0;
+};
+
+// Bit-packed block of samples. Every block starts with a raw timestamp and
+// value, so blocks decode independently and retention can drop whole blocks.
+//
+// Timestamps are delta-of-delta encoded (0 / 7 / 9 / 12 / 64 bit buckets
+// behind a 1-4 bit prefix); values are XORed with the previous value and only
+// the meaningful bits are stored, reusing the previous leading/trailing zero
+// window when the new bits fit in it (Gorilla encoding).
+struct HistoryBlock {
+    static constexpr std::size_t kBytes = 256;
+    static constexpr std::size_t kWords = kBytes / sizeof(std::uint64_t);
+    static constexpr std::size_t kBits = kBytes * 8;
+
+    std::uint64_t firstTime = 0;   // In resolution units
+    std::uint64_t lastTime = 0;
+    std::uint32_t count = 0;
+    std::uint32_t bitCount = 0;
+    std::uint64_t words[kWords];
+};
+
+// Sequential decoder of one block
+class HistoryBlockDecoder {
+public:
+    explicit HistoryBlockDecoder(const HistoryBlock& block) : block(block) {}
+
+    // Decodes the next sample (timestamp in resolution units); false after the last one
+    bool next(std::uint64_t& time, double& value) {
+        if (decoded == block.count) {
+            return false;
+        }
+        if (decoded == 0) {
+            previousTime = read(64);
+            previousBits = read(64);
+        } else {
+            std::int64_t deltaOfDelta;
+            if (read(1) == 0) {
+                deltaOfDelta = 0;
+            } else if (read(1) == 0) {
+                deltaOfDelta = signExtend(read(7), 7);
+            } else if (read(1) == 0) {
+                deltaOfDelta = signExtend(read(9), 9);
+            } else if (read(1) == 0) {
+                deltaOfDelta = signExtend(read(12), 12);
+            } else {
+                deltaOfDelta = static_cast<std::int64_t>(read(64));
+            }
+            previousDelta += deltaOfDelta;
+            previousTime += static_cast<std::uint64_t>(previousDelta);
+
+            if (read(1) == 1) {
+                if (read(1) == 1) {
+                    leading = static_cast<unsigned>(read(5));
+                    const unsigned length = static_cast<unsigned>(read(6)) + 1;
+                    trailing = 64 - leading - length;
+                }
+                previousBits ^= read(64 - leading - trailing) << trailing;
+            }
+        }
+        ++decoded;
+        time = previousTime;
+        std::memcpy(&value, &previousBits, sizeof(value));
+        return true;
+    }
+
+private:
+    std::uint64_t read(unsigned bits) {
+        const std::size_t word = position >> 6;
+        const unsigned offset = position & 63;
+        const unsigned available = 64 - offset;
+        std::uint64_t result;
+        if (bits <= available) {
+            result = (block.words[word] << offset) >> (64 - bits);
+        } else {
+            const unsigned rest = bits - available;
+            result = ((block.words[word] << offset) >> (64 - available) << rest) | (block.words[word + 1] >> (64 - rest));
+        }
+        position += bits;
+        return result;
+    }
+
+    static std::int64_t signExtend(std::uint64_t value, unsigned bits) {
+        const std::uint64_t sign = std::uint64_t(1) << (bits - 1);
+        return static_cast<std::int64_t>((value ^ sign) - sign);
+    }
+
+    const HistoryBlock& block;
+    std::size_t position = 0;
+    std::uint32_t decoded = 0;
+    std::uint64_t previousTime = 0;
+    std::int64_t previousDelta = 0;
+    std::uint64_t previousBits = 0;
+    unsigned leading = 0;
+    unsigned trailing = 0;
+};
+
+// Compressed time series of one signal: a FIFO of fixed-size blocks, the last one open for appends
+class CompressedSeries {
+public:
+    // Timestamps must not decrease
+    void append(std::uint64_t timestampNs, double value, const HistoryConfig& config);
+
+    // Appends every retained sample in [fromNs, toNs] to out, oldest first
+    void decode(std::uint64_t fromNs, std::uint64_t toNs, std::vector<HistorySample>& out,
+                const HistoryConfig& config) const;
+
+    // Calls onSample(timestampNs, value) for every retained sample, oldest first
+    template <typename OnSample>
+    void forEach(const HistoryConfig& config, OnSample&& onSample) const {
+        std::uint64_t time;
+        double value;
+        for (std::size_t b = head; b < blocks.size(); ++b) {
+            HistoryBlockDecoder decoder(*blocks[b]);
+            while (decoder.next(time, value)) {
+                onSample(time * config.resolutionNs, config.valueResolution > 0.0 ? value * config.valueResolution : value);
+            }
+        }
+    }
+
+    std::uint64_t sampleCount() const { return samples; }
+    std::size_t blockCount() const { return blocks.size() - head; }
+    // Bytes held by blocks (including the spare), excluding the bookkeeping vector
+    std::size_t memoryBytes() const { return (blockCount() + (spare ? 1 : 0)) * sizeof(HistoryBlock); }
+
+private:
+    void openBlock(std::uint64_t time, std::uint64_t bits);
+    void dropExpired(std::uint64_t time, const HistoryConfig& config);
+    void write(std::uint64_t value, unsigned bits);
+
+    // blocks[head..] are retained; dropped block slots before head are compacted lazily
+    std::vector<std::unique_ptr<HistoryBlock>> blocks;
+    std::size_t head = 0;
+    std::unique_ptr<HistoryBlock> spare;   // Last dropped block, reused for the next one
+    std::uint64_t samples = 0;
+
+    // Encoder state of the open block
+    std::uint64_t previousTime = 0;
+    std::int64_t previousDelta = 0;
+    std::uint64_t previousBits = 0;
+    unsigned leading = 0;
+    unsigned trailing = 0;
+    bool haveWindow = false;
+};
+
+// History of every signal of a number of vehicles.
+//
+// Different vehicles may be appended to concurrently; one vehicle's signals
+// must be appended from one thread at a time.
+class SignalHistory {
+public:
+    explicit SignalHistory(std::size_t vehicleCount = 1, HistoryConfig config = HistoryConfig());
+
+    void append(std::size_t vehicle, Signal signal, std::uint64_t timestampNs, double value) {
+        series[vehicle * kSignalCount + static_cast<std::size_t>(signal)].append(timestampNs, value, settings);
+    }
+
+    // Appends one sample of every signal; values indexed by Signal
+    void appendAll(std::size_t vehicle, std::uint64_t timestampNs, const double (&values)[kSignalCount]);
+
+    // Appends every signal of fleet vehicles [begin, end)
+    void appendFleet(const Fleet& fleet, std::size_t begin, std::size_t end, std::uint64_t timestampNs);
+
+    const CompressedSeries& of(std::size_t vehicle, Signal signal) const {
+        return series[vehicle * kSignalCount + static_cast<std::size_t>(signal)];
+    }
+    std::vector<HistorySample> decode(std::size_t vehicle, Signal signal, std::uint64_t fromNs = 0,
+                                      std::uint64_t toNs = UINT64_MAX) const;
+
+    const HistoryConfig& config() const { return settings; }
+    std::size_t vehicleCount() const { return series.size() / kSignalCount; }
+    std::uint64_t sampleCount() const;
+    std::size_t memoryBytes() const;
+
+private:
+    HistoryConfig settings;
+    std::vector<CompressedSeries> series;
+};
+
+#endif // SIGNAL_HISTORY_HPP
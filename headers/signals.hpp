@@ -0,0 +1,75 @@
+#ifndef SIGNALS_HPP
+#define SIGNALS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Every numeric quantity the vehicle exposes, in a fixed order shared by
+// binary logs, fleet storage and external readers.
+enum class Signal : std::uint8_t {
+    Speed,
+    FuelLevel,
+    EngineTemperature,
+    BatteryCharge,
+    BatteryTemperature,
+    RadarDistance,
+    Throttle,
+    BrakePressure,
+    Gear,
+    Count
+};
+
+constexpr std::size_t kSignalCount = static_cast<std::size_t>(Signal::Count);
+
+/// Returns the human readable name of a signal.
+/// @param signal The signal to name.
+/// @return A static string, or "Unknown" for out-of-range values.
+inline const char* signalName(Signal signal) {
+    switch (signal) {
+        case Signal::Speed: return "Speed";
+        case Signal::FuelLevel: return "Fuel";
+        case Signal::EngineTemperature: return "Temperature";
+        case Signal::BatteryCharge: return "Battery Charge";
+        case Signal::BatteryTemperature: return "Battery Temperature";
+        case Signal::RadarDistance: return "Radar Distance";
+        case Signal::Throttle: return "Throttle Position";
+        case Signal::BrakePressure: return "Brake Pressure";
+        case Signal::Gear: return "Gear";
+        default: return "Unknown";
+    }
+}
+
+/// Returns the identifier of a signal as used in configuration files.
+/// @param signal The signal to name.
+/// @return A static lowercase string, or "unknown" for out-of-range values.
+inline const char* signalKey(Signal signal) {
+    switch (signal) {
+        case Signal::Speed: return "speed";
+        case Signal::FuelLevel: return "fuel_level";
+        case Signal::EngineTemperature: return "engine_temperature";
+        case Signal::BatteryCharge: return "battery_charge";
+        case Signal::BatteryTemperature: return "battery_temperature";
+        case Signal::RadarDistance: return "radar_distance";
+        case Signal::Throttle: return "throttle";
+        case Signal::BrakePressure: return "brake_pressure";
+        case Signal::Gear: return "gear";
+        default: return "unknown";
+    }
+}
+
+/// Looks up a signal by its configuration identifier (see signalKey()).
+/// @param key The identifier.
+/// @param signal Receives the signal.
+/// @return false if no signal has that identifier.
+inline bool parseSignalKey(std::string_view key, Signal& signal) {
+    for (std::size_t i = 0; i < kSignalCount; ++i) {
+        if (key == signalKey(static_cast<Signal>(i))) {
+            signal = static_cast<Signal>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif // SIGNALS_HPP
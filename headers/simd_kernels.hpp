@@ -0,0 +1,69 @@
+#ifndef SIMD_KERNELS_HPP
+#define SIMD_KERNELS_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#include "rng.hpp"
+
+// Batch kernels over arrays of vehicles. Each kernel has a scalar, an SSE2
+// and an AVX2 implementation; the widest one the CPU supports is picked once
+// at startup (override with the VT_SIMD environment variable: scalar, sse2, avx2).
+// All implementations produce bit-identical results.
+namespace simd {
+
+enum class Isa { Scalar, Sse2, Avx2 };
+
+/// @return The instruction set the kernels currently dispatch to.
+Isa activeIsa();
+
+/// @return A short lowercase name for an instruction set.
+const char* isaName(Isa isa);
+
+/// Switches dispatch to another instruction set.
+/// @return false (and leaves dispatch unchanged) if the CPU does not support it.
+bool setIsa(Isa isa);
+
+/// out[i] = low + (high - low) * unit[i]
+void scaleUniform(double* out, const double* unit, double low, double high, std::size_t n);
+
+/// values[i] += low + (high - low) * unit[i]
+void addUniform(double* values, const double* unit, double low, double high, std::size_t n);
+
+/// level[i] = max(0, level[i] - (low + (high - low) * unit[i]))
+void drainUniform(double* level, const double* unit, double low, double high, std::size_t n);
+
+/// temperature[i] = vehicle_model::engineTemperature(speed[i], noise drawn from unit[i])
+void engineTemperature(double* temperature, const double* speed, const double* unit, std::size_t n);
+
+/// values[i] = clamp(values[i], low, high), as clamp() in ecu.hpp: NaN stays NaN
+void clamp(double* values, double low, double high, std::size_t n);
+
+/// throttle[i], brake[i] = vehicle_model::accBandCommand(distance[i]) clamped to the actuator limits
+void accBand(const double* distance, double* throttle, double* brake, std::size_t n);
+
+/// masks[i] |= bit when values[i] is above (or below) threshold
+void thresholdMask(const double* values, double threshold, bool warnAbove, std::uint32_t bit,
+                   std::uint32_t* masks, std::size_t n);
+
+/// out[i] = rng::uniformAt<rng::Philox4x32>(seed, firstVehicle + i, channel, tick), several Philox blocks
+/// per instruction
+void philoxUniform(std::uint64_t seed, RandomChannel channel, std::uint64_t tick,
+                   std::uint32_t firstVehicle, double* out, std::size_t n);
+
+/// out[i] = rng::uniformAt<Generator>(seed, firstVehicle + i, channel, tick): the vector kernel for
+/// Philox, one scalar block at a time for other generators
+template <typename Generator = rng::DefaultGenerator>
+void uniform(std::uint64_t seed, RandomChannel channel, std::uint64_t tick, std::uint32_t firstVehicle, double* out,
+             std::size_t n) {
+    if constexpr (std::is_same<Generator, rng::Philox4x32>::value) {
+        philoxUniform(seed, channel, tick, firstVehicle, out, n);
+    } else {
+        rng::fillUniformScalar<Generator>(seed, channel, tick, firstVehicle, out, n);
+    }
+}
+
+} // namespace simd
+
+#endif // SIMD_KERNELS_HPP
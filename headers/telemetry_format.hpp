@@ -0,0 +1,104 @@
+#ifndef TELEMETRY_FORMAT_HPP
+#define TELEMETRY_FORMAT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// On-disk layout of the binary telemetry log.
+//
+//   FileHeader
+//   { BlockHeader, TelemetryRecord[recordCount] } ...
+//
+// All integers and doubles are stored in the host's native (little-endian)
+// byte order. Each block carries the CRC-32 of its payload so a truncated or
+// damaged block can be detected and skipped without losing the rest of the file.
+
+constexpr std::uint32_t kTelemetryFileMagic = 0x4C455456;   // "VTEL"
+constexpr std::uint32_t kTelemetryBlockMagic = 0x4B425456;  // "VTBK"
+constexpr std::uint16_t kTelemetryFormatVersion = 1;
+constexpr std::size_t kTelemetryMaxFields = 6;
+
+// Kind of event a record describes; decides how its fields are interpreted
+enum class TelemetryRecordType : std::uint16_t {
+    SensorSnapshot = 1,     // speed, fuel, engine temp, battery charge, battery temp, radar distance
+    AccDecision = 2,        // radar distance, throttle, brake pressure, band
+    DiagnosticReading = 3   // signal id, value, threshold, warning flag
+};
+
+struct TelemetryFileHeader {
+    std::uint32_t magic;
+    std::uint16_t version;
+    std::uint16_t recordSize;
+    std::uint32_t blockCapacity;
+    std::uint32_t reserved;
+};
+
+struct TelemetryBlockHeader {
+    std::uint32_t magic;
+    std::uint32_t recordCount;
+    std::uint32_t payloadBytes;
+    std::uint32_t crc32;
+};
+
+// One fixed-size event; unused fields are zero
+struct TelemetryRecord {
+    std::uint16_t type;
+    std::uint16_t fieldCount;
+    std::uint32_t vehicleId;
+    std::uint64_t timestampNs;  // Monotonic (steady clock) nanoseconds
+    double fields[kTelemetryMaxFields];
+};
+
+static_assert(sizeof(TelemetryFileHeader) == 16, "TelemetryFileHeader layout changed");
+static_assert(sizeof(TelemetryBlockHeader) == 16, "TelemetryBlockHeader layout changed");
+static_assert(sizeof(TelemetryRecord) == 64, "TelemetryRecord layout changed");
+
+namespace telemetry_detail {
+// Table k advances the CRC over a byte followed by k zero bytes (slicing-by-8)
+constexpr std::array<std::array<std::uint32_t, 256>, 8> makeCrc32Tables() {
+    std::array<std::array<std::uint32_t, 256>, 8> tables{};
+    for (std::uint32_t i = 0; i < 256; ++i) {
+        std::uint32_t c = i;
+        for (int k = 0; k < 8; ++k) {
+            c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+        }
+        tables[0][i] = c;
+    }
+    for (std::size_t t = 1; t < 8; ++t) {
+        for (std::uint32_t i = 0; i < 256; ++i) {
+            tables[t][i] = tables[0][tables[t - 1][i] & 0xFFu] ^ (tables[t - 1][i] >> 8);
+        }
+    }
+    return tables;
+}
+constexpr std::array<std::array<std::uint32_t, 256>, 8> kCrc32Tables = makeCrc32Tables();
+}
+
+/// Computes the CRC-32 (IEEE 802.3) of a byte range, eight bytes per step.
+/// @param data Pointer to the first byte.
+/// @param size Number of bytes.
+/// @return The checksum.
+inline std::uint32_t crc32(const void* data, std::size_t size) {
+    using telemetry_detail::kCrc32Tables;
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for (; size >= 8; bytes += 8, size -= 8) {
+        std::uint32_t low;
+        std::uint32_t high;
+        std::memcpy(&low, bytes, sizeof(low));
+        std::memcpy(&high, bytes + 4, sizeof(high));
+        low ^= crc;   // Little-endian: byte 0 is the low byte
+        crc = kCrc32Tables[7][low & 0xFFu] ^ kCrc32Tables[6][(low >> 8) & 0xFFu] ^
+              kCrc32Tables[5][(low >> 16) & 0xFFu] ^ kCrc32Tables[4][low >> 24] ^
+              kCrc32Tables[3][high & 0xFFu] ^ kCrc32Tables[2][(high >> 8) & 0xFFu] ^
+              kCrc32Tables[1][(high >> 16) & 0xFFu] ^ kCrc32Tables[0][high >> 24];
+    }
+    for (; size > 0; ++bytes, --size) {
+        crc = kCrc32Tables[0][(crc ^ *bytes) & 0xFFu] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+#endif // TELEMETRY_FORMAT_HPP
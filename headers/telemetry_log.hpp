@@ -0,0 +1,114 @@
+#ifndef TELEMETRY_LOG_HPP
+#define TELEMETRY_LOG_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "signals.hpp"
+#include "telemetry_format.hpp"
+
+// Binary structured telemetry log, written alongside the text Logger.
+//
+// Records are appended to one of two blocks under a short lock; a full block
+// is handed to a writer thread, which computes its CRC and writes it while
+// the other block fills. Record() only waits if the writer is still busy with
+// the previous block when the next one fills up.
+class TelemetryLog {
+public:
+    // Get the Singleton instance (declaration)
+    static TelemetryLog& GetInstance();
+
+    // Open a telemetry file, writing its header (declaration)
+    void Open(const std::string& filePath, std::uint32_t blockCapacity = 4096);
+
+    // Write any buffered records and close the file (declaration)
+    void Close();
+
+    bool IsOpen() const { return isOpen.load(std::memory_order_acquire); }
+
+    // Record helpers for each record type (declarations)
+    void RecordSensorSnapshot(std::uint32_t vehicleId, double speed, double fuel, double engineTemperature,
+                              double batteryCharge, double batteryTemperature, double radarDistance);
+    void RecordAccDecision(std::uint32_t vehicleId, double distance, double throttle, double brake, int band);
+    void RecordDiagnostic(std::uint32_t vehicleId, Signal signal, double value, double threshold, bool warning);
+
+    // Append a raw record; the timestamp is filled in if it is zero (declaration)
+    void Record(TelemetryRecord record);
+
+    // Write the current partial block to disk (declaration)
+    void Flush();
+
+    std::uint64_t GetBytesWritten() const { return bytesWritten.load(std::memory_order_relaxed); }
+
+    // Monotonic timestamp used for records (declaration)
+    static std::uint64_t NowNs();
+
+    // Stamp records with simulated time instead of NowNs() from now on (declaration)
+    void SetVirtualTimeNs(std::uint64_t timeNs);
+
+private:
+    TelemetryLog() = default;
+    ~TelemetryLog();
+
+    TelemetryLog(const TelemetryLog&) = delete;
+    TelemetryLog& operator=(const TelemetryLog&) = delete;
+
+    void HandOffLocked(std::unique_lock<std::mutex>& lock);
+    void WriterLoop();
+    void WriteBlock(const std::vector<TelemetryRecord>& records);
+
+    std::ofstream file;                      // Writer thread only while open, except Flush()
+    std::mutex mutex;
+    std::condition_variable writerWakeup;
+    std::condition_variable blockWritten;
+    std::vector<TelemetryRecord> block;      // Being filled
+    std::vector<TelemetryRecord> pending;    // Handed to the writer
+    bool writing = false;                    // pending holds a block not yet written
+    bool stopping = false;
+    std::thread writerThread;
+    std::uint32_t blockCapacity = 0;
+    std::atomic<bool> isOpen{false};
+    std::atomic<std::uint64_t> bytesWritten{0};
+    std::atomic<bool> useVirtualTime{false};
+    std::atomic<std::uint64_t> virtualTimeNs{0};
+};
+
+// Sequential reader for binary telemetry files
+class TelemetryReader {
+public:
+    // Open a telemetry file and validate its header (declaration)
+    explicit TelemetryReader(const std::string& filePath);
+
+    // Read the next intact block; corrupt blocks are counted and skipped (declaration)
+    bool NextBlock(std::vector<TelemetryRecord>& records);
+
+    std::uint64_t GetCorruptBlocks() const { return corruptBlocks; }
+
+private:
+    // Seek to the next block magic at or after an offset (declaration)
+    bool Resync(std::streamoff offset);
+
+    std::ifstream file;
+    TelemetryFileHeader header{};
+    std::streamoff fileSize = 0;
+    std::uint64_t corruptBlocks = 0;
+};
+
+/// Returns the short name of a record type, as used by the decoder.
+/// @param type The record type tag.
+/// @return A static string, or "unknown".
+const char* telemetryRecordTypeName(std::uint16_t type);
+
+/// Returns the name of a field of a given record type.
+/// @param type The record type tag.
+/// @param index The field index.
+/// @return A static string, or "field" for unnamed fields.
+const char* telemetryFieldName(std::uint16_t type, std::size_t index);
+
+#endif // TELEMETRY_LOG_HPP
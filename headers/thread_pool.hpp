@@ -0,0 +1,72 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ThreadPoolConfig {
+    std::size_t threads = 0;     // Participating threads including the caller; 0 = hardware concurrency
+    bool pinThreads = false;     // Pin participant i to CPU (firstCpu + i) modulo the CPU count;
+                                 // participant 0 is whichever thread calls parallelFor()
+    std::size_t firstCpu = 0;
+};
+
+// Fixed-size pool running index-space jobs with work stealing.
+//
+// parallelFor() splits [0, taskCount) into one contiguous range per participant
+// (the calling thread is participant 0). Each participant takes tasks from the
+// front of its own range; an idle participant steals the back half of another's
+// range. parallelFor() returns only after every task has finished and every
+// worker has left the job, so consecutive calls are separated by a full barrier.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(const ThreadPoolConfig& config = ThreadPoolConfig());
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void parallelFor(std::size_t taskCount, const std::function<void(std::size_t)>& task);
+
+    std::size_t threadCount() const { return participantCount; }
+    std::uint64_t stealCount() const { return steals.load(std::memory_order_relaxed); }
+
+private:
+    // Remaining task range of one participant, packed as (begin << 32) | end
+    struct alignas(64) TaskRange {
+        std::atomic<std::uint64_t> packed{0};
+    };
+
+    void workerLoop(std::size_t participant);
+    void runParticipant(std::size_t participant);
+    bool popLocal(std::size_t participant, std::size_t& task);
+    bool stealInto(std::size_t thief);
+    static void pinToCpu(std::thread::native_handle_type handle, std::size_t cpu);
+
+    std::size_t participantCount;
+    std::unique_ptr<TaskRange[]> ranges;
+    std::vector<std::thread> workers;
+    bool pinThreads;
+    std::size_t callerCpu = 0;                // Participant 0's CPU when pinning
+    std::thread::id pinnedCaller;             // Calling thread last pinned to callerCpu
+
+    std::mutex mutex;
+    std::condition_variable jobReady;
+    std::condition_variable jobDone;
+    std::uint64_t generation = 0;
+    bool stopping = false;
+
+    const std::function<void(std::size_t)>* job = nullptr;
+    std::atomic<std::size_t> remainingTasks{0};
+    std::atomic<std::size_t> busyWorkers{0};
+    std::atomic<std::uint64_t> steals{0};
+};
+
+#endif // THREAD_POOL_HPP
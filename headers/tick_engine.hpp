@@ -0,0 +1,69 @@
+#ifndef TICK_ENGINE_HPP
+#define TICK_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+
+#include "fleet.hpp"
+#include "thread_pool.hpp"
+
+// Time spent in each pipeline stage, summed over all chunks and threads
+struct StageTimes {
+    std::uint64_t sensorsNs = 0;
+    std::uint64_t accNs = 0;
+    std::uint64_t diagnosticsNs = 0;
+    std::uint64_t observerNs = 0;
+};
+
+struct TickEngineConfig {
+    std::size_t threads = 0;        // 0 = hardware concurrency
+    std::size_t chunkSize = 4096;   // Vehicles per task, rounded up to a multiple of Fleet::kKernelBlock
+    bool pinThreads = false;
+    std::size_t firstCpu = 0;
+};
+
+// Advances a Fleet one tick at a time across a work-stealing thread pool.
+//
+// Vehicles are sharded into chunks. Each task runs the full per-vehicle
+// pipeline for its chunk in dependency order (sensors, with speed before
+// temperature, then ACC, then diagnostics, then the optional chunk observer
+// standing in for display/publishing). tick() returns only after every
+// chunk has finished, which is the per-tick barrier.
+class TickEngine {
+public:
+    // Called with [begin, end) after a chunk's diagnostics, on the worker that ran the chunk
+    using ChunkObserver = std::function<void(std::size_t begin, std::size_t end)>;
+
+    explicit TickEngine(Fleet& fleet, const TickEngineConfig& config = TickEngineConfig());
+
+    void tick();
+
+    void setChunkObserver(ChunkObserver observer) { chunkObserver = std::move(observer); }
+
+    std::uint64_t tickCount() const { return ticks; }
+    std::size_t chunkCount() const { return chunks; }
+    std::size_t chunkVehicles() const { return chunkSize; }
+    std::size_t threadCount() const { return pool.threadCount(); }
+    std::uint64_t stealCount() const { return pool.stealCount(); }
+    StageTimes stageTimes() const;
+
+private:
+    void runChunk(std::size_t chunk);
+
+    Fleet& fleet;
+    std::size_t chunkSize;
+    std::size_t chunks;
+    WorkStealingPool pool;
+    ChunkObserver chunkObserver;
+    std::function<void(std::size_t)> chunkTask;
+    std::uint64_t ticks = 0;
+    std::atomic<std::uint64_t> sensorsNs{0};
+    std::atomic<std::uint64_t> accNs{0};
+    std::atomic<std::uint64_t> diagnosticsNs{0};
+    std::atomic<std::uint64_t> observerNs{0};
+};
+
+#endif // TICK_ENGINE_HPP
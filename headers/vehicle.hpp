@@ -1,36 +1,100 @@
 #ifndef VEHICLE_HPP
 #define VEHICLE_HPP
 
-#include "sensors.hpp"
+#include "sensor_registry.hpp"
 #include "ecu.hpp"
 #include "logger.hpp"
-#include "battery.hpp"
 #include "dashboard.hpp"
 #include "diagnostics.hpp"
 #include "acc.hpp"
+#include "vehicle_state.hpp"
+#include "scheduler.hpp"
+#include "signal_bus.hpp"
+#include "sensor_recording.hpp"
+#include <chrono>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <vector>
 
 class Vehicle {
 public:
 
     void updateSensors();
+    // Updates one sensor of VehicleSensors and publishes its readings, for running each sensor at its own rate.
+    // The debug message is sampled down to about one per second of the sensor's schedule.
+    template <typename S>
+    void updateSensor() {
+        VT_PROBE(Sensors);
+        sensors.update<S>(bus);
+        VT_LOG_EVERY_N(logger, Debug, Sensors, std::chrono::seconds(1) / SensorTraits<S>::kPeriod, "{} updated.",
+                       SensorTraits<S>::kDescription);
+    }
+    void recordTelemetry();
     void adaptiveCruiseControl();
     void displayDashboard();
     void runDiagnostics();
-    Vehicle(const std::string& filePath);
+    VehicleState state() const;
+    // Registers every subsystem at its own rate; the dashboard is optional for headless runs
+    void scheduleTasks(TaskScheduler& scheduler, bool withDashboard = true);
+    // The split used to run the control loop on its own thread: radar and ACC...
+    void scheduleControlTasks(TaskScheduler& scheduler);
+    // ...and everything else
+    void scheduleMonitorTasks(TaskScheduler& scheduler, bool withDashboard = true);
+    // Adds a sensor only known at run time (see Sensor) and publishes its first reading. It is
+    // updated and published after the static sensors by updateSensors(), and in the scheduled
+    // modes by a task of its own at period, on the control scheduler if controlLoop; add plug-ins
+    // before scheduling. Publishing a static sensor's signal needs the same controlLoop side, and
+    // the plug-in's readings then supersede that sensor's (it runs after it).
+    void addSensor(std::unique_ptr<Sensor> sensor, const std::string& name, std::chrono::nanoseconds period,
+                   bool controlLoop = false);
+    std::size_t pluginSensorCount() const { return plugins.size(); }
+    // Drives ACC, the dashboard and the diagnostics from a recording instead of the
+    // sensors (nullptr to go back); takes effect for tasks scheduled afterwards
+    void setReplay(SensorReplay* replay);
+    // Every reading and actuator command is published here
+    const SignalBus& signalBus() const { return bus; }
+    // Stamps bus samples with this virtual time from now on (headless runs)
+    void setVirtualTimeNs(std::uint64_t timeNs);
+    // Enables or disables the diagnostics report on the console
+    void setConsoleOutput(bool enabled);
+    // Replaces the diagnostic rules (see RuleSet for the rules file format)
+    void setDiagnosticRules(RuleSet rules);
+    // Rule state of the diagnostics; read it on the thread that runs them
+    const RuleEngine& diagnosticRules() const;
+    // Every component is a member, so a vehicle is one object plus its bus history (taken from the arena
+    // if one is given; it must then outlive the vehicle) and the diagnostics' and dashboard's buffers
+    Vehicle(const std::string& filePath, std::uint32_t vehicleId = 0, std::uint64_t seed = 0, Arena* arena = nullptr,
+            std::size_t busHistory = SignalBus::kDefaultHistory);
+
+    Vehicle(const Vehicle&) = delete;
+    Vehicle& operator=(const Vehicle&) = delete;
 private:
-    std::shared_ptr<SpeedSensor> speedSensor;
-    std::shared_ptr<FuelSensor> fuelSensor;
-    std::shared_ptr<TemperatureSensor> tempSensor;
-    std::shared_ptr<Battery> battery;
-    std::shared_ptr<RadarSensor> radarSensor;
-    std::shared_ptr<EngineControlUnit> engineECU;
-    std::shared_ptr<BrakeControlUnit> brakeECU;
-    std::shared_ptr<TransmissionControlUnit> transmissionECU;
+    // Adds a task per sensor (and plug-in) whose SensorTraits::kControlLoop matches
+    template <bool ControlLoop>
+    void scheduleSensorTasks(TaskScheduler& scheduler);
+
+    struct PluginSensor {
+        std::unique_ptr<Sensor> sensor;
+        std::string name;
+        std::chrono::nanoseconds period;
+        bool controlLoop;
+    };
+    void updatePlugin(Sensor& sensor);
+
+    std::uint32_t vehicleId;
+    VehicleSensors sensors;
+    EngineControlUnit engineECU;
+    BrakeControlUnit brakeECU;
+    TransmissionControlUnit transmissionECU;
     Logger& logger;
-    std::unique_ptr<Dashboard> dashboard;
-    std::unique_ptr<VehicleDiagnostics> diagnostics;
-    std::unique_ptr<CruiseControlSystem> cruiseControl;
+    SignalBus bus;
+    SensorReplay* replay = nullptr;
+    std::vector<PluginSensor> plugins;
+    // The dashboard, diagnostics and ACC keep references to the bus and ECUs above
+    Dashboard dashboard;
+    VehicleDiagnostics diagnostics;
+    CruiseControlSystem cruiseControl;
     
 };
 
@@ -0,0 +1,117 @@
+#ifndef VEHICLE_MODEL_HPP
+#define VEHICLE_MODEL_HPP
+
+#include <algorithm>
+
+#include "signals.hpp"
+
+// Simulation constants and per-sample model equations shared by the
+// object-per-vehicle classes (sensors, Battery, ECUs, ACC, diagnostics)
+// and the struct-of-arrays Fleet, so both always simulate the same car.
+namespace vehicle_model {
+
+// Speed sensor: uniformly random speed in km/h
+constexpr double kSpeedMin = 0.0;
+constexpr double kSpeedMax = 200.0;
+
+// Fuel sensor: liters, drained by a random amount per update
+constexpr double kFuelInitial = 50.0;
+constexpr double kFuelUseMin = 0.1;
+constexpr double kFuelUseMax = 0.5;
+
+// Temperature sensor: rises with speed plus random noise, in °C
+constexpr double kEngineTempInitial = 70.0;
+constexpr double kEngineTempBase = 70.0;
+constexpr double kEngineTempPerKmh = 0.1;
+constexpr double kEngineTempNoise = 2.0;
+
+// Battery: percent charge drained per update, temperature random walk in °C
+constexpr double kBatteryChargeInitial = 100.0;
+constexpr double kBatteryUseMin = 0.1;
+constexpr double kBatteryUseMax = 0.3;
+constexpr double kBatteryTempInitial = 25.0;
+constexpr double kBatteryTempStep = 0.1;
+
+// Radar sensor: distance to the vehicle ahead in meters
+constexpr double kRadarInitial = 100.0;
+constexpr double kRadarMin = 10.0;
+constexpr double kRadarMax = 200.0;
+
+// ECU actuator limits
+constexpr double kActuatorMin = 0.0;
+constexpr double kActuatorMax = 100.0;
+constexpr int kGearMin = 1;
+constexpr int kGearMax = 6;
+
+// Adaptive cruise control bands
+constexpr double kAccSlowDownDistance = 50.0;
+constexpr double kAccSpeedUpDistance = 100.0;
+constexpr double kAccSlowDownThrottle = 30.0;
+constexpr double kAccSlowDownBrake = 50.0;
+constexpr double kAccMaintainThrottle = 50.0;
+constexpr double kAccSpeedUpThrottle = 70.0;
+// Period of the vehicle's ACC task, the controllers' time step
+constexpr double kAccPeriodSeconds = 0.01;
+
+// Output of one ACC decision
+struct AccCommand {
+    double throttle;
+    double brake;
+    int band;  // 0 = slowing down, 1 = maintaining speed, 2 = speeding up
+};
+
+/// Picks the ACC band for a radar distance.
+/// @param distance Distance to the vehicle ahead in meters.
+/// @return The throttle, brake and band to apply.
+inline AccCommand accBandCommand(double distance) {
+    if (distance < kAccSlowDownDistance) {
+        return {kAccSlowDownThrottle, kAccSlowDownBrake, 0};
+    }
+    if (distance < kAccSpeedUpDistance) {
+        return {kAccMaintainThrottle, 0.0, 1};
+    }
+    return {kAccSpeedUpThrottle, 0.0, 2};
+}
+
+/// Maps a uniform draw in [0, 1) onto [low, high).
+inline double scaleUniform(double unit, double low, double high) {
+    return low + (high - low) * unit;
+}
+
+/// Drains a level by an amount without going below zero.
+inline double drain(double level, double amount) {
+    return std::max(0.0, level - amount);
+}
+
+/// Engine temperature for a given speed and noise sample.
+inline double engineTemperature(double speed, double noise) {
+    return kEngineTempBase + (speed * kEngineTempPerKmh) + noise;
+}
+
+// One diagnostic threshold check
+struct DiagnosticCheck {
+    Signal signal;
+    double threshold;
+    bool warnAbove;  // true: warn when value > threshold, false: warn when value < threshold
+    const char* warningMessage;
+};
+
+constexpr DiagnosticCheck kDiagnosticChecks[] = {
+    {Signal::Speed, 120.0, true, "High speed detected!"},
+    {Signal::FuelLevel, 5.0, false, "Low fuel level!"},
+    {Signal::EngineTemperature, 90.0, true, "Engine overheating!"},
+    {Signal::BatteryCharge, 20.0, false, "Low battery charge!"},
+    {Signal::BatteryTemperature, 40.0, true, "Battery overheating!"},
+    {Signal::RadarDistance, 20.0, false, "Vehicle ahead too close!"},
+};
+
+constexpr std::size_t kDiagnosticCheckCount = sizeof(kDiagnosticChecks) / sizeof(kDiagnosticChecks[0]);
+
+/// Evaluates a diagnostic check against a value.
+inline bool isWarning(const DiagnosticCheck& check, double value) {
+    return check.warnAbove ? value > check.threshold : value < check.threshold;
+}
+
+} // namespace vehicle_model
+
+#endif // VEHICLE_MODEL_HPP
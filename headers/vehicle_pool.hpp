@@ -0,0 +1,46 @@
+#ifndef VEHICLE_POOL_HPP
+#define VEHICLE_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "arena.hpp"
+#include "vehicle.hpp"
+
+// A fleet of full Vehicles laid out in one Arena block: the vehicles sit side by
+// side, followed by their signal bus histories, so building a pool is one
+// allocation plus the diagnostics' and dashboards' small buffers, and tearing it
+// down runs the destructors and releases the block once. Vehicle i has id i and
+// the pool's seed, so it reproduces a standalone Vehicle(logPath, i, seed).
+class VehiclePool {
+public:
+    VehiclePool(std::size_t count, const std::string& logPath, std::uint64_t seed = 0,
+                std::size_t busHistory = SignalBus::kDefaultHistory);
+    ~VehiclePool();
+
+    VehiclePool(const VehiclePool&) = delete;
+    VehiclePool& operator=(const VehiclePool&) = delete;
+
+    std::size_t size() const { return count; }
+    Vehicle& operator[](std::size_t index) { return vehicles[index]; }
+    const Vehicle& operator[](std::size_t index) const { return vehicles[index]; }
+    Vehicle* begin() { return vehicles; }
+    Vehicle* end() { return vehicles + count; }
+
+    // Memory taken from the arena
+    std::size_t bytes() const { return arena.bytesAllocated(); }
+    std::size_t blockCount() const { return arena.blockCount(); }
+
+    // Arena bytes one vehicle takes with this bus history, alignment included
+    static std::size_t bytesPerVehicle(std::size_t busHistory);
+
+private:
+    void destroyVehicles();
+
+    Arena arena;
+    Vehicle* vehicles;
+    std::size_t count = 0;   // Vehicles constructed so far
+};
+
+#endif // VEHICLE_POOL_HPP
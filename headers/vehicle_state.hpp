@@ -0,0 +1,26 @@
+#ifndef VEHICLE_STATE_HPP
+#define VEHICLE_STATE_HPP
+
+#include <iostream>
+
+#include "signals.hpp"
+
+// Snapshot of one vehicle's sensor readings and actuator states
+struct VehicleState {
+    double speed;
+    double fuelLevel;
+    double engineTemperature;
+    double batteryCharge;
+    double batteryTemperature;
+    double radarDistance;
+    double throttle;
+    double brakePressure;
+    int gear;
+};
+
+std::ostream& operator<<(std::ostream& os, const VehicleState& state);
+
+// Copies a state into an array indexed by Signal
+void toSignalValues(const VehicleState& state, double (&values)[kSignalCount]);
+
+#endif // VEHICLE_STATE_HPP
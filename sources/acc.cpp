@@ -3,44 +3,44 @@
 /**
  * @brief Constructor for the CruiseControlSystem class.
  * 
- * This constructor initializes the cruise control system by receiving shared pointers to the radar sensor,
- * engine control unit (ECU), and brake control unit (ECU), along with a reference to the logger.
+ * This constructor initializes the cruise control system by subscribing it to the signal bus and
+ * binding it to the engine control unit (ECU) and brake control unit (ECU) it commands.
  * 
- * @param radarSensor Shared pointer to the radar sensor.
- * @param engineECU Shared pointer to the engine control unit (ECU).
- * @param brakeECU Shared pointer to the brake control unit (ECU).
- * @param logger Reference to the logger for logging adaptive cruise control operations.
+ * @param bus The signal bus the radar publishes to; ACC publishes its throttle and brake commands back to it.
+ * @param engineECU The engine control unit (ECU); not owned, must outlive the system.
+ * @param brakeECU The brake control unit (ECU); not owned, must outlive the system.
+ * @param vehicleId Identifier of the owning vehicle, used in binary telemetry records.
  */
-CruiseControlSystem::CruiseControlSystem(const std::shared_ptr<RadarSensor>& radarSensor,
-                    const std::shared_ptr<EngineControlUnit>& engineECU,
-                    const std::shared_ptr<BrakeControlUnit>& brakeECU,
-                    Logger& logger)
-    : radarSensor(radarSensor), engineECU(engineECU), brakeECU(brakeECU), logger(logger) {}
+CruiseControlSystem::CruiseControlSystem(SignalBus& bus,
+                    EngineControlUnit& engineECU,
+                    BrakeControlUnit& brakeECU,
+                    std::uint32_t vehicleId)
+    : bus(bus), engineECU(engineECU), brakeECU(brakeECU), vehicleId(vehicleId) {}
 
 /**
  * @brief Implements adaptive cruise control logic.
  * 
- * This function adjusts the vehicle's speed and braking based on the distance to the vehicle ahead,
- * as detected by the radar sensor. The system slows down if the distance is less than 50 meters, 
- * maintains speed for distances between 50 and 100 meters, and accelerates if the distance exceeds 100 meters.
+ * This function runs one step of VehicleAccController on the last published radar distance and speed.
+ * With the default band controller the vehicle slows down below 50 meters, maintains speed up to
+ * 100 meters and accelerates beyond. The resulting throttle and brake commands are applied to the
+ * ECUs and published to the bus, and each decision is written to the binary telemetry log when it is
+ * open; nothing is logged as text, so the control path stays allocation-free. Nothing happens before
+ * the first radar reading.
  */
 void CruiseControlSystem::adaptiveCruiseControl() {
-    logger.Log("\n\nRunning adaptive cruise control.");
+    SignalSample radar;
+    if (!bus.latest(Signal::RadarDistance, radar)) {
+        return;
+    }
+    const vehicle_model::AccCommand command = VehicleAccController::step(
+        radar.value, bus.latestValue(Signal::Speed), vehicle_model::kAccPeriodSeconds, controllerState);
+    engineECU.setThrottlePosition(command.throttle);
+    brakeECU.setBrakePressure(command.brake);
 
-    double distance = radarSensor->readData();
-    logger.Log("Radar detected distance: " + std::to_string(distance));
+    const std::uint64_t now = bus.now();
+    bus.publish(Signal::Throttle, engineECU.getThrottlePosition(), now);
+    bus.publish(Signal::BrakePressure, brakeECU.getBrakePressure(), now);
 
-    if (distance < 50) {
-        logger.Log("Distance < 50, slowing down.");
-        engineECU->setThrottlePosition(30);
-        brakeECU->setBrakePressure(50);
-    } else if (distance < 100) {
-        logger.Log("Distance between 50 and 100, maintaining speed.");
-        engineECU->setThrottlePosition(50);
-        brakeECU->setBrakePressure(0);
-    } else {
-        logger.Log("Distance > 100, speeding up.");
-        engineECU->setThrottlePosition(70);
-        brakeECU->setBrakePressure(0);
-    }
+    TelemetryLog::GetInstance().RecordAccDecision(vehicleId, radar.value, engineECU.getThrottlePosition(),
+                                                  brakeECU.getBrakePressure(), command.band);
 }
@@ -0,0 +1,44 @@
+#include "../headers/acc_controllers.hpp"
+
+#include <stdexcept>
+
+// Built with -O3 -fno-trapping-math (see the makefile): the clamps in the
+// stateful controllers only if-convert into vector blends when comparisons
+// and the arithmetic feeding them are not treated as trapping.
+namespace acc {
+
+template void runBatch<TimeGapPid<>>(const double*, const double*, double, TimeGapPid<>::State*, double*, double*,
+                                     std::size_t);
+template void runBatch<ConstantTimeHeadway<>>(const double*, const double*, double, ConstantTimeHeadway<>::State*,
+                                              double*, double*, std::size_t);
+
+/**
+ * @brief Gets a controller's name.
+ *
+ * @param kind The controller.
+ * @return Its kName.
+ */
+const char* controllerName(ControllerKind kind) {
+    switch (kind) {
+        case ControllerKind::TimeGapPid: return TimeGapPid<>::kName;
+        case ControllerKind::ConstantTimeHeadway: return ConstantTimeHeadway<>::kName;
+        default: return BandController<>::kName;
+    }
+}
+
+/**
+ * @brief Looks a controller up by name.
+ *
+ * @param name band, pid or cth.
+ * @return The controller.
+ */
+ControllerKind parseController(const std::string& name) {
+    for (ControllerKind kind : {ControllerKind::Band, ControllerKind::TimeGapPid, ControllerKind::ConstantTimeHeadway}) {
+        if (name == controllerName(kind)) {
+            return kind;
+        }
+    }
+    throw std::runtime_error("Unknown ACC controller: " + name + " (expected band, pid or cth)");
+}
+
+} // namespace acc
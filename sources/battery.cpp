@@ -3,39 +3,13 @@
 /**
  * @brief Constructor for the Battery class
  * @details Initializes charge level to 100% and temperature to 25°C.
+ * @param seed Simulation seed for the battery's random streams.
+ * @param vehicleId Identifier of the owning vehicle, selecting its random streams.
  */
-Battery::Battery() : chargeLevel(100.0), temperature(25.0) {}
-
-/**
- * @brief Simulates battery usage by decreasing charge level and randomly adjusting temperature.
- * @details Uses random number generators to simulate battery usage and temperature fluctuations.
- */
-void Battery::update() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    std::uniform_real_distribution<> usage_dist(0.1, 0.3);
-    std::uniform_real_distribution<> temp_dist(-0.1, 0.1);
-
-    double usage = usage_dist(gen);
-    chargeLevel = std::max(0.0, chargeLevel - usage);
-    temperature += temp_dist(gen);
-}
-
-/**
- * @brief Reads the current charge level of the battery.
- * @return The current charge level in percentage.
- */
-double Battery::readCharge() const {
-    return chargeLevel;
-}
-
-/**
- * @brief Reads the current temperature of the battery.
- * @return The current temperature in degrees Celsius.
- */
-double Battery::readTemperature() const {
-    return temperature;
-}
+Battery::Battery(std::uint64_t seed, std::uint32_t vehicleId)
+    : chargeLevel(vehicle_model::kBatteryChargeInitial), temperature(vehicle_model::kBatteryTempInitial),
+      usageRng(seed, vehicleId, RandomChannel::BatteryUse),
+      temperatureRng(seed, vehicleId, RandomChannel::BatteryTemperatureStep) {}
 
 /**
  * @brief Overloads the << operator to print battery information to an output stream.
@@ -0,0 +1,222 @@
+#include "../headers/checkpoint.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "../headers/fleet.hpp"
+#include "../headers/rng.hpp"
+#include "../headers/rule_engine.hpp"
+#include "../headers/telemetry_format.hpp"
+
+namespace {
+constexpr std::size_t kSectionAlignment = 8;
+
+std::size_t padding(std::size_t bytes) {
+    return (kSectionAlignment - bytes % kSectionAlignment) % kSectionAlignment;
+}
+}
+
+/**
+ * @brief Constructor for the CheckpointWriter class; creates the temporary file and reserves the header.
+ *
+ * @param path The checkpoint's final path.
+ * @param header The header to write; sectionCount is filled in by finish().
+ */
+CheckpointWriter::CheckpointWriter(const std::string& path, const CheckpointHeader& header)
+    : path(path), tempPath(path + ".tmp"), header(header) {
+    file.open(tempPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to create checkpoint: " + tempPath);
+    }
+    this->header.magic = kCheckpointMagic;
+    this->header.version = kCheckpointVersion;
+    this->header.sectionCount = 0;
+    file.write(reinterpret_cast<const char*>(&this->header), sizeof(this->header));
+    bytes = sizeof(this->header);
+}
+
+/**
+ * @brief Destructor for the CheckpointWriter class; removes the temporary file of an unfinished checkpoint.
+ */
+CheckpointWriter::~CheckpointWriter() {
+    if (!finished) {
+        file.close();
+        std::remove(tempPath.c_str());
+    }
+}
+
+/**
+ * @brief Appends one section.
+ *
+ * @param name The section's name, checked when it is read back.
+ * @param data The array.
+ * @param elementSize Bytes per element.
+ * @param count Number of elements.
+ */
+void CheckpointWriter::writeBytes(const char* name, const void* data, std::size_t elementSize, std::size_t count) {
+    CheckpointSection section{};
+    std::snprintf(section.name, sizeof(section.name), "%s", name);
+    section.elementSize = static_cast<std::uint32_t>(elementSize);
+    section.count = count;
+    const std::size_t size = elementSize * count;
+    section.crc32 = crc32(data, size);
+    static const char zeros[kSectionAlignment] = {};
+    file.write(reinterpret_cast<const char*>(&section), sizeof(section));
+    file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    file.write(zeros, static_cast<std::streamsize>(padding(size)));
+    bytes += sizeof(section) + size + padding(size);
+    ++header.sectionCount;
+}
+
+/**
+ * @brief Writes the final header and renames the file into place.
+ */
+void CheckpointWriter::finish() {
+    file.seekp(0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.close();
+    if (file.fail()) {
+        throw std::runtime_error("Failed to write checkpoint: " + tempPath);
+    }
+    if (std::rename(tempPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to move checkpoint into place: " + path);
+    }
+    finished = true;
+}
+
+/**
+ * @brief Constructor for the CheckpointReader class; maps the file and validates the header.
+ *
+ * @param path The checkpoint file.
+ */
+CheckpointReader::CheckpointReader(const std::string& path) : path(path) {
+    const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open checkpoint: " + path);
+    }
+    struct stat info{};
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(CheckpointHeader)) {
+        close(fd);
+        throw std::runtime_error("Not a checkpoint: " + path);
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map checkpoint: " + path);
+    }
+    base = static_cast<const unsigned char*>(mapping);
+    // The sections are read front to back, once
+    madvise(mapping, size, MADV_SEQUENTIAL);
+    std::memcpy(&fileHeader, base, sizeof(fileHeader));
+    position = sizeof(fileHeader);
+    if (fileHeader.magic != kCheckpointMagic || fileHeader.version != kCheckpointVersion) {
+        munmap(mapping, size);
+        throw std::runtime_error("Not a checkpoint (or an unsupported version): " + path);
+    }
+}
+
+/**
+ * @brief Destructor for the CheckpointReader class; unmaps the file.
+ */
+CheckpointReader::~CheckpointReader() {
+    munmap(const_cast<unsigned char*>(base), size);
+}
+
+/**
+ * @brief Copies the next section into place after checking that it is the expected one.
+ *
+ * @param name The expected section name.
+ * @param data Receives the array.
+ * @param elementSize Expected bytes per element.
+ * @param count Expected number of elements.
+ */
+void CheckpointReader::readBytes(const char* name, void* data, std::size_t elementSize, std::size_t count) {
+    CheckpointSection section{};
+    if (sectionsRead == fileHeader.sectionCount || position + sizeof(section) > size) {
+        throw std::runtime_error("Checkpoint " + path + " ends before section " + name);
+    }
+    std::memcpy(&section, base + position, sizeof(section));
+    section.name[sizeof(section.name) - 1] = '\0';
+    if (std::strcmp(section.name, name) != 0 || section.elementSize != elementSize || section.count != count) {
+        throw std::runtime_error("Checkpoint " + path + " does not match this simulation: expected section " + name +
+                                 " of " + std::to_string(count) + " x " + std::to_string(elementSize) +
+                                 " bytes, found " + section.name + " of " + std::to_string(section.count) + " x " +
+                                 std::to_string(section.elementSize) + " bytes");
+    }
+    const std::size_t bytes = elementSize * count;
+    const unsigned char* source = base + position + sizeof(section);
+    if (position + sizeof(section) + bytes > size || crc32(source, bytes) != section.crc32) {
+        throw std::runtime_error("Damaged checkpoint section " + std::string(name) + ": " + path);
+    }
+    if (bytes > 0) {
+        std::memcpy(data, source, bytes);
+    }
+    position += sizeof(section) + bytes + padding(bytes);
+    ++sectionsRead;
+}
+
+/**
+ * @brief Saves a fleet run's complete state.
+ *
+ * @param path The checkpoint file; replaced only once the new checkpoint is complete.
+ * @param fleet The fleet, between ticks.
+ * @param rules The rule engine evaluating the fleet.
+ * @param dt Simulated time per tick.
+ * @return The checkpoint's size in bytes.
+ */
+std::uint64_t saveFleetCheckpoint(const std::string& path, const Fleet& fleet, const RuleEngine& rules,
+                                  std::chrono::nanoseconds dt) {
+    CheckpointHeader header{};
+    header.vehicleCount = fleet.size();
+    header.seed = fleet.seed();
+    header.generator = rng::DefaultGenerator::kId;
+    header.tick = fleet.tickIndex();
+    header.dtNs = static_cast<std::uint64_t>(dt.count());
+    header.rulesFingerprint = rules.rules().fingerprint();
+    CheckpointWriter writer(path, header);
+    fleet.saveState(writer);
+    rules.saveState(writer);
+    writer.finish();
+    return writer.bytesWritten();
+}
+
+/**
+ * @brief Reads a checkpoint's header.
+ *
+ * @param path The checkpoint file.
+ * @return Its vehicle count, seed, tick, time step and rules fingerprint.
+ */
+CheckpointHeader readCheckpointHeader(const std::string& path) {
+    return CheckpointReader(path).header();
+}
+
+/**
+ * @brief Restores a fleet run's state.
+ *
+ * @param path The checkpoint file.
+ * @param fleet A fleet of the checkpoint's vehicle count and seed; resumes at the checkpoint's tick.
+ * @param rules A rule engine over the fleet, with the rules the checkpoint was taken with.
+ */
+void restoreFleetCheckpoint(const std::string& path, Fleet& fleet, RuleEngine& rules) {
+    CheckpointReader reader(path);
+    const CheckpointHeader& header = reader.header();
+    if (header.vehicleCount != fleet.size() || header.seed != fleet.seed()) {
+        throw std::runtime_error("Checkpoint " + path + " is of " + std::to_string(header.vehicleCount) +
+                                 " vehicles with seed " + std::to_string(header.seed));
+    }
+    if (header.generator != rng::DefaultGenerator::kId) {
+        throw std::runtime_error("Checkpoint " + path + " was taken with a different random generator than " +
+                                 rng::DefaultGenerator::kName);
+    }
+    if (header.rulesFingerprint != rules.rules().fingerprint()) {
+        throw std::runtime_error("Checkpoint " + path + " was taken with different diagnostic rules");
+    }
+    fleet.restoreState(reader);
+    rules.restoreState(reader);
+}
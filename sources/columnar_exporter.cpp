@@ -0,0 +1,255 @@
+#include "../headers/columnar_exporter.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <limits>
+#include <stdexcept>
+
+#include "../headers/fleet.hpp"
+#include "../headers/signals.hpp"
+
+namespace {
+// Values per row group when the caller does not pick a size (2 MiB of doubles per column)
+constexpr std::size_t kGroupValues = std::size_t{1} << 18;
+constexpr std::size_t kMaxSnapshotsPerGroup = 1024;
+
+/// Appends the bytes of a value to a buffer.
+template <typename T>
+void append(std::vector<unsigned char>& out, const T* values, std::size_t count) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(values);
+    out.insert(out.end(), bytes, bytes + count * sizeof(T));
+}
+}
+
+/**
+ * @brief Constructor for the ColumnarExporter class; writes the file header and starts the writer thread.
+ *
+ * @param path The file to write (truncated if it exists).
+ * @param vehicleCount Number of vehicles in every snapshot.
+ * @param everyTicks Ticks between snapshots (0 is treated as 1).
+ * @param dt Simulated time per tick, recorded in the header.
+ * @param snapshotsPerGroup Snapshots per row group; 0 picks one from the vehicle count.
+ */
+ColumnarExporter::ColumnarExporter(const std::string& path, std::size_t vehicleCount, std::uint64_t everyTicks,
+                                   std::chrono::nanoseconds dt, std::size_t snapshotsPerGroup)
+    : vehicles(vehicleCount == 0 ? 1 : vehicleCount),
+      every(everyTicks == 0 ? 1 : everyTicks),
+      groupCapacity(snapshotsPerGroup != 0 ? snapshotsPerGroup
+                                           : std::clamp<std::size_t>(kGroupValues / vehicles, 1, kMaxSnapshotsPerGroup)) {
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open columnar file: " + path);
+    }
+
+    ColumnarFileHeader header{};
+    header.magic = kColumnarFileMagic;
+    header.version = kColumnarFormatVersion;
+    header.columnCount = static_cast<std::uint16_t>(kSignalCount);
+    header.vehicleCount = static_cast<std::uint32_t>(vehicles);
+    header.snapshotEvery = static_cast<std::uint32_t>(every);
+    header.dtNs = static_cast<std::uint64_t>(dt.count());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    for (std::size_t c = 0; c < kSignalCount; ++c) {
+        ColumnarColumnInfo column{};
+        std::snprintf(column.name, sizeof(column.name), "%s", signalKey(static_cast<Signal>(c)));
+        column.codec = kColumnarCodecXorBytes;
+        file.write(reinterpret_cast<const char*>(&column), sizeof(column));
+    }
+    progress.bytes = sizeof(header) + kSignalCount * sizeof(ColumnarColumnInfo);
+
+    for (RowGroup& group : buffers) {
+        group.values.resize(kSignalCount * groupCapacity * vehicles);
+        group.ticks.reserve(groupCapacity);
+        group.timestampsNs.reserve(groupCapacity);
+    }
+    encoded.resize(kSignalCount);
+    writer = std::thread([this] { run(); });
+}
+
+/**
+ * @brief Destructor for the ColumnarExporter class; finishes the file.
+ */
+ColumnarExporter::~ColumnarExporter() {
+    close();
+}
+
+/**
+ * @brief Copies a range of fleet vehicles into the current snapshot.
+ *
+ * @param fleet The fleet; must have as many vehicles as the export.
+ * @param begin First vehicle to copy.
+ * @param end One past the last vehicle to copy.
+ */
+void ColumnarExporter::capture(const Fleet& fleet, std::size_t begin, std::size_t end) {
+    for (std::size_t c = 0; c < kSignalCount; ++c) {
+        double* out = slot(c);
+        if (const std::vector<double>* column = fleet.column(static_cast<Signal>(c))) {
+            std::copy(column->begin() + begin, column->begin() + end, out + begin);
+        } else {
+            const std::vector<int>& gear = fleet.columns().gear;
+            for (std::size_t i = begin; i < end; ++i) {
+                out[i] = gear[i];
+            }
+        }
+    }
+}
+
+/**
+ * @brief Copies one vehicle's state into the current snapshot.
+ *
+ * @param vehicle Index of the vehicle.
+ * @param state The vehicle's state.
+ */
+void ColumnarExporter::capture(std::size_t vehicle, const VehicleState& state) {
+    double values[kSignalCount];
+    toSignalValues(state, values);
+    for (std::size_t c = 0; c < kSignalCount; ++c) {
+        slot(c)[vehicle] = values[c];
+    }
+}
+
+/**
+ * @brief Closes the current snapshot, handing the row group to the writer once it is full.
+ *
+ * @param tick The tick the snapshot was taken at.
+ * @param timestampNs The snapshot's simulated time.
+ */
+void ColumnarExporter::commit(std::uint64_t tick, std::uint64_t timestampNs) {
+    filling->ticks.push_back(tick);
+    filling->timestampsNs.push_back(timestampNs);
+    if (filling->ticks.size() == groupCapacity) {
+        handOff();
+    }
+}
+
+/**
+ * @brief Gives the filled row group to the writer and starts filling the other one.
+ *
+ * Waits while the writer still has the other row group.
+ */
+void ColumnarExporter::handOff() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (pending != nullptr) {
+        ++progress.stalls;
+        changed.wait(lock, [this] { return pending == nullptr; });
+    }
+    progress.snapshots += filling->ticks.size();
+    pending = filling;
+    filling = filling == &buffers[0] ? &buffers[1] : &buffers[0];
+    filling->ticks.clear();
+    filling->timestampsNs.clear();
+    changed.notify_all();
+}
+
+/**
+ * @brief Writes the last partial row group and the footer, then closes the file.
+ */
+void ColumnarExporter::close() {
+    if (closed) {
+        return;
+    }
+    closed = true;
+    if (!filling->ticks.empty()) {
+        handOff();
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopRequested = true;
+    }
+    changed.notify_all();
+    writer.join();
+
+    ColumnarFooter footer{};
+    footer.indexOffset = progress.bytes;
+    footer.groupCount = static_cast<std::uint32_t>(index.size());
+    footer.magic = kColumnarFooterMagic;
+    file.write(reinterpret_cast<const char*>(index.data()),
+               static_cast<std::streamsize>(index.size() * sizeof(ColumnarGroupIndex)));
+    file.write(reinterpret_cast<const char*>(&footer), sizeof(footer));
+    file.close();
+    std::lock_guard<std::mutex> lock(mutex);
+    progress.bytes += index.size() * sizeof(ColumnarGroupIndex) + sizeof(footer);
+}
+
+/**
+ * @brief Gets the export's progress.
+ *
+ * @return Snapshots, row groups and bytes written so far, and the commits that waited.
+ */
+ColumnarStats ColumnarExporter::stats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return progress;
+}
+
+/**
+ * @brief Writer thread: writes each handed-off row group until close().
+ */
+void ColumnarExporter::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        changed.wait(lock, [this] { return pending != nullptr || stopRequested; });
+        if (pending == nullptr) {
+            return;
+        }
+        const RowGroup* group = pending;
+        lock.unlock();
+        write(*group);
+        lock.lock();
+        pending = nullptr;
+        changed.notify_all();
+    }
+}
+
+/**
+ * @brief Compresses and writes one row group.
+ *
+ * @param group The row group; only the writer thread touches it until it is written.
+ */
+void ColumnarExporter::write(const RowGroup& group) {
+    const std::size_t snapshots = group.ticks.size();
+    const std::size_t values = snapshots * vehicles;
+    std::vector<ColumnarChunkInfo> chunks(kSignalCount);
+    std::uint64_t offset = sizeof(ColumnarGroupHeader) + columnarGroupMetaBytes(snapshots, kSignalCount);
+    for (std::size_t c = 0; c < kSignalCount; ++c) {
+        const double* column = &group.values[c * groupCapacity * vehicles];
+        encodeXorBytes(column, snapshots, vehicles, encoded[c]);
+        ColumnarChunkInfo& chunk = chunks[c];
+        chunk.offset = offset;
+        chunk.bytes = encoded[c].size();
+        chunk.min = std::numeric_limits<double>::quiet_NaN();
+        chunk.max = std::numeric_limits<double>::quiet_NaN();
+        for (std::size_t i = 0; i < values; ++i) {
+            if (!std::isnan(column[i])) {
+                chunk.min = std::isnan(chunk.min) ? column[i] : std::min(chunk.min, column[i]);
+                chunk.max = std::isnan(chunk.max) ? column[i] : std::max(chunk.max, column[i]);
+            }
+        }
+        chunk.crc32 = crc32(encoded[c].data(), encoded[c].size());
+        offset += chunk.bytes;
+    }
+
+    meta.clear();
+    append(meta, group.ticks.data(), snapshots);
+    append(meta, group.timestampsNs.data(), snapshots);
+    append(meta, chunks.data(), chunks.size());
+
+    ColumnarGroupHeader header{};
+    header.magic = kColumnarGroupMagic;
+    header.snapshotCount = static_cast<std::uint32_t>(snapshots);
+    header.groupBytes = offset;
+    header.firstTick = group.ticks.front();
+    header.metaCrc32 = crc32(meta.data(), meta.size());
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(meta.data()), static_cast<std::streamsize>(meta.size()));
+    for (const std::vector<unsigned char>& chunk : encoded) {
+        file.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+    }
+    file.flush();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    index.push_back(ColumnarGroupIndex{progress.bytes, header.firstTick, header.snapshotCount, 0});
+    progress.bytes += offset;
+    progress.rawBytes += kSignalCount * values * sizeof(double);
+    ++progress.groups;
+}
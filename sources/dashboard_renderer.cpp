@@ -0,0 +1,292 @@
+#include "../headers/dashboard_renderer.hpp"
+#include "../headers/sensor_registry.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+
+#ifdef _WIN32
+#include <io.h>
+#define VT_ISATTY _isatty
+#define VT_WRITE _write
+#else
+#include <unistd.h>
+#define VT_ISATTY isatty
+#define VT_WRITE write
+#endif
+
+namespace {
+// ANSI control sequences
+constexpr char kSaveCursor[] = "\x1b" "7";
+constexpr char kRestoreCursor[] = "\x1b" "8";
+constexpr char kClearScreen[] = "\x1b[2J";
+constexpr char kResetScrollRegion[] = "\x1b[r";
+// Longest cursor move: ESC [ row ; column H with two 20-digit numbers
+constexpr std::size_t kMaxCursorBytes = 48;
+
+template <std::size_t N>
+constexpr std::size_t literalLength(const char (&)[N]) {
+    return N - 1;
+}
+}
+
+/**
+ * @brief Constructor for the DashboardRenderer class.
+ *
+ * Builds the panel layout and allocates the output buffer for the largest possible frame.
+ *
+ * @param panels Number of vehicle panels, stacked vertically.
+ * @param fd File descriptor to write to.
+ * @param ansi 1 to redraw incrementally with ANSI sequences, 0 for plain full frames, -1 to use ANSI on a terminal.
+ */
+DashboardRenderer::DashboardRenderer(std::size_t panels, int fd, int ansi)
+    : panels(panels == 0 ? 1 : panels), fd(fd), ansi(ansi < 0 ? VT_ISATTY(fd) != 0 : ansi != 0),
+      previous(this->panels * FieldCount) {
+    buildLayout();
+
+    std::size_t panelBytes = 0;
+    for (const std::string& row : layout) {
+        panelBytes += row.size() + kMaxCursorBytes + 1;
+    }
+    panelBytes += FieldCount * (kMaxCursorBytes + kValueWidth);
+    buffer.resize(this->panels * panelBytes + 4 * kMaxCursorBytes);
+}
+
+/**
+ * @brief Destructor for the DashboardRenderer class.
+ *
+ * Releases the rows reserved for the panels so later output can use the whole screen.
+ */
+DashboardRenderer::~DashboardRenderer() {
+    if (ansi && screenPrepared) {
+        used = 0;
+        append(kSaveCursor, literalLength(kSaveCursor));
+        append(kResetScrollRegion, literalLength(kResetScrollRegion));
+        flush();
+    }
+}
+
+/**
+ * @brief Formats a vehicle's state into the pending frame.
+ *
+ * With ANSI, only the slots whose text differs from the previous frame are emitted;
+ * an unchanged state adds nothing to the frame.
+ *
+ * @param panel Index of the panel to update.
+ * @param state The state to show.
+ */
+void DashboardRenderer::update(std::size_t panel, const VehicleState& state) {
+    if (panel >= panels) {
+        return;
+    }
+    char values[FieldCount][kValueWidth];
+    formatSlots(state, values);
+
+    if (!ansi) {
+        appendPanel(panel, values);
+        return;
+    }
+
+    const std::size_t top = panel * layout.size();
+    for (std::size_t f = 0; f < FieldCount; ++f) {
+        SlotText& last = previous[panel * FieldCount + f];
+        if (last.drawn && std::memcmp(last.text, values[f], kValueWidth) == 0) {
+            continue;
+        }
+        beginFrame();
+        appendCursor(top + slots[f].row, slots[f].column);
+        append(values[f], kValueWidth);
+        std::memcpy(last.text, values[f], kValueWidth);
+        last.drawn = true;
+    }
+}
+
+/**
+ * @brief Writes the pending frame to the file descriptor with a single write() call.
+ *
+ * @return The number of bytes written.
+ */
+std::size_t DashboardRenderer::flush() {
+    if (used == 0) {
+        return 0;
+    }
+    if (ansi) {
+        append(kRestoreCursor, literalLength(kRestoreCursor));
+    }
+
+    std::size_t written = 0;
+    while (written < used) {
+        const auto result = VT_WRITE(fd, buffer.data() + written, static_cast<unsigned>(used - written));
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        written += static_cast<std::size_t>(result);
+    }
+    used = 0;
+    return written;
+}
+
+/**
+ * @brief Builds the static text of a panel and records where each value slot starts.
+ *
+ * The sensor rows are generated from VehicleSensors, one row per sensor with its
+ * fields side by side; the ECU rows follow.
+ */
+void DashboardRenderer::buildLayout() {
+    const std::string blank(kValueWidth, ' ');
+    auto addRow = [&](const std::string& text) { layout.push_back(text); };
+    auto addSlot = [&](Signal signal, const char* prefix, const char* suffix) {
+        std::string& row = layout.back();
+        row += prefix;
+        slots[static_cast<std::size_t>(signal)] = Slot{layout.size() - 1, row.size()};
+        row += blank;
+        row += suffix;
+    };
+
+    addRow("======= Vehicle Dashboard =======");
+    VehicleSensors::forEachField([&](const auto& field, bool firstOfSensor) {
+        if (firstOfSensor) {
+            addRow("");
+        }
+        addSlot(field.signal, field.label, field.unit);
+    });
+    addRow("");
+    addSlot(Signal::Throttle, "Throttle Position: ", "%");
+    addRow("");
+    addSlot(Signal::BrakePressure, "Brake Pressure: ", "%");
+    addRow("");
+    addSlot(Signal::Gear, "Current Gear: ", "");
+    addRow("=================================");
+}
+
+/**
+ * @brief Starts a frame: prepares the screen on first use and saves the cursor.
+ */
+void DashboardRenderer::beginFrame() {
+    if (used != 0) {
+        return;
+    }
+    if (!screenPrepared) {
+        append(kClearScreen, literalLength(kClearScreen));
+        for (std::size_t panel = 0; panel < panels; ++panel) {
+            for (std::size_t row = 0; row < layout.size(); ++row) {
+                appendCursor(panel * layout.size() + row, 0);
+                appendRow(panel, row);
+            }
+        }
+
+        // Keep the panels fixed at the top; everything else scrolls below them
+        const std::size_t firstFreeRow = panels * layout.size() + 1;
+        char command[kMaxCursorBytes];
+        char* end = command;
+        *end++ = '\x1b';
+        *end++ = '[';
+        end = std::to_chars(end, command + sizeof(command) - 1, firstFreeRow).ptr;
+        *end++ = 'r';
+        append(command, static_cast<std::size_t>(end - command));
+        appendCursor(firstFreeRow - 1, 0);
+        screenPrepared = true;
+    }
+    append(kSaveCursor, literalLength(kSaveCursor));
+}
+
+/**
+ * @brief Formats every field of a state into its fixed-width, right-aligned slot text.
+ *
+ * @param state The state to format.
+ * @param out Receives one slot of text per field.
+ */
+void DashboardRenderer::formatSlots(const VehicleState& state, char (&out)[FieldCount][kValueWidth]) const {
+    const double values[FieldCount] = {state.speed, state.fuelLevel, state.engineTemperature, state.batteryCharge,
+                                       state.batteryTemperature, state.radarDistance, state.throttle,
+                                       state.brakePressure, 0.0};
+    for (std::size_t f = 0; f < FieldCount; ++f) {
+        char text[32];
+        const std::to_chars_result result = f == static_cast<std::size_t>(Signal::Gear)
+            ? std::to_chars(text, text + sizeof(text), state.gear)
+            : std::to_chars(text, text + sizeof(text), values[f], std::chars_format::fixed, 2);
+        const std::size_t length = static_cast<std::size_t>(result.ptr - text);
+        if (result.ec != std::errc() || length > kValueWidth) {
+            std::memset(out[f], '#', kValueWidth);
+            continue;
+        }
+        std::memset(out[f], ' ', kValueWidth - length);
+        std::memcpy(out[f] + kValueWidth - length, text, length);
+    }
+}
+
+/**
+ * @brief Appends a whole panel as plain text, for output that is not a terminal.
+ *
+ * @param panel Index of the panel, used in the title of multi-panel dashboards.
+ * @param values The formatted slot text.
+ */
+void DashboardRenderer::appendPanel(std::size_t panel, const char (&values)[FieldCount][kValueWidth]) {
+    for (std::size_t row = 0; row < layout.size(); ++row) {
+        const std::size_t start = used;
+        appendRow(panel, row);
+        for (std::size_t f = 0; f < FieldCount; ++f) {
+            if (slots[f].row == row) {
+                std::memcpy(buffer.data() + start + slots[f].column, values[f], kValueWidth);
+            }
+        }
+        append("\n", 1);
+    }
+}
+
+/**
+ * @brief Appends the static text of one panel row; multi-panel titles carry the panel number.
+ *
+ * @param panel Index of the panel.
+ * @param row Row within the panel.
+ */
+void DashboardRenderer::appendRow(std::size_t panel, std::size_t row) {
+    if (row != 0 || panels == 1) {
+        append(layout[row].data(), layout[row].size());
+        return;
+    }
+    static constexpr char kTitlePrefix[] = "======= Vehicle ";
+    static constexpr char kTitleSuffix[] = " =======";
+    char number[24];
+    const char* end = std::to_chars(number, number + sizeof(number), panel).ptr;
+    append(kTitlePrefix, literalLength(kTitlePrefix));
+    append(number, static_cast<std::size_t>(end - number));
+    append(kTitleSuffix, literalLength(kTitleSuffix));
+}
+
+/**
+ * @brief Appends an ANSI cursor move to the frame.
+ *
+ * @param row 0-based screen row.
+ * @param column 0-based screen column.
+ */
+void DashboardRenderer::appendCursor(std::size_t row, std::size_t column) {
+    char command[kMaxCursorBytes];
+    char* end = command;
+    *end++ = '\x1b';
+    *end++ = '[';
+    end = std::to_chars(end, command + sizeof(command) - 1, row + 1).ptr;
+    *end++ = ';';
+    end = std::to_chars(end, command + sizeof(command) - 1, column + 1).ptr;
+    *end++ = 'H';
+    append(command, static_cast<std::size_t>(end - command));
+}
+
+/**
+ * @brief Appends bytes to the frame buffer.
+ *
+ * The buffer is sized for the largest frame at construction, so this does not allocate in practice.
+ *
+ * @param text The bytes to append.
+ * @param length Number of bytes.
+ */
+void DashboardRenderer::append(const char* text, std::size_t length) {
+    if (used + length > buffer.size()) {
+        buffer.resize((used + length) * 2);
+    }
+    std::memcpy(buffer.data() + used, text, length);
+    used += length;
+}
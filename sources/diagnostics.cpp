@@ -3,53 +3,100 @@
 /**
  * @brief Constructor for the VehicleDiagnostics class.
  * 
- * This constructor initializes the diagnostic system by passing in shared pointers 
- * to various sensors and a reference to the logger.
+ * This constructor initializes the diagnostic system by subscribing it to the 
+ * vehicle's signal bus and passing in a reference to the logger.
  * 
- * @param speedSensor Shared pointer to the speed sensor.
- * @param fuelSensor Shared pointer to the fuel sensor.
- * @param tempSensor Shared pointer to the temperature sensor.
- * @param battery Shared pointer to the battery.
- * @param radarSensor Shared pointer to the radar sensor.
+ * @param bus The signal bus the sensors and ECUs publish to.
  * @param logger Reference to the logger for logging diagnostic messages.
+ * @param vehicleId Identifier of the owning vehicle, used in binary telemetry records.
  */
-VehicleDiagnostics::VehicleDiagnostics(const std::shared_ptr<SpeedSensor>& speedSensor,
-                    const std::shared_ptr<FuelSensor>& fuelSensor,
-                    const std::shared_ptr<TemperatureSensor>& tempSensor,
-                    const std::shared_ptr<Battery>& battery,
-                    const std::shared_ptr<RadarSensor>& radarSensor,
-                    Logger& logger)
-    : speedSensor(speedSensor), fuelSensor(fuelSensor), tempSensor(tempSensor),
-        battery(battery), radarSensor(radarSensor), logger(logger) {}
+VehicleDiagnostics::VehicleDiagnostics(const SignalBus& bus, Logger& logger, std::uint32_t vehicleId)
+    : bus(bus), logger(logger), vehicleId(vehicleId) {
+    subscribeAggregatedSignals();
+}
 
 /**
  * @brief Runs diagnostic checks on all vehicle components.
  * 
- * This function checks the state of all sensors and logs the values along with any warnings
- * for values outside of normal ranges. The results are logged using the logger and displayed on the console.
+ * This function evaluates the diagnostic rules against the latest value of every signal on the bus.
+ * Rules on windowed aggregates first receive every sample of their signal published since the
+ * previous run, drained from the bus history, so their windows advance at the signal's own rate.
+ * Only state transitions are reported: a rule that is raised or cleared is logged,
+ * displayed on the console (unless console output is disabled) and written to the
+ * binary telemetry log; readings that leave every rule unchanged produce no output.
  */
 void VehicleDiagnostics::runDiagnostics() {
-    logger.Log("\n\nRunning diagnostics.");
-    std::cout << "\n--- Diagnostics Report ---" << std::endl;
-
-    auto checkAndLog = [this](const std::string& sensorName, double value, double threshold, const std::string& warningMessage) {
-        std::ostringstream logMessage;
-        logMessage << sensorName << " read: " << std::fixed << std::setprecision(2) << value;
-        logger.Log(logMessage.str());
-
-        if ((sensorName == "Speed" && value > threshold) || 
-            (sensorName != "Speed" && value < threshold)) {
-            logger.Log("Warning: " + warningMessage);
-            std::cout << "Warning: " << warningMessage << std::endl;
+    for (std::pair<Signal, SignalSubscription>& subscription : subscriptions) {
+        const Signal signal = subscription.first;
+        subscription.second.drain([&](const SignalSample& sample) {
+            engine.observe(0, signal, sample.timestampNs, sample.value);
+        });
+    }
+
+    double values[kSignalCount];
+    for (std::size_t s = 0; s < kSignalCount; ++s) {
+        values[s] = bus.latestValue(static_cast<Signal>(s));
+    }
+
+    events.clear();
+    engine.evaluate(0, values, events);
+    for (const RuleEvent& event : events) {
+        report(event);
+    }
+}
+
+/**
+ * @brief Replaces the diagnostic rules.
+ *
+ * @param rules The new rules; every rule starts cleared.
+ */
+void VehicleDiagnostics::setRules(RuleSet rules) {
+    engine = RuleEngine(std::move(rules), 1);
+    subscribeAggregatedSignals();
+}
+
+/**
+ * @brief Replaces the subscriptions with one per signal the current rules aggregate.
+ */
+void VehicleDiagnostics::subscribeAggregatedSignals() {
+    subscriptions.clear();
+    for (std::size_t s = 0; s < kSignalCount; ++s) {
+        const Signal signal = static_cast<Signal>(s);
+        if (engine.rules().aggregates(signal)) {
+            subscriptions.emplace_back(signal, SignalSubscription(bus, signal));
         }
-    };
+    }
+}
 
-    checkAndLog("Speed", speedSensor->readData(), 120, "High speed detected!");
-    checkAndLog("Fuel", fuelSensor->readData(), 5, "Low fuel level!");
-    checkAndLog("Temperature", tempSensor->readData(), 90, "Engine overheating!");
-    checkAndLog("Battery Charge", battery->readCharge(), 20, "Low battery charge!");
-    checkAndLog("Battery Temperature", battery->readTemperature(), 40, "Battery overheating!");
-    checkAndLog("Radar Distance", radarSensor->readData(), 20, "Vehicle ahead too close!");
+/**
+ * @brief Logs, displays and records one rule transition; raised warnings and errors are counted.
+ *
+ * @param event The rule that was raised or cleared.
+ */
+void VehicleDiagnostics::report(const RuleEvent& event) {
+    const RuleSpec& spec = engine.rules().spec(event.rule);
 
-    std::cout << "--- End of Diagnostics ---\n" << std::endl;
+    const char* status = !event.raised ? "Cleared"
+                       : spec.severity == Severity::Critical ? "Critical"
+                       : spec.severity == Severity::Info ? "Info"
+                       : "Warning";
+    const LogLevel level = !event.raised ? LogLevel::Info
+                         : spec.severity == Severity::Critical ? LogLevel::Error
+                         : spec.severity == Severity::Info ? LogLevel::Info
+                         : LogLevel::Warning;
+    const std::string input = ruleInputName(spec);
+    if (level >= LogLevel::Warning) {
+        VT_COUNT(WarningsRaised, 1);
+    }
+
+    logger.Log(level, LogCategory::Diagnostics, VT_FMT("{}: {} ({} read: {:.2f})"), status, spec.message, input,
+               event.value);
+    if (consoleOutput) {
+        consoleLine.clear();
+        log_format::formatTo(consoleLine, VT_FMT("{}: {} ({} read: {:.2f})\n"), status, spec.message, input,
+                             event.value);
+        std::cout << consoleLine << std::flush;
+    }
+    TelemetryLog::GetInstance().RecordDiagnostic(vehicleId, spec.signal, event.value, spec.limit, event.raised);
 }
+
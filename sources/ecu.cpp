@@ -11,7 +11,7 @@ EngineControlUnit::EngineControlUnit() : throttlePosition(0.0) {}
  * @param position The new throttle position (clamped between 0.0 and 100.0).
  */
 void EngineControlUnit::setThrottlePosition(double position) {
-    throttlePosition = clamp(position, 0.0, 100.0);
+    throttlePosition = clamp(position, vehicle_model::kActuatorMin, vehicle_model::kActuatorMax);
 }
 
 /**
@@ -33,7 +33,7 @@ BrakeControlUnit::BrakeControlUnit() : brakePressure(0.0) {}
  * @param pressure The new brake pressure (clamped between 0.0 and 100.0).
  */
 void BrakeControlUnit::setBrakePressure(double pressure) {
-    brakePressure = clamp(pressure, 0.0, 100.0);
+    brakePressure = clamp(pressure, vehicle_model::kActuatorMin, vehicle_model::kActuatorMax);
 }
 
 /**
@@ -48,14 +48,14 @@ double BrakeControlUnit::getBrakePressure() const {
  * @brief Constructor for the TransmissionControlUnit class
  * @details Initializes gear to 1.
  */
-TransmissionControlUnit::TransmissionControlUnit() : gear(1) {}
+TransmissionControlUnit::TransmissionControlUnit() : gear(vehicle_model::kGearMin) {}
 
 /**
  * @brief Changes the current gear.
  * @param newGear The new gear (clamped between 1 and 6).
  */
 void TransmissionControlUnit::changeGear(int newGear) {
-    gear = clamp(newGear, 1, 6);
+    gear = clamp(newGear, vehicle_model::kGearMin, vehicle_model::kGearMax);
 }
 
 /**
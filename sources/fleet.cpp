@@ -0,0 +1,326 @@
+#include "../headers/fleet.hpp"
+#include "../headers/checkpoint.hpp"
+#include "../headers/simd_kernels.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+/**
+ * @brief Maps a signal to its column, for const and mutable FleetColumns alike.
+ *
+ * @param data The fleet's columns.
+ * @param signal The signal to look up.
+ * @return The column, or nullptr for signals not stored as doubles.
+ */
+template<typename Columns>
+auto signalColumn(Columns& data, Signal signal) -> decltype(&data.speed) {
+    switch (signal) {
+        case Signal::Speed: return &data.speed;
+        case Signal::FuelLevel: return &data.fuelLevel;
+        case Signal::EngineTemperature: return &data.engineTemperature;
+        case Signal::BatteryCharge: return &data.batteryCharge;
+        case Signal::BatteryTemperature: return &data.batteryTemperature;
+        case Signal::RadarDistance: return &data.radarDistance;
+        case Signal::Throttle: return &data.throttle;
+        case Signal::BrakePressure: return &data.brakePressure;
+        default: return nullptr;
+    }
+}
+
+}  // namespace
+
+/**
+ * @brief Constructor for the Fleet class.
+ *
+ * Allocates one contiguous array per field and initializes every vehicle to the
+ * same state a freshly constructed Vehicle starts in.
+ *
+ * @param vehicleCount Number of vehicles to simulate.
+ * @param seed Seed for the fleet's counter-based random streams. Vehicle i of a fleet follows
+ *             the same trajectory as a Vehicle constructed with vehicle id i and this seed.
+ */
+Fleet::Fleet(std::size_t vehicleCount, std::uint64_t seed) : count(vehicleCount), rngSeed(seed) {
+    data.speed.assign(count, vehicle_model::kSpeedMin);
+    data.fuelLevel.assign(count, vehicle_model::kFuelInitial);
+    data.engineTemperature.assign(count, vehicle_model::kEngineTempInitial);
+    data.batteryCharge.assign(count, vehicle_model::kBatteryChargeInitial);
+    data.batteryTemperature.assign(count, vehicle_model::kBatteryTempInitial);
+    data.radarDistance.assign(count, vehicle_model::kRadarInitial);
+    data.throttle.assign(count, 0.0);
+    data.brakePressure.assign(count, 0.0);
+    data.gear.assign(count, vehicle_model::kGearMin);
+    data.warnings.assign(count, 0);
+}
+
+/**
+ * @brief Updates the sensors of a range of vehicles with the draws of one tick.
+ *
+ * Applies the same models as SpeedSensor, FuelSensor, TemperatureSensor, Battery and
+ * RadarSensor, one field at a time so each kernel walks contiguous memory. Random
+ * draws of rng::DefaultGenerator for the tick are generated into a block buffer first
+ * (several Philox blocks per instruction) and then consumed by the SIMD kernels. Draws depend only on
+ * (seed, vehicle, channel, tick), so any ranges can be updated concurrently.
+ * Engine temperature is computed after speed, as in Vehicle::updateSensors.
+ *
+ * @param begin Index of the first vehicle.
+ * @param end One past the index of the last vehicle.
+ * @param tick The tick whose draws to use; the fleet's own updates use tickIndex().
+ */
+void Fleet::updateSensors(std::size_t begin, std::size_t end, std::uint64_t tick) {
+    using namespace vehicle_model;
+    double unit[kKernelBlock];
+
+    auto fillUniform = [this, tick](RandomChannel channel, std::size_t first, double* out, std::size_t n) {
+        simd::uniform<rng::DefaultGenerator>(rngSeed, channel, tick, static_cast<std::uint32_t>(first), out, n);
+    };
+
+    for (std::size_t first = begin; first < end;) {
+        const std::size_t last = std::min(end, first + kKernelBlock);
+        const std::size_t n = last - first;
+
+        fillUniform(RandomChannel::Speed, first, unit, n);
+        simd::scaleUniform(&data.speed[first], unit, kSpeedMin, kSpeedMax, n);
+
+        fillUniform(RandomChannel::FuelUse, first, unit, n);
+        simd::drainUniform(&data.fuelLevel[first], unit, kFuelUseMin, kFuelUseMax, n);
+
+        fillUniform(RandomChannel::EngineTemperatureNoise, first, unit, n);
+        simd::engineTemperature(&data.engineTemperature[first], &data.speed[first], unit, n);
+
+        fillUniform(RandomChannel::BatteryUse, first, unit, n);
+        simd::drainUniform(&data.batteryCharge[first], unit, kBatteryUseMin, kBatteryUseMax, n);
+
+        fillUniform(RandomChannel::BatteryTemperatureStep, first, unit, n);
+        simd::addUniform(&data.batteryTemperature[first], unit, -kBatteryTempStep, kBatteryTempStep, n);
+
+        fillUniform(RandomChannel::RadarDistance, first, unit, n);
+        simd::scaleUniform(&data.radarDistance[first], unit, kRadarMin, kRadarMax, n);
+
+        first = last;
+    }
+}
+
+/**
+ * @brief Selects the adaptive cruise control policy the fleet runs.
+ *
+ * @param kind The controller.
+ * @param dtSeconds Time between control steps, for the stateful controllers; must be positive.
+ */
+void Fleet::setAccController(acc::ControllerKind kind, double dtSeconds) {
+    accKind = kind;
+    accDtSeconds = dtSeconds;
+    pidStates.assign(kind == acc::ControllerKind::TimeGapPid ? count : 0, acc::TimeGapPid<>::State());
+    cthStates.assign(kind == acc::ControllerKind::ConstantTimeHeadway ? count : 0,
+                     acc::ConstantTimeHeadway<>::State());
+}
+
+/**
+ * @brief Runs adaptive cruise control for a range of vehicles.
+ *
+ * The band rule runs on the SIMD band kernel; the PID and constant-time-headway
+ * controllers run their vectorized acc::runBatch() loops over the radar and speed
+ * columns with one state per vehicle. The commands then go through the ECU's actuator
+ * clamp on the SIMD clamp kernel.
+ *
+ * @param begin Index of the first vehicle.
+ * @param end One past the index of the last vehicle.
+ */
+void Fleet::adaptiveCruiseControl(std::size_t begin, std::size_t end) {
+    if (begin >= end) {
+        return;
+    }
+    const std::size_t n = end - begin;
+    switch (accKind) {
+        case acc::ControllerKind::Band:
+            simd::accBand(&data.radarDistance[begin], &data.throttle[begin], &data.brakePressure[begin], n);
+            break;
+        case acc::ControllerKind::TimeGapPid:
+            acc::runBatch<acc::TimeGapPid<>>(&data.radarDistance[begin], &data.speed[begin], accDtSeconds,
+                                             &pidStates[begin], &data.throttle[begin], &data.brakePressure[begin], n);
+            break;
+        case acc::ControllerKind::ConstantTimeHeadway:
+            acc::runBatch<acc::ConstantTimeHeadway<>>(&data.radarDistance[begin], &data.speed[begin], accDtSeconds,
+                                                      &cthStates[begin], &data.throttle[begin],
+                                                      &data.brakePressure[begin], n);
+            break;
+    }
+    // The ECU clamps whatever it is commanded, as EngineControlUnit's setters do for a Vehicle
+    simd::clamp(&data.throttle[begin], vehicle_model::kActuatorMin, vehicle_model::kActuatorMax, n);
+    simd::clamp(&data.brakePressure[begin], vehicle_model::kActuatorMin, vehicle_model::kActuatorMax, n);
+}
+
+/**
+ * @brief Evaluates the diagnostic thresholds for a range of vehicles.
+ *
+ * Stores one warning bit per entry of vehicle_model::kDiagnosticChecks in the warnings column,
+ * using one vectorized threshold pass per check.
+ *
+ * @param begin Index of the first vehicle.
+ * @param end One past the index of the last vehicle.
+ */
+void Fleet::runDiagnostics(std::size_t begin, std::size_t end) {
+    using namespace vehicle_model;
+    if (begin >= end) {
+        return;
+    }
+    const std::size_t n = end - begin;
+    std::uint32_t* masks = &data.warnings[begin];
+    std::fill(masks, masks + n, 0u);
+    for (std::size_t c = 0; c < kDiagnosticCheckCount; ++c) {
+        const DiagnosticCheck& check = kDiagnosticChecks[c];
+        const std::vector<double>* values = column(check.signal);
+        if (values != nullptr) {
+            simd::thresholdMask(&(*values)[begin], check.threshold, check.warnAbove, 1u << c, masks, n);
+        }
+    }
+}
+
+/**
+ * @brief Gets the column holding a signal.
+ *
+ * @param signal The signal to look up.
+ * @return The column, or nullptr for signals not stored as doubles.
+ */
+const std::vector<double>* Fleet::column(Signal signal) const {
+    return signalColumn(data, signal);
+}
+
+/**
+ * @brief Mutable column holding a signal, used to restore a checkpoint.
+ *
+ * @param signal The signal to look up.
+ * @return The column, or nullptr for signals not stored as doubles.
+ */
+std::vector<double>* Fleet::column(Signal signal) {
+    return signalColumn(data, signal);
+}
+
+/**
+ * @brief Writes every column to a checkpoint.
+ *
+ * @param writer The checkpoint being written; its header holds the seed and tick.
+ */
+void Fleet::saveState(CheckpointWriter& writer) const {
+    for (std::size_t s = 0; s < kSignalCount; ++s) {
+        if (const std::vector<double>* values = column(static_cast<Signal>(s))) {
+            writer.write(signalKey(static_cast<Signal>(s)), *values);
+        }
+    }
+    writer.write(signalKey(Signal::Gear), data.gear);
+    writer.write("warnings", data.warnings);
+    const std::uint8_t controller = static_cast<std::uint8_t>(accKind);
+    writer.write("acc.controller", &controller, 1);
+    writer.write("acc.pid", pidStates);
+    writer.write("acc.cth", cthStates);
+}
+
+/**
+ * @brief Reads back the columns written by saveState() and moves on to the checkpoint's tick.
+ *
+ * @param reader The checkpoint being read; must be of a fleet of this size and seed.
+ */
+void Fleet::restoreState(CheckpointReader& reader) {
+    for (std::size_t s = 0; s < kSignalCount; ++s) {
+        if (std::vector<double>* values = column(static_cast<Signal>(s))) {
+            reader.read(signalKey(static_cast<Signal>(s)), *values);
+        }
+    }
+    reader.read(signalKey(Signal::Gear), data.gear);
+    reader.read("warnings", data.warnings);
+    std::uint8_t controller = 0;
+    reader.read("acc.controller", &controller, 1);
+    if (controller != static_cast<std::uint8_t>(accKind)) {
+        throw std::runtime_error(std::string("Checkpoint was taken with the ") +
+                                 acc::controllerName(static_cast<acc::ControllerKind>(controller)) +
+                                 " ACC controller, not " + acc::controllerName(accKind));
+    }
+    reader.read("acc.pid", pidStates);
+    reader.read("acc.cth", cthStates);
+    currentTick = reader.header().tick;
+}
+
+/**
+ * @brief Advances every vehicle by one tick: sensors, then ACC, then diagnostics.
+ */
+void Fleet::tick() {
+    updateSensors(0, count);
+    adaptiveCruiseControl(0, count);
+    runDiagnostics(0, count);
+    advanceTick();
+}
+
+/**
+ * @brief Gathers the fields of one vehicle into a VehicleState.
+ *
+ * @param index Index of the vehicle.
+ * @return The vehicle's current state.
+ */
+VehicleState Fleet::state(std::size_t index) const {
+    return VehicleState{data.speed[index], data.fuelLevel[index], data.engineTemperature[index],
+                        data.batteryCharge[index], data.batteryTemperature[index], data.radarDistance[index],
+                        data.throttle[index], data.brakePressure[index], data.gear[index]};
+}
+
+/**
+ * @brief Returns a Vehicle-like view of one vehicle of the fleet.
+ *
+ * @param index Index of the vehicle.
+ * @return An adapter referring to this fleet; it must not outlive it.
+ */
+FleetVehicle Fleet::vehicle(std::size_t index) {
+    return FleetVehicle(*this, index);
+}
+
+/**
+ * @brief Constructor for the FleetVehicle adapter.
+ *
+ * @param fleet The fleet holding the vehicle's state.
+ * @param index Index of the vehicle within the fleet; it is stepped from the fleet's current tick on.
+ */
+FleetVehicle::FleetVehicle(Fleet& fleet, std::size_t index)
+    : fleet(fleet), vehicleIndex(index), tick(fleet.tickIndex()) {}
+
+/// Updates the sensors of this vehicle only, with the draws of the adapter's tick, and advances it.
+void FleetVehicle::updateSensors() {
+    fleet.updateSensors(vehicleIndex, vehicleIndex + 1, tick++);
+}
+
+/// Runs adaptive cruise control for this vehicle only.
+void FleetVehicle::adaptiveCruiseControl() {
+    fleet.adaptiveCruiseControl(vehicleIndex, vehicleIndex + 1);
+}
+
+/// Prints this vehicle's dashboard to the console, leaving the flush to the stream.
+void FleetVehicle::displayDashboard() {
+    std::cout << "\n======= Vehicle Dashboard =======\n"
+              << fleet.state(vehicleIndex) << '\n'
+              << "=================================\n\n";
+}
+
+/// Runs diagnostics for this vehicle and prints any warnings to the console.
+void FleetVehicle::runDiagnostics() {
+    fleet.runDiagnostics(vehicleIndex, vehicleIndex + 1);
+
+    std::cout << "\n--- Diagnostics Report ---\n";
+    std::uint32_t mask = warnings();
+    for (std::size_t c = 0; c < vehicle_model::kDiagnosticCheckCount; ++c) {
+        if (mask & (1u << c)) {
+            std::cout << "Warning: " << vehicle_model::kDiagnosticChecks[c].warningMessage << '\n';
+        }
+    }
+    std::cout << "--- End of Diagnostics ---\n\n";
+}
+
+/// @return The current state of this vehicle.
+VehicleState FleetVehicle::state() const {
+    return fleet.state(vehicleIndex);
+}
+
+/// @return The warning bitmask from the last diagnostics pass over this vehicle.
+std::uint32_t FleetVehicle::warnings() const {
+    return fleet.columns().warnings[vehicleIndex];
+}
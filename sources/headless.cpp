@@ -0,0 +1,395 @@
+#include "../headers/headless.hpp"
+
+#include <iomanip>
+#include <memory>
+#include <stdexcept>
+
+#include "../headers/checkpoint.hpp"
+#include "../headers/columnar_exporter.hpp"
+#include "../headers/fleet.hpp"
+#include "../headers/logger.hpp"
+#include "../headers/metrics_exporter.hpp"
+#include "../headers/rule_engine.hpp"
+#include "../headers/scheduler.hpp"
+#include "../headers/sensor_recording.hpp"
+#include "../headers/shm_publisher.hpp"
+#include "../headers/telemetry_log.hpp"
+#include "../headers/tick_engine.hpp"
+#include "../headers/vehicle.hpp"
+
+namespace {
+using WallClock = std::chrono::steady_clock;
+
+double secondsBetween(WallClock::time_point from, WallClock::time_point to) {
+    return std::chrono::duration<double>(to - from).count();
+}
+
+std::uint64_t nanosecondsBetween(WallClock::time_point from, WallClock::time_point to) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+/// Runs one Vehicle on its multi-rate schedule in virtual time.
+void runVehicle(const HeadlessConfig& config, RuleSet rules, HeadlessReport& report) {
+    Vehicle vehicle(config.logPath, 0, config.seed);
+    vehicle.setConsoleOutput(false);
+    vehicle.setDiagnosticRules(std::move(rules));
+
+    std::unique_ptr<SensorReplay> replay;
+    if (!config.replayPath.empty()) {
+        replay = std::make_unique<SensorReplay>(config.replayPath);
+        vehicle.setReplay(replay.get());
+    }
+
+    TaskScheduler scheduler;
+    vehicle.scheduleTasks(scheduler, false);
+
+    std::uint64_t virtualNs = 0;
+    std::unique_ptr<SignalHistory> history;
+    if (config.historySeconds > 0.0) {
+        history = std::make_unique<SignalHistory>(1, historyConfig(config));
+        scheduler.addTask("history", kRecordingPeriod, [&] {
+            double values[kSignalCount];
+            toSignalValues(vehicle.state(), values);
+            history->appendAll(0, virtualNs, values);
+        });
+    }
+
+    std::unique_ptr<SensorRecorder> recorder;
+    if (!config.recordPath.empty()) {
+        recorder = std::make_unique<SensorRecorder>(config.recordPath, vehicle.signalBus(), kRecordingPeriod,
+                                                    config.seed);
+        scheduler.addTask("record", kRecordingPeriod, [&] { recorder->record(); });
+    }
+
+    std::unique_ptr<ShmPublisher> shm;
+    if (!config.shmName.empty()) {
+        shm = std::make_unique<ShmPublisher>(config.shmName, 1, vehicle.diagnosticRules().rules());
+        scheduler.addTask("snapshot", std::chrono::milliseconds(20), [&] {
+            shm->publish(0, 0, virtualNs, vehicle.state(), vehicle.diagnosticRules());
+        });
+    }
+
+    std::unique_ptr<MetricsExporter> metrics;
+    if (!config.metricsEndpoint.empty()) {
+        metrics = std::make_unique<MetricsExporter>(config.metricsEndpoint, vehicle.diagnosticRules().rules(), 1);
+        scheduler.addTask("metrics", std::chrono::milliseconds(100), [&] {
+            metrics->countActive(vehicle.diagnosticRules());
+        });
+    }
+
+    std::unique_ptr<ColumnarExporter> columnar;
+    if (!config.columnarPath.empty()) {
+        columnar = std::make_unique<ColumnarExporter>(config.columnarPath, 1, config.columnarEvery, config.dt);
+    }
+
+    TelemetryLog& telemetry = TelemetryLog::GetInstance();
+    const WallClock::time_point start = WallClock::now();
+    std::uint64_t tick = 0;
+    for (; tick < config.ticks && !(replay && replay->finished()); ++tick) {
+        const std::chrono::nanoseconds now = config.dt * static_cast<std::int64_t>(tick);
+        virtualNs = static_cast<std::uint64_t>(now.count());
+        telemetry.SetVirtualTimeNs(virtualNs);
+        vehicle.setVirtualTimeNs(virtualNs);
+        VT_PROBE(Tick);
+        scheduler.advanceTo(now);
+        if (columnar && columnar->due(tick)) {
+            columnar->capture(0, vehicle.state());
+            columnar->commit(tick, virtualNs);
+        }
+        if (metrics) {
+            metrics->setTicks(tick + 1);
+        }
+    }
+    report.wallSeconds = secondsBetween(start, WallClock::now());
+    // A replay ends with its recording
+    report.config.ticks = tick;
+    if (recorder) {
+        recorder->close();
+    }
+    if (columnar) {
+        columnar->close();
+        report.columnar = columnar->stats();
+    }
+    if (history) {
+        report.historySamples = history->sampleCount();
+        report.historyBytes = history->memoryBytes();
+    }
+
+    for (TaskScheduler::TaskId id = 0; id < scheduler.taskCount(); ++id) {
+        const TaskStats& stats = scheduler.stats(id);
+        report.stages.push_back(StageReport{scheduler.taskName(id), stats.runs,
+                                            static_cast<std::uint64_t>(stats.totalDurationNs)});
+    }
+}
+
+/// Runs a Fleet through all stages once per tick on the TickEngine, evaluating the
+/// diagnostic rules over each chunk after its diagnostics stage.
+void runFleet(const HeadlessConfig& config, RuleSet rules, HeadlessReport& report) {
+    Fleet fleet(config.vehicles, config.seed);
+    fleet.setAccController(config.acc, std::chrono::duration<double>(config.dt).count());
+    TickEngineConfig engineConfig;
+    engineConfig.threads = config.threads;
+    TickEngine engine(fleet, engineConfig);
+
+    RuleEngine ruleEngine(std::move(rules), fleet.size());
+    if (!config.restorePath.empty()) {
+        const WallClock::time_point restoreStart = WallClock::now();
+        restoreFleetCheckpoint(config.restorePath, fleet, ruleEngine);
+        report.restoreSeconds = secondsBetween(restoreStart, WallClock::now());
+    }
+    report.firstTick = fleet.tickIndex();
+    auto checkpoint = [&] {
+        const WallClock::time_point checkpointStart = WallClock::now();
+        report.checkpointBytes = saveFleetCheckpoint(config.checkpointPath, fleet, ruleEngine, config.dt);
+        report.checkpointSeconds += secondsBetween(checkpointStart, WallClock::now());
+        ++report.checkpoints;
+    };
+
+    std::unique_ptr<ShmPublisher> shm;
+    if (!config.shmName.empty()) {
+        shm = std::make_unique<ShmPublisher>(config.shmName, fleet.size(), ruleEngine.rules());
+    }
+    std::unique_ptr<SignalHistory> history;
+    if (config.historySeconds > 0.0) {
+        history = std::make_unique<SignalHistory>(fleet.size(), historyConfig(config));
+    }
+    std::unique_ptr<MetricsExporter> metrics;
+    if (!config.metricsEndpoint.empty()) {
+        metrics = std::make_unique<MetricsExporter>(config.metricsEndpoint, ruleEngine.rules(), fleet.size());
+        if (!config.restorePath.empty()) {
+            // Transitions only move the counts, so start from the restored rule states
+            metrics->countActive(ruleEngine);
+            metrics->setTicks(report.firstTick);
+        }
+    }
+    std::unique_ptr<ColumnarExporter> columnar;
+    if (!config.columnarPath.empty()) {
+        columnar = std::make_unique<ColumnarExporter>(config.columnarPath, fleet.size(), config.columnarEvery,
+                                                      config.dt);
+    }
+    std::vector<std::vector<RuleEvent>> chunkEvents(engine.chunkCount());
+    std::vector<std::uint64_t> chunkTransitions(engine.chunkCount());
+    // Rule evaluation and the exports after it are timed apart, as the rules and export stages
+    std::vector<std::uint64_t> chunkRulesNs(engine.chunkCount());
+    std::vector<std::uint64_t> chunkExportNs(engine.chunkCount());
+    const bool exporting = shm || history || metrics || columnar;
+    const std::size_t chunkVehicles = engine.chunkVehicles();
+    engine.setChunkObserver([&](std::size_t begin, std::size_t end) {
+        const std::size_t chunk = begin / chunkVehicles;
+        std::vector<RuleEvent>& events = chunkEvents[chunk];
+        const std::uint64_t now = fleet.tickIndex() * config.dt.count();
+        const WallClock::time_point rulesStart = WallClock::now();
+        events.clear();
+        ruleEngine.evaluateBatch(fleet, begin, end, now, events);
+        const WallClock::time_point rulesDone = WallClock::now();
+        chunkRulesNs[chunk] += nanosecondsBetween(rulesStart, rulesDone);
+        VT_RECORD(Rules, nanosecondsBetween(rulesStart, rulesDone));
+        chunkTransitions[chunk] += events.size();
+        for (const RuleEvent& event : events) {
+            if (event.raised && ruleEngine.rules().spec(event.rule).severity != Severity::Info) {
+                VT_COUNT(WarningsRaised, 1);
+            }
+        }
+        if (!exporting) {
+            return;
+        }
+        const WallClock::time_point exportStart = WallClock::now();
+        if (shm) {
+            shm->publishFleet(fleet, ruleEngine, begin, end, now);
+        }
+        if (history) {
+            history->appendFleet(fleet, begin, end, now);
+        }
+        if (metrics) {
+            metrics->recordEvents(events);
+        }
+        if (columnar && columnar->due(fleet.tickIndex())) {
+            columnar->capture(fleet, begin, end);
+        }
+        const std::uint64_t exportNs = nanosecondsBetween(exportStart, WallClock::now());
+        chunkExportNs[chunk] += exportNs;
+        VT_RECORD(Export, exportNs);
+    });
+
+    const WallClock::time_point start = WallClock::now();
+    const std::uint64_t endTick = report.firstTick + config.ticks;
+    for (std::uint64_t tick = report.firstTick; tick < endTick; ++tick) {
+        VT_PROBE(Tick);
+        engine.tick();
+        if (columnar && columnar->due(tick)) {
+            columnar->commit(tick, tick * config.dt.count());
+        }
+        if (metrics) {
+            metrics->setTicks(tick + 1);
+        }
+        if (!config.checkpointPath.empty() && config.checkpointEvery != 0 && (tick + 1) % config.checkpointEvery == 0 &&
+            tick + 1 < endTick) {
+            checkpoint();
+        }
+    }
+    if (!config.checkpointPath.empty()) {
+        checkpoint();
+    }
+    report.wallSeconds = secondsBetween(start, WallClock::now());
+    if (columnar) {
+        columnar->close();
+        report.columnar = columnar->stats();
+    }
+    for (std::uint64_t transitions : chunkTransitions) {
+        report.ruleTransitions += transitions;
+    }
+    if (history) {
+        report.historySamples = history->sampleCount();
+        report.historyBytes = history->memoryBytes();
+    }
+
+    const std::uint64_t calls = config.ticks * engine.chunkCount();
+    const StageTimes times = engine.stageTimes();
+    report.stages.push_back(StageReport{"sensors", calls, times.sensorsNs});
+    report.stages.push_back(StageReport{"acc", calls, times.accNs});
+    report.stages.push_back(StageReport{"diagnostics", calls, times.diagnosticsNs});
+    std::uint64_t rulesNs = 0;
+    std::uint64_t exportNs = 0;
+    for (std::size_t c = 0; c < engine.chunkCount(); ++c) {
+        rulesNs += chunkRulesNs[c];
+        exportNs += chunkExportNs[c];
+    }
+    report.stages.push_back(StageReport{"rules", calls, rulesNs});
+    if (exporting) {
+        report.stages.push_back(StageReport{"export", calls, exportNs});
+    }
+}
+}
+
+/**
+ * @brief Runs a headless simulation and measures it.
+ *
+ * @param config Tick count, time step, seed, vehicle count and output paths.
+ * @return The throughput, per-stage timing and latency percentile summary.
+ */
+HeadlessReport runHeadless(const HeadlessConfig& config) {
+    HeadlessReport report;
+    report.config = config;
+    if (report.config.vehicles == 0) {
+        report.config.vehicles = 1;
+    }
+    if (!config.restorePath.empty()) {
+        // A resumed run continues the checkpointed simulation
+        const CheckpointHeader checkpoint = readCheckpointHeader(config.restorePath);
+        report.config.vehicles = checkpoint.vehicleCount;
+        report.config.seed = checkpoint.seed;
+        report.config.dt = std::chrono::nanoseconds(checkpoint.dtNs);
+    }
+    if (report.config.vehicles > 1 && !(config.recordPath.empty() && config.replayPath.empty())) {
+        throw std::runtime_error("Recording and replay need a single vehicle");
+    }
+    if (report.config.vehicles > 1 && !config.telemetryPath.empty()) {
+        // A Fleet records no telemetry; --columnar captures every vehicle's state instead
+        throw std::runtime_error("Binary telemetry needs a single vehicle (use --columnar for a fleet)");
+    }
+    if (report.config.vehicles == 1 && !config.checkpointPath.empty()) {
+        throw std::runtime_error("Checkpoints need a fleet run (more than one vehicle)");
+    }
+    if (report.config.vehicles == 1 && config.acc != acc::ControllerKind::Band) {
+        throw std::runtime_error("--acc needs a fleet run; a single vehicle runs VehicleAccController (acc.hpp)");
+    }
+    RuleSet rules = config.rulesPath.empty() ? RuleSet::defaults() : RuleSet::fromFile(config.rulesPath);
+
+    Logger& logger = Logger::GetInstance(config.logPath);
+    logger.Configure(config.logLevels);
+    logger.EnableAsync(8192, OverflowPolicy::Block);
+    if (!config.telemetryPath.empty()) {
+        TelemetryLog::GetInstance().Open(config.telemetryPath);
+    }
+    VT_LOG_INFO(logger, General, "Headless run: seed {}, {} ticks, {} vehicle(s)", report.config.seed, config.ticks,
+                report.config.vehicles);
+
+    if (report.config.vehicles == 1) {
+        runVehicle(report.config, std::move(rules), report);
+    } else {
+        runFleet(report.config, std::move(rules), report);
+    }
+    report.simulatedSeconds = std::chrono::duration<double>(report.config.dt).count() * report.config.ticks;
+
+    TelemetryLog::GetInstance().Close();
+    logger.Flush();
+    report.logBytes = logger.GetBytesWritten();
+    report.telemetryBytes = TelemetryLog::GetInstance().GetBytesWritten();
+    report.latency = Instrumentation::GetInstance().Snapshot();
+    return report;
+}
+
+/**
+ * @brief Builds the signal history settings of a run.
+ *
+ * @param config The run's options.
+ * @return Retention of historySeconds, 1 us timestamps and historyResolution values.
+ */
+HistoryConfig historyConfig(const HeadlessConfig& config) {
+    HistoryConfig history;
+    history.retention = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::duration<double>(config.historySeconds));
+    history.valueResolution = config.historyResolution;
+    return history;
+}
+
+/**
+ * @brief Prints a headless run's summary.
+ *
+ * @param os The output stream to write to.
+ * @param report The report to print.
+ */
+void printHeadlessReport(std::ostream& os, const HeadlessReport& report) {
+    const HeadlessConfig& config = report.config;
+    os << std::fixed << std::setprecision(3)
+       << "Headless run\n"
+       << "  seed:              " << config.seed << '\n'
+       << "  vehicles:          " << config.vehicles << '\n';
+    if (config.vehicles > 1) {
+        os << "  acc controller:    " << acc::controllerName(config.acc) << '\n';
+    }
+    os << "  ticks:             " << config.ticks << '\n';
+    if (!config.restorePath.empty()) {
+        os << "  resumed at tick:   " << report.firstTick << " (restored in " << report.restoreSeconds * 1e3
+           << " ms)\n";
+    }
+    os << std::setprecision(3)
+       << "  simulated time:    " << report.simulatedSeconds << " s\n"
+       << "  wall time:         " << report.wallSeconds << " s\n"
+       << std::setprecision(1)
+       << "  ticks/sec:         " << report.ticksPerSecond() << '\n'
+       << "  vehicle-ticks/sec: " << report.vehicleTicksPerSecond() << '\n'
+       << "  realtime factor:   " << report.realtimeFactor() << "x\n"
+       << "  log bytes:         " << report.logBytes << '\n'
+       << "  telemetry bytes:   " << report.telemetryBytes << '\n'
+       << "  rule transitions:  " << report.ruleTransitions << '\n';
+    if (report.historySamples > 0) {
+        os << "  history samples:   " << report.historySamples << '\n'
+           << "  history bytes:     " << report.historyBytes << " (" << std::setprecision(2)
+           << static_cast<double>(report.historyBytes) / report.historySamples << " per sample)\n";
+    }
+    if (!config.columnarPath.empty()) {
+        const ColumnarStats& columnar = report.columnar;
+        os << "  snapshots:         " << columnar.snapshots << " in " << columnar.groups << " row group(s)\n"
+           << "  snapshot bytes:    " << columnar.bytes << " (" << std::setprecision(2)
+           << (columnar.bytes > 0 ? static_cast<double>(columnar.rawBytes) / columnar.bytes : 0.0)
+           << "x compression), " << columnar.stalls << " stall(s)\n";
+    }
+    if (report.checkpoints > 0) {
+        os << std::setprecision(1)
+           << "  checkpoints:       " << report.checkpoints << " of " << report.checkpointBytes << " bytes, "
+           << report.checkpointSeconds * 1e3 << " ms in total\n";
+    }
+    os << std::setprecision(1)
+       << "\n"
+       << std::left << std::setw(14) << "stage" << std::right << std::setw(12) << "calls"
+       << std::setw(14) << "total ms" << std::setw(12) << "mean us" << '\n';
+    for (const StageReport& stage : report.stages) {
+        os << std::left << std::setw(14) << stage.name << std::right << std::setw(12) << stage.calls
+           << std::setprecision(1) << std::setw(14) << stage.totalNs / 1e6
+           << std::setprecision(3) << std::setw(12)
+           << (stage.calls ? stage.totalNs / 1e3 / stage.calls : 0.0) << '\n';
+    }
+    os << '\n';
+    printInstrumentationReport(os, report.latency);
+}
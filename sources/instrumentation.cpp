@@ -0,0 +1,311 @@
+#include "../headers/instrumentation.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#include <x86intrin.h>
+#define VT_HAVE_TSC 1
+#else
+#define VT_HAVE_TSC 0
+#endif
+
+namespace {
+// How long the TSC is compared against steady_clock on first use
+constexpr auto kCalibrationTime = std::chrono::milliseconds(10);
+
+std::uint64_t steadyNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// Whether the TSC ticks at a constant rate regardless of power states (CPUID 8000_0007h, EDX bit 8).
+bool hasInvariantTsc() {
+#if VT_HAVE_TSC
+    unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+    return __get_cpuid(0x80000007, &eax, &ebx, &ecx, &edx) != 0 && (edx & (1u << 8)) != 0;
+#else
+    return false;
+#endif
+}
+
+/// Adds to a value only the owning thread writes; readers on other threads see it whole.
+inline void bump(std::atomic<std::uint64_t>& value, std::uint64_t n) {
+    value.store(value.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+double toUs(std::uint64_t ns) {
+    return static_cast<double>(ns) / 1e3;
+}
+}
+
+// One thread's histograms and counters. Only the owning thread writes them, with
+// relaxed atomic stores, so Snapshot() can read them from another thread.
+struct Instrumentation::ThreadMetrics {
+    struct Histogram {
+        std::atomic<std::uint64_t> buckets[LatencyHistogram::kBucketCount];
+        std::atomic<std::uint64_t> sum;
+        std::atomic<std::uint64_t> min;
+        std::atomic<std::uint64_t> max;
+        std::atomic<std::uint64_t> count;
+    };
+    Histogram probes[kProbeCount];
+    std::atomic<std::uint64_t> counters[kCounterCount];
+};
+
+/**
+ * @brief Gets the highest duration that falls into a bucket.
+ *
+ * @param index Index of the bucket.
+ * @return The bucket's upper bound in nanoseconds; the last bucket has none.
+ */
+std::uint64_t LatencyHistogram::bucketUpperBound(std::size_t index) {
+    if (index < 2 * kSubBuckets) {
+        return index;
+    }
+    if (index == kBucketCount - 1) {
+        return UINT64_MAX;
+    }
+    const std::size_t shift = index / kSubBuckets - 1;
+    const std::uint64_t sub = index - shift * kSubBuckets;
+    return ((sub + 1) << shift) - 1;
+}
+
+/**
+ * @brief Records one duration.
+ *
+ * @param ns The duration in nanoseconds.
+ */
+void LatencyHistogram::record(std::uint64_t ns) {
+    ++buckets[bucketIndex(ns)];
+    ++total;
+    sum += ns;
+    lowest = std::min(lowest, ns);
+    highest = std::max(highest, ns);
+}
+
+/**
+ * @brief Widens the extremes and adds to the sum, for durations added bucket by bucket.
+ *
+ * @param minNs The shortest of the added durations.
+ * @param maxNs The longest of the added durations.
+ * @param sumNs The sum of the added durations.
+ */
+void LatencyHistogram::include(std::uint64_t minNs, std::uint64_t maxNs, std::uint64_t sumNs) {
+    lowest = std::min(lowest, minNs);
+    highest = std::max(highest, maxNs);
+    sum += sumNs;
+}
+
+/**
+ * @brief Adds another histogram's durations to this one.
+ *
+ * @param other The histogram to add.
+ */
+void LatencyHistogram::merge(const LatencyHistogram& other) {
+    if (other.total == 0) {
+        return;
+    }
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        buckets[i] += other.buckets[i];
+    }
+    total += other.total;
+    include(other.lowest, other.highest, other.sum);
+}
+
+/**
+ * @brief Forgets every recorded duration.
+ */
+void LatencyHistogram::reset() {
+    *this = LatencyHistogram();
+}
+
+/**
+ * @brief Gets a percentile of the recorded durations.
+ *
+ * @param percent The percentile, from 0 to 100 (e.g. 99.9).
+ * @return The upper bound of the bucket holding the percentile, capped at the maximum; 0 if empty.
+ */
+std::uint64_t LatencyHistogram::percentileNs(double percent) const {
+    if (total == 0) {
+        return 0;
+    }
+    const double wanted = std::ceil(percent / 100.0 * static_cast<double>(total));
+    const std::uint64_t rank = wanted < 1.0 ? 1 : std::min(total, static_cast<std::uint64_t>(wanted));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBucketCount; ++i) {
+        seen += buckets[i];
+        if (seen >= rank) {
+            return std::max(lowest, std::min(bucketUpperBound(i), highest));
+        }
+    }
+    return highest;
+}
+
+/**
+ * @brief Constructor for the Instrumentation class; picks the clock.
+ *
+ * With an invariant TSC the tick rate is measured against steady_clock over
+ * kCalibrationTime, so the first probe of a run pays for a short sleep.
+ */
+Instrumentation::Instrumentation() {
+#if VT_HAVE_TSC
+    if (hasInvariantTsc()) {
+        const std::uint64_t wallStart = steadyNs();
+        const std::uint64_t tscStart = __rdtsc();
+        std::this_thread::sleep_for(kCalibrationTime);
+        const std::uint64_t tscEnd = __rdtsc();
+        const std::uint64_t wallEnd = steadyNs();
+        if (tscEnd > tscStart && wallEnd > wallStart) {
+            useTsc = true;
+            nsPerTickQ32 = ((wallEnd - wallStart) << 32) / (tscEnd - tscStart);
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Gets the process-wide instance.
+ *
+ * The instance is never destroyed, so probes in other singletons' destructors
+ * (such as the logger's final drain) still have somewhere to record.
+ *
+ * @return Reference to the Instrumentation instance.
+ */
+Instrumentation& Instrumentation::GetInstance() {
+    static Instrumentation* instance = new Instrumentation();
+    return *instance;
+}
+
+/**
+ * @brief Reads the clock.
+ *
+ * @return TSC ticks, or steady_clock nanoseconds without an invariant TSC.
+ */
+std::uint64_t Instrumentation::Now() const {
+#if VT_HAVE_TSC
+    if (useTsc) {
+        return __rdtsc();
+    }
+#endif
+    return steadyNs();
+}
+
+/**
+ * @brief Records a duration into the calling thread's histogram of a probe.
+ *
+ * @param probe The probe.
+ * @param ns The duration in nanoseconds.
+ */
+void Instrumentation::Record(Probe probe, std::uint64_t ns) {
+    if (!IsEnabled()) {
+        return;
+    }
+    ThreadMetrics::Histogram& histogram = Local().probes[static_cast<std::size_t>(probe)];
+    const std::uint64_t count = histogram.count.load(std::memory_order_relaxed);
+    bump(histogram.buckets[LatencyHistogram::bucketIndex(ns)], 1);
+    bump(histogram.sum, ns);
+    if (count == 0 || ns < histogram.min.load(std::memory_order_relaxed)) {
+        histogram.min.store(ns, std::memory_order_relaxed);
+    }
+    if (ns > histogram.max.load(std::memory_order_relaxed)) {
+        histogram.max.store(ns, std::memory_order_relaxed);
+    }
+    histogram.count.store(count + 1, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Adds to the calling thread's count of a counter.
+ *
+ * @param counter The counter.
+ * @param n The amount to add.
+ */
+void Instrumentation::Add(Counter counter, std::uint64_t n) {
+    if (!IsEnabled()) {
+        return;
+    }
+    bump(Local().counters[static_cast<std::size_t>(counter)], n);
+}
+
+/**
+ * @brief Merges every thread's histograms and counters.
+ *
+ * Threads keep recording meanwhile; their latest few measurements may be missing.
+ *
+ * @return The merged measurements since the start of the process.
+ */
+InstrumentationSnapshot Instrumentation::Snapshot() const {
+    InstrumentationSnapshot snapshot;
+    snapshot.clock = ClockName();
+    std::lock_guard<std::mutex> lock(registryMutex);
+    for (const ThreadMetrics* thread : threads) {
+        for (std::size_t p = 0; p < kProbeCount; ++p) {
+            const ThreadMetrics::Histogram& source = thread->probes[p];
+            if (source.count.load(std::memory_order_relaxed) == 0) {
+                continue;
+            }
+            LatencyHistogram& target = snapshot.probes[p];
+            for (std::size_t i = 0; i < LatencyHistogram::kBucketCount; ++i) {
+                const std::uint64_t count = source.buckets[i].load(std::memory_order_relaxed);
+                if (count != 0) {
+                    target.recordBucket(i, count);
+                }
+            }
+            target.include(source.min.load(std::memory_order_relaxed), source.max.load(std::memory_order_relaxed),
+                           source.sum.load(std::memory_order_relaxed));
+        }
+        for (std::size_t c = 0; c < kCounterCount; ++c) {
+            snapshot.counters[c] += thread->counters[c].load(std::memory_order_relaxed);
+        }
+    }
+    return snapshot;
+}
+
+/**
+ * @brief Gets the calling thread's metrics, registering them on the thread's first use.
+ *
+ * @return The thread's metrics.
+ */
+Instrumentation::ThreadMetrics& Instrumentation::Local() {
+    thread_local ThreadMetrics* local = nullptr;
+    if (local == nullptr) {
+        Instrumentation& instance = GetInstance();
+        local = new ThreadMetrics();
+        std::lock_guard<std::mutex> lock(instance.registryMutex);
+        instance.threads.push_back(local);
+    }
+    return *local;
+}
+
+/**
+ * @brief Prints the merged latencies and counters.
+ *
+ * @param os The output stream to write to.
+ * @param snapshot The measurements to print; probes that never ran are left out.
+ */
+void printInstrumentationReport(std::ostream& os, const InstrumentationSnapshot& snapshot) {
+    os << std::fixed << std::setprecision(3)
+       << std::left << std::setw(14) << "latency" << std::right << std::setw(12) << "count"
+       << std::setw(12) << "p50 us" << std::setw(12) << "p99 us" << std::setw(12) << "p99.9 us"
+       << std::setw(12) << "max us" << "   (clock: " << snapshot.clock << ")\n";
+    for (std::size_t p = 0; p < kProbeCount; ++p) {
+        const LatencyHistogram& histogram = snapshot.probes[p];
+        if (histogram.count() == 0) {
+            continue;
+        }
+        os << std::left << std::setw(14) << probeName(static_cast<Probe>(p)) << std::right << std::setw(12)
+           << histogram.count() << std::setw(12) << toUs(histogram.percentileNs(50.0)) << std::setw(12)
+           << toUs(histogram.percentileNs(99.0)) << std::setw(12) << toUs(histogram.percentileNs(99.9))
+           << std::setw(12) << toUs(histogram.maxNs()) << '\n';
+    }
+    for (std::size_t c = 0; c < kCounterCount; ++c) {
+        os << "  " << std::left << std::setw(18) << (std::string(counterName(static_cast<Counter>(c))) + ":")
+           << std::right << snapshot.counters[c] << '\n';
+    }
+}
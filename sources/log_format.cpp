@@ -0,0 +1,201 @@
+#include "../headers/log_format.hpp"
+
+#include <charconv>
+#include <cstring>
+
+namespace log_format {
+
+namespace {
+/// Appends one argument; precision < 0 formats floating point in its shortest exact form.
+void appendArg(std::string& out, const Arg& arg, int precision) {
+    char text[64];
+    std::to_chars_result result{text, std::errc()};
+    switch (arg.type) {
+        case ArgType::Bool:
+            out.append(arg.integer != 0 ? "true" : "false");
+            return;
+        case ArgType::Char:
+            out.push_back(static_cast<char>(arg.integer));
+            return;
+        case ArgType::Text:
+            out.append(arg.text.data(), arg.text.size());
+            return;
+        case ArgType::Signed:
+            result = std::to_chars(text, text + sizeof(text), arg.integer);
+            break;
+        case ArgType::Unsigned:
+            result = std::to_chars(text, text + sizeof(text), arg.unsignedInteger);
+            break;
+        case ArgType::Double:
+            result = precision < 0 ? std::to_chars(text, text + sizeof(text), arg.number)
+                                   : std::to_chars(text, text + sizeof(text), arg.number, std::chars_format::fixed,
+                                                   precision);
+            break;
+    }
+    if (result.ec != std::errc()) {
+        out.append("###");
+        return;
+    }
+    out.append(text, static_cast<std::size_t>(result.ptr - text));
+}
+
+template <typename T>
+void put(unsigned char* payload, std::size_t& used, const T& value) {
+    std::memcpy(payload + used, &value, sizeof(T));
+    used += sizeof(T);
+}
+
+template <typename T>
+T take(const unsigned char* payload, std::size_t& offset) {
+    T value;
+    std::memcpy(&value, payload + offset, sizeof(T));
+    offset += sizeof(T);
+    return value;
+}
+}
+
+/**
+ * @brief Appends a format with its arguments substituted.
+ *
+ * The format is assumed to have been checked by validate(); surplus placeholders
+ * are left out rather than read past the arguments.
+ *
+ * @param out The string to append to.
+ * @param format The format string.
+ * @param args The arguments, in placeholder order.
+ * @param count Number of arguments.
+ */
+void format(std::string& out, const char* format, const Arg* args, std::size_t count) {
+    std::size_t next = 0;
+    const char* literal = format;
+    const char* p = format;
+    while (*p != '\0') {
+        if ((p[0] == '{' && p[1] == '{') || (p[0] == '}' && p[1] == '}')) {
+            out.append(literal, static_cast<std::size_t>(p - literal) + 1);
+            p += 2;
+            literal = p;
+            continue;
+        }
+        if (*p != '{') {
+            ++p;
+            continue;
+        }
+        out.append(literal, static_cast<std::size_t>(p - literal));
+        int precision = -1;
+        ++p;
+        if (*p == ':') {
+            p += 2;   // ":."
+            precision = *p++ - '0';
+            if (*p >= '0' && *p <= '9') {
+                precision = precision * 10 + (*p++ - '0');
+            }
+            ++p;      // 'f'
+        }
+        ++p;          // '}'
+        if (next < count) {
+            appendArg(out, args[next++], precision);
+        }
+        literal = p;
+    }
+    out.append(literal, static_cast<std::size_t>(p - literal));
+}
+
+/**
+ * @brief Copies arguments into a fixed-size record payload.
+ *
+ * @param payload The payload to fill.
+ * @param used Receives the number of bytes written.
+ * @param args The arguments.
+ * @param count Number of arguments; at most kMaxArgs.
+ * @return false if the arguments do not fit, in which case the payload is incomplete.
+ */
+bool encode(unsigned char (&payload)[kPayloadBytes], std::uint16_t& used, const Arg* args, std::size_t count) {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        const Arg& arg = args[i];
+        std::size_t needed = 1;
+        switch (arg.type) {
+            case ArgType::Bool:
+            case ArgType::Char:
+                needed += 1;
+                break;
+            case ArgType::Signed:
+            case ArgType::Unsigned:
+            case ArgType::Double:
+                needed += 8;
+                break;
+            case ArgType::Text:
+                needed += sizeof(std::uint16_t) + arg.text.size();
+                break;
+        }
+        if (size + needed > kPayloadBytes) {
+            return false;
+        }
+        payload[size++] = static_cast<unsigned char>(arg.type);
+        switch (arg.type) {
+            case ArgType::Bool:
+            case ArgType::Char:
+                payload[size++] = static_cast<unsigned char>(arg.integer);
+                break;
+            case ArgType::Signed:
+                put(payload, size, arg.integer);
+                break;
+            case ArgType::Unsigned:
+                put(payload, size, arg.unsignedInteger);
+                break;
+            case ArgType::Double:
+                put(payload, size, arg.number);
+                break;
+            case ArgType::Text:
+                put(payload, size, static_cast<std::uint16_t>(arg.text.size()));
+                std::memcpy(payload + size, arg.text.data(), arg.text.size());
+                size += arg.text.size();
+                break;
+        }
+    }
+    used = static_cast<std::uint16_t>(size);
+    return true;
+}
+
+/**
+ * @brief Reads back the arguments written by encode().
+ *
+ * @param payload The payload.
+ * @param used Number of payload bytes in use.
+ * @param args Receives the arguments; their text points into the payload.
+ * @return Number of arguments read.
+ */
+std::size_t decode(const unsigned char* payload, std::size_t used, Arg (&args)[kMaxArgs]) {
+    std::size_t offset = 0;
+    std::size_t count = 0;
+    while (offset < used && count < kMaxArgs) {
+        Arg& arg = args[count++];
+        arg.type = static_cast<ArgType>(payload[offset++]);
+        switch (arg.type) {
+            case ArgType::Bool:
+                arg.integer = payload[offset++];
+                break;
+            case ArgType::Char:
+                arg.integer = static_cast<char>(payload[offset++]);
+                break;
+            case ArgType::Signed:
+                arg.integer = take<std::int64_t>(payload, offset);
+                break;
+            case ArgType::Unsigned:
+                arg.unsignedInteger = take<std::uint64_t>(payload, offset);
+                break;
+            case ArgType::Double:
+                arg.number = take<double>(payload, offset);
+                break;
+            case ArgType::Text: {
+                const std::uint16_t length = take<std::uint16_t>(payload, offset);
+                arg.text = std::string_view(reinterpret_cast<const char*>(payload + offset), length);
+                offset += length;
+                break;
+            }
+        }
+    }
+    return count;
+}
+
+} // namespace log_format
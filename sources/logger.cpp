@@ -1,12 +1,22 @@
 #include "../headers/logger.hpp"
 
+namespace {
+// Upper bound on records formatted into a single write by the writer thread
+constexpr std::size_t kMaxBatchRecords = 1024;
+// How long the idle writer sleeps before re-checking the queue on its own
+constexpr auto kWriterIdleWait = std::chrono::milliseconds(10);
+}
+
 /// @brief Constructor for the Logger class
-/// @details Initializes the logger with isInitialized set to false
-Logger::Logger() : isInitialized(false) {}
+/// @details Initializes the logger with isInitialized set to false and every category at Info level
+Logger::Logger() : isInitialized(false) {
+    SetLevel(LogLevel::Info);
+}
 
 /// @brief Destructor for the Logger class
-/// @details Closes the log file if it's open
+/// @details Flushes any queued messages, stops the writer thread and closes the log file
 Logger::~Logger() {
+    Shutdown();
     if (logFile.is_open()) {
         logFile.close();
     }
@@ -24,18 +34,194 @@ Logger& Logger::GetInstance(const std::string& filePath) {
     return instance;
 }
 
-/// @brief Logs a message to the file
+/// @brief Logs a message to the file at Info level in the General category
+/// @details In asynchronous mode the message is only queued; the writer thread formats and writes it.
 /// @param message The message to be logged
 void Logger::Log(const std::string& message) {
+    Log(VT_FMT("{}"), message);
+}
+
+/// @brief Sets the lowest level written in every category
+/// @param level The threshold; Off disables logging
+void Logger::SetLevel(LogLevel level) {
+    for (std::atomic<LogLevel>& threshold : thresholds) {
+        threshold.store(level, std::memory_order_relaxed);
+    }
+}
+
+/// @brief Sets the lowest level written in one category
+/// @param category The category
+/// @param level The threshold; Off disables the category
+void Logger::SetLevel(LogCategory category, LogLevel level) {
+    thresholds[static_cast<std::size_t>(category)].store(level, std::memory_order_relaxed);
+}
+
+/// @brief Gets the lowest level written in a category
+/// @param category The category
+/// @return The threshold
+LogLevel Logger::GetLevel(LogCategory category) const {
+    return thresholds[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+}
+
+/// @brief Applies level thresholds from a comma-separated spec, left to right
+/// @details "warning" sets every category; "sensors=debug" sets one. Nothing is applied if any entry is invalid.
+/// @param spec The spec, e.g. "info,sensors=debug,dashboard=off"
+void Logger::Configure(std::string_view spec) {
+    auto parseLevel = [](std::string_view name) {
+        for (int l = static_cast<int>(LogLevel::Trace); l <= static_cast<int>(LogLevel::Off); ++l) {
+            if (name == logLevelName(static_cast<LogLevel>(l))) {
+                return static_cast<LogLevel>(l);
+            }
+        }
+        throw std::runtime_error("Unknown log level: " + std::string(name));
+    };
+
+    LogLevel levels[kLogCategoryCount];
+    for (std::size_t c = 0; c < kLogCategoryCount; ++c) {
+        levels[c] = GetLevel(static_cast<LogCategory>(c));
+    }
+    while (!spec.empty()) {
+        const std::size_t comma = spec.find(',');
+        const std::string_view entry = spec.substr(0, comma);
+        spec = comma == std::string_view::npos ? std::string_view() : spec.substr(comma + 1);
+
+        const std::size_t equals = entry.find('=');
+        if (equals == std::string_view::npos) {
+            const LogLevel level = parseLevel(entry);
+            for (LogLevel& l : levels) {
+                l = level;
+            }
+            continue;
+        }
+        const std::string_view name = entry.substr(0, equals);
+        std::size_t c = 0;
+        while (c < kLogCategoryCount && name != logCategoryName(static_cast<LogCategory>(c))) {
+            ++c;
+        }
+        if (c == kLogCategoryCount) {
+            throw std::runtime_error("Unknown log category: " + std::string(name));
+        }
+        levels[c] = parseLevel(entry.substr(equals + 1));
+    }
+    for (std::size_t c = 0; c < kLogCategoryCount; ++c) {
+        SetLevel(static_cast<LogCategory>(c), levels[c]);
+    }
+}
+
+/// @brief Writes or queues one message
+/// @details Synchronous mode formats the line into a reused thread-local buffer and writes it at once.
+///          Asynchronous mode copies the arguments into the record, so nothing is formatted on the
+///          caller's thread unless the arguments are too large for the record.
+/// @param level The message's level, written as a tag
+/// @param category The message's category, written as a tag
+/// @param format The checked format string, which must outlive the record (a string literal)
+/// @param args The arguments
+/// @param count Number of arguments
+void Logger::Write(LogLevel level, LogCategory category, const char* format, const log_format::Arg* args,
+                   std::size_t count) {
+    VT_PROBE(Log);
+    VT_COUNT(LogRecords, 1);
+    const std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
+    if (asyncEnabled.load(std::memory_order_acquire)) {
+        LogRecord record;
+        record.time = now;
+        record.level = level;
+        record.category = category;
+        if (log_format::encode(record.args, record.argBytes, args, count)) {
+            record.format = format;
+        } else {
+            log_format::format(record.spill, format, args, count);
+        }
+        Enqueue(std::move(record));
+        return;
+    }
+
     if (logFile.is_open()) {
-        auto now = std::chrono::system_clock::now();
-        auto time = std::chrono::system_clock::to_time_t(now);
-        logFile << std::put_time(std::localtime(&time), "%Y-%m-%d %H:%M:%S") << " - " << message << std::endl;
+        thread_local std::string line;
+        line.clear();
+        const char* stamp = timestampCache.format(now);
+        line.append(stamp, timestampCache.length);
+        line.append(" - ");
+        AppendTag(line, level, category);
+        log_format::format(line, format, args, count);
+        line.push_back('\n');
+        logFile.write(line.data(), static_cast<std::streamsize>(line.size()));
+        logFile.flush();
+        bytesWritten.fetch_add(line.size(), std::memory_order_relaxed);
+        VT_COUNT(LogBytes, line.size());
     } else {
         std::cerr << "Log file is not open!" << std::endl;
     }
 }
 
+/// @brief Switches the logger to asynchronous mode
+/// @details Starts a background writer thread that drains a bounded lock-free queue in batches.
+/// @param queueCapacity Number of messages the queue can hold (rounded up to a power of two)
+/// @param policy What to do when the queue is full
+void Logger::EnableAsync(std::size_t queueCapacity, OverflowPolicy policy) {
+    if (asyncEnabled.load(std::memory_order_acquire)) {
+        return;
+    }
+    queue = std::make_unique<BoundedQueue<LogRecord>>(queueCapacity);
+    overflowPolicy = policy;
+    stopRequested.store(false);
+    batchBuffer.reserve(64 * 1024);
+    writerThread = std::thread(&Logger::WriterLoop, this);
+    asyncEnabled.store(true, std::memory_order_release);
+}
+
+/// @brief Blocks until every message logged before the call has been written and flushed
+void Logger::Flush() {
+    if (!asyncEnabled.load(std::memory_order_acquire)) {
+        if (logFile.is_open()) {
+            logFile.flush();
+        }
+        return;
+    }
+    const std::uint64_t target = pushedCount.load();
+    WakeWriter();
+    std::unique_lock<std::mutex> lock(asyncMutex);
+    flushDone.wait(lock, [&] { return processedCount.load() >= target; });
+}
+
+/// @brief Drains the queue, stops the writer thread and returns to synchronous logging
+/// @details Callers must stop logging from other threads before shutting down.
+void Logger::Shutdown() {
+    if (!writerThread.joinable()) {
+        return;
+    }
+    stopRequested.store(true);
+    WakeWriter();
+    writerThread.join();
+
+    // Anything queued between the writer's last drain and the join
+    while (DrainBatch() > 0) {
+    }
+    asyncEnabled.store(false, std::memory_order_release);
+    queue.reset();
+}
+
+/// @brief Gets the number of messages discarded by the overflow policy
+/// @return The dropped message count
+std::uint64_t Logger::GetDroppedCount() const {
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+/// @brief Gets the number of bytes written to the log file, including timestamps and newlines
+/// @return The byte count
+std::uint64_t Logger::GetBytesWritten() const {
+    return bytesWritten.load(std::memory_order_relaxed);
+}
+
+/// @brief Gets the number of messages waiting for the writer thread
+/// @details Safe to call from any thread; the value may be momentarily stale.
+/// @return The queue depth
+std::uint64_t Logger::GetQueueDepth() const {
+    const std::uint64_t pushed = pushedCount.load(std::memory_order_relaxed);
+    const std::uint64_t processed = processedCount.load(std::memory_order_relaxed);
+    return pushed > processed ? pushed - processed : 0;
+}
+
 /// @brief Sets the log file path
 /// @param filePath The path to the log file
 void Logger::SetLogFile(const std::string& filePath) {
@@ -47,4 +233,156 @@ void Logger::SetLogFile(const std::string& filePath) {
         std::cerr << "Failed to open log file: " << filePath << std::endl;
         throw std::runtime_error("Failed to open log file: " + filePath);
     }
-}
\ No newline at end of file
+}
+
+/// @brief Pushes a record into the asynchronous queue, applying the overflow policy when full
+/// @param record The record to queue
+void Logger::Enqueue(LogRecord&& record) {
+    while (!queue->tryPush(std::move(record))) {
+        if (overflowPolicy == OverflowPolicy::DropNewest) {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+            VT_COUNT(LogDropped, 1);
+            return;
+        }
+        if (overflowPolicy == OverflowPolicy::DropOldest) {
+            LogRecord discarded;
+            if (queue->tryPop(discarded)) {
+                droppedCount.fetch_add(1, std::memory_order_relaxed);
+                VT_COUNT(LogDropped, 1);
+                processedCount.fetch_add(1);
+            }
+            continue;
+        }
+        WakeWriter();
+        std::this_thread::yield();
+    }
+    pushedCount.fetch_add(1);
+    if (writerSleeping.load()) {
+        WakeWriter();
+    }
+}
+
+/// @brief Wakes the writer thread if it is waiting for work
+void Logger::WakeWriter() {
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+    }
+    writerWakeup.notify_one();
+}
+
+/// @brief Body of the background writer thread
+/// @details Drains the queue in batches until shutdown is requested and the queue is empty.
+void Logger::WriterLoop() {
+    for (;;) {
+        if (DrainBatch() > 0) {
+            continue;
+        }
+        if (stopRequested.load()) {
+            break;
+        }
+        std::unique_lock<std::mutex> lock(asyncMutex);
+        writerSleeping.store(true);
+        writerWakeup.wait_for(lock, kWriterIdleWait,
+                              [&] { return stopRequested.load() || queue->sizeApprox() > 0; });
+        writerSleeping.store(false);
+    }
+}
+
+/// @brief Formats up to kMaxBatchRecords queued records and writes them with a single write and flush
+/// @details The batch is timed into the log-write probe.
+/// @return The number of records taken from the queue
+std::size_t Logger::DrainBatch() {
+    if (!queue) {
+        return 0;
+    }
+    LogRecord record;
+    if (!queue->tryPop(record)) {
+        return 0;
+    }
+    // Timed only when there is work, so the idle writer's polls stay out of the histogram
+    VT_PROBE(LogWrite);
+    batchBuffer.clear();
+    std::size_t count = 0;
+    do {
+        AppendLine(batchBuffer, record);
+        ++count;
+    } while (count < kMaxBatchRecords && queue->tryPop(record));
+
+    if (logFile.is_open()) {
+        logFile.write(batchBuffer.data(), static_cast<std::streamsize>(batchBuffer.size()));
+        logFile.flush();
+        bytesWritten.fetch_add(batchBuffer.size(), std::memory_order_relaxed);
+        VT_COUNT(LogBytes, batchBuffer.size());
+    }
+
+    processedCount.fetch_add(count);
+    {
+        std::lock_guard<std::mutex> lock(asyncMutex);
+    }
+    flushDone.notify_all();
+    return count;
+}
+
+/// @brief Appends one formatted log line to a buffer
+/// @param out The buffer to append to
+/// @param record The record to format
+void Logger::AppendLine(std::string& out, const LogRecord& record) {
+    const char* stamp = timestampCache.format(record.time);
+    out.append(stamp, timestampCache.length);
+    out.append(" - ");
+    AppendTag(out, record.level, record.category);
+    if (record.format != nullptr) {
+        log_format::Arg args[log_format::kMaxArgs];
+        log_format::format(out, record.format, args, log_format::decode(record.args, record.argBytes, args));
+    } else {
+        out.append(record.spill);
+    }
+    out.push_back('\n');
+}
+
+/// @brief Appends the "[level] " or "[level/category] " tag of a line; General messages carry no category
+/// @param out The buffer to append to
+/// @param level The message's level
+/// @param category The message's category
+void Logger::AppendTag(std::string& out, LogLevel level, LogCategory category) {
+    out.push_back('[');
+    out.append(logLevelName(level));
+    if (category != LogCategory::General) {
+        out.push_back('/');
+        out.append(logCategoryName(category));
+    }
+    out.append("] ");
+}
+
+/// @brief Decides whether a rate-limited call site may log now
+/// @details Counts the calls in the current steady-clock second; the first `limit` pass.
+///          Two threads starting a new second at once may let a few extra messages through.
+/// @param limit Messages allowed per second
+/// @return Whether to log
+bool LogRateLimiter::ShouldLog(std::uint32_t limit) {
+    const std::int64_t second =
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    std::int64_t current = window.load(std::memory_order_relaxed);
+    if (current != second && window.compare_exchange_strong(current, second, std::memory_order_relaxed)) {
+        passed.store(0, std::memory_order_relaxed);
+    }
+    return passed.fetch_add(1, std::memory_order_relaxed) < limit;
+}
+
+/// @brief Formats a time point with second resolution, reusing the previous result within the same second
+/// @param time The time point to format
+/// @return Pointer to the null-terminated timestamp text
+const char* Logger::TimestampCache::format(std::chrono::system_clock::time_point time) {
+    std::time_t now = std::chrono::system_clock::to_time_t(time);
+    if (now != second) {
+        std::tm local{};
+#ifdef _WIN32
+        localtime_s(&local, &now);
+#else
+        localtime_r(&now, &local);
+#endif
+        length = std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &local);
+        second = now;
+    }
+    return text;
+}
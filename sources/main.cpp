@@ -1,30 +1,296 @@
 #include <iostream>
 #include <thread>
 #include <chrono>
+#include <random>
+#include <algorithm>
+#include <atomic>
+#include <csignal>
+#include <iterator>
+#include <memory>
+#include <sstream>
+#include <string>
 #include "../headers/vehicle.hpp"
+#include "../headers/scheduler.hpp"
+#include "../headers/headless.hpp"
+#include "../headers/shm_publisher.hpp"
+#include "../headers/metrics_exporter.hpp"
+
+namespace {
+// Set by SIGINT/SIGTERM; the scheduler checks it between task activations
+std::atomic<bool> stopRequested(false);
+
+void requestStop(int) {
+    stopRequested.store(true);
+}
+
+// Options that only make sense for a headless run
+const char* const kHeadlessOnlyOptions[] = {"--ticks", "--dt", "--vehicles", "--threads", "--acc", "--columnar",
+                                            "--columnar-every", "--checkpoint", "--checkpoint-every", "--restore"};
+
+// Command line options, shared by both modes except for kHeadlessOnlyOptions
+struct Options {
+    bool headless = false;
+    bool seedGiven = false;
+    bool logGiven = false;
+    std::string headlessOnly;   // First headless-only option given, rejected in interactive mode
+    HeadlessConfig run;
+};
+
+void printUsage(const char* program) {
+    std::cerr << "Usage: " << program << " [--seed N] [--log PATH] [--telemetry PATH] [--rules PATH] [--shm NAME]\n"
+              << "              [--record PATH | --replay PATH] [--history SECONDS] [--history-resolution R]\n"
+              << "              [--log-level SPEC] [--metrics PATH|PORT]\n"
+              << "       " << program << " --headless [--ticks N] [--dt SECONDS] [--seed N] [--vehicles N]\n"
+              << "              [--threads N] [--acc band|pid|cth] [--log PATH] [--telemetry PATH] [--rules PATH]\n"
+              << "              [--shm NAME]\n"
+              << "              [--record PATH | --replay PATH] [--history SECONDS] [--history-resolution R]\n"
+              << "              [--log-level SPEC] [--metrics PATH|PORT] [--columnar PATH] [--columnar-every N]\n"
+              << "              [--checkpoint PATH] [--checkpoint-every N] [--restore PATH]\n"
+              << "--acc picks the fleet's cruise control policy: the band rule, time-gap PID or constant time headway\n"
+              << "--columnar writes every vehicle's state every N ticks (default 100) to a columnar file\n"
+              << "--checkpoint saves a fleet run's state at the end (and every N ticks); --restore resumes one\n"
+              << "and runs --ticks more ticks with the checkpoint's vehicles, seed and dt\n"
+              << "--metrics serves Prometheus text metrics on a Unix socket PATH or on 127.0.0.1:PORT\n"
+              << "SPEC sets log thresholds, e.g. warning or info,sensors=debug,dashboard=off; levels are\n"
+              << "trace, debug, info (default), warning, error and off; categories are general, sensors,\n"
+              << "acc, diagnostics and dashboard" << std::endl;
+}
+
+/// Parses the command line into options; returns false on unknown or malformed arguments.
+bool parseOptions(int argc, char* argv[], Options& options) {
+    try {
+        for (int i = 1; i < argc; ++i) {
+            const std::string arg = argv[i];
+            if (arg == "--headless") {
+                options.headless = true;
+                continue;
+            }
+            if (i + 1 >= argc) {
+                return false;
+            }
+            const std::string value = argv[++i];
+            if (options.headlessOnly.empty() &&
+                std::find(std::begin(kHeadlessOnlyOptions), std::end(kHeadlessOnlyOptions), arg) !=
+                    std::end(kHeadlessOnlyOptions)) {
+                options.headlessOnly = arg;
+            }
+            if (arg == "--ticks") {
+                options.run.ticks = std::stoull(value);
+            } else if (arg == "--dt") {
+                options.run.dt = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::duration<double>(std::stod(value)));
+            } else if (arg == "--seed") {
+                options.run.seed = std::stoull(value);
+                options.seedGiven = true;
+            } else if (arg == "--vehicles") {
+                options.run.vehicles = std::stoull(value);
+            } else if (arg == "--threads") {
+                options.run.threads = std::stoull(value);
+            } else if (arg == "--acc") {
+                options.run.acc = acc::parseController(value);
+            } else if (arg == "--log") {
+                options.run.logPath = value;
+                options.logGiven = true;
+            } else if (arg == "--telemetry") {
+                options.run.telemetryPath = value;
+            } else if (arg == "--rules") {
+                options.run.rulesPath = value;
+            } else if (arg == "--shm") {
+                options.run.shmName = value;
+            } else if (arg == "--record") {
+                options.run.recordPath = value;
+            } else if (arg == "--replay") {
+                options.run.replayPath = value;
+            } else if (arg == "--history") {
+                options.run.historySeconds = std::stod(value);
+            } else if (arg == "--history-resolution") {
+                options.run.historyResolution = std::stod(value);
+            } else if (arg == "--log-level") {
+                options.run.logLevels = value;
+            } else if (arg == "--metrics") {
+                options.run.metricsEndpoint = value;
+            } else if (arg == "--columnar") {
+                options.run.columnarPath = value;
+            } else if (arg == "--columnar-every") {
+                options.run.columnarEvery = std::stoull(value);
+            } else if (arg == "--checkpoint") {
+                options.run.checkpointPath = value;
+            } else if (arg == "--checkpoint-every") {
+                options.run.checkpointEvery = std::stoull(value);
+            } else if (arg == "--restore") {
+                options.run.restorePath = value;
+            } else {
+                return false;
+            }
+        }
+    } catch (const std::exception&) {
+        return false;
+    }
+    return options.run.dt.count() > 0 && (options.run.recordPath.empty() || options.run.replayPath.empty());
+}
+
+/// Logs the probe latencies merged from every thread so far, one line per probe that has run.
+void logLatencies(Logger& logger) {
+    const InstrumentationSnapshot snapshot = Instrumentation::GetInstance().Snapshot();
+    for (std::size_t p = 0; p < kProbeCount; ++p) {
+        const LatencyHistogram& histogram = snapshot.probes[p];
+        if (histogram.count() == 0) {
+            continue;
+        }
+        VT_LOG_INFO(logger, General, "Latency {}: {} calls, p50 {:.3f} us, p99 {:.3f} us, p99.9 {:.3f} us, max {:.3f} us",
+                    probeName(static_cast<Probe>(p)), histogram.count(), histogram.percentileNs(50.0) / 1e3,
+                    histogram.percentileNs(99.0) / 1e3, histogram.percentileNs(99.9) / 1e3, histogram.maxNs() / 1e3);
+    }
+    VT_LOG_INFO(logger, General, "Counters: {} log records, {} log bytes, {} log dropped, {} warnings raised",
+                snapshot.counter(Counter::LogRecords), snapshot.counter(Counter::LogBytes),
+                snapshot.counter(Counter::LogDropped), snapshot.counter(Counter::WarningsRaised));
+}
+}
 
 /// Main entry point for the vehicle simulation.
-int main() {
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 2;
+    }
+    if (!options.headless && !options.headlessOnly.empty()) {
+        std::cerr << options.headlessOnly << " is only available with --headless" << std::endl;
+        printUsage(argv[0]);
+        return 2;
+    }
+
+    // Fresh seed per run unless one is given; it is logged so an interesting run can be reproduced
+    const std::uint64_t seed = options.seedGiven
+        ? options.run.seed
+        : (static_cast<std::uint64_t>(std::random_device{}()) << 32) | std::random_device{}();
+
+    RuleSet rules = RuleSet::defaults();
+    try {
+        if (options.headless) {
+            options.run.seed = seed;
+            printHeadlessReport(std::cout, runHeadless(options.run));
+            return 0;
+        }
+        if (!options.run.rulesPath.empty()) {
+            rules = RuleSet::fromFile(options.run.rulesPath);
+        }
+        Logger::GetInstance().Configure(options.run.logLevels);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
     // Get the singleton instance of the Vehicle class
-    Vehicle myCar = Vehicle("C:\\Users\\himah\\Desktop\\log.txt");
+    Vehicle myCar = Vehicle(options.logGiven ? options.run.logPath : "C:\\Users\\himah\\Desktop\\log.txt", 0, seed);
+    myCar.setDiagnosticRules(std::move(rules));
+
+    // Live state for external monitors (see shm_snapshot.hpp and shm-reader), and
+    // recording or replaying the sensor streams
+    std::unique_ptr<ShmPublisher> shm;
+    std::unique_ptr<SensorRecorder> recorder;
+    std::unique_ptr<SensorReplay> replay;
+    std::unique_ptr<SignalHistory> history;
+    std::unique_ptr<MetricsExporter> metrics;
+    try {
+        if (!options.run.shmName.empty()) {
+            shm = std::make_unique<ShmPublisher>(options.run.shmName, 1, myCar.diagnosticRules().rules());
+        }
+        if (!options.run.recordPath.empty()) {
+            recorder = std::make_unique<SensorRecorder>(options.run.recordPath, myCar.signalBus(), kRecordingPeriod,
+                                                        seed);
+        }
+        if (!options.run.replayPath.empty()) {
+            replay = std::make_unique<SensorReplay>(options.run.replayPath);
+            myCar.setReplay(replay.get());
+        }
+        if (options.run.historySeconds > 0.0) {
+            history = std::make_unique<SignalHistory>(1, historyConfig(options.run));
+        }
+        if (!options.run.metricsEndpoint.empty()) {
+            metrics = std::make_unique<MetricsExporter>(options.run.metricsEndpoint, myCar.diagnosticRules().rules(), 1);
+        }
+        // Structured binary telemetry, decoded offline with telemetry-decode; opt-in, as in headless runs
+        if (!options.run.telemetryPath.empty()) {
+            TelemetryLog::GetInstance().Open(options.run.telemetryPath);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
 
-    // Main loop for continuous simulation
-    while (true) {
-        // Update sensor readings
-        myCar.updateSensors();
+    // Hand file writes to the logger's background thread so ticks never wait on the disk
+    Logger::GetInstance().EnableAsync(8192, OverflowPolicy::Block);
 
-        // Perform adaptive cruise control adjustments
-        myCar.adaptiveCruiseControl();
 
-        // Display the current vehicle status on the dashboard
-        myCar.displayDashboard();
+    VT_LOG_INFO(Logger::GetInstance(), General, "Simulation seed: {}", seed);
 
-        // Run diagnostic checks
-        myCar.runDiagnostics();
+    std::signal(SIGINT, requestStop);
+    std::signal(SIGTERM, requestStop);
+
+    // Each subsystem runs at its own fixed rate on absolute deadlines. The
+    // radar/ACC control loop has a thread of its own and talks to the rest only
+    // through the signal bus, so a slow dashboard or diagnostics run never delays it
+    TaskScheduler controlScheduler;
+    myCar.scheduleControlTasks(controlScheduler);
+    if (recorder) {
+        // Right after each radar update on the same thread, so each frame pairs a radar sample with
+        // the other sensors' values at that time
+        controlScheduler.addTask("record", kRecordingPeriod, [&recorder] { recorder->record(); });
+    }
+    TaskScheduler scheduler;
+    myCar.scheduleMonitorTasks(scheduler);
+    if (shm) {
+        // Same thread as the diagnostics, so the rule state read here is consistent
+        scheduler.addTask("snapshot", std::chrono::milliseconds(20), [&shm, &myCar] {
+            shm->publish(0, 0, SignalBus::nowNs(), myCar.state(), myCar.diagnosticRules());
+        });
+    }
+    if (metrics) {
+        // Same thread as the diagnostics, like the snapshot
+        scheduler.addTask("exporter", std::chrono::milliseconds(100), [&metrics, &myCar] {
+            metrics->countActive(myCar.diagnosticRules());
+        });
+    }
+    if (history) {
+        scheduler.addTask("history", kRecordingPeriod, [&history, &myCar] {
+            double values[kSignalCount];
+            toSignalValues(myCar.state(), values);
+            history->appendAll(0, SignalBus::nowNs(), values);
+        });
+    }
+    // Per-thread latency histograms are merged and logged periodically
+    scheduler.addTask("metrics", std::chrono::seconds(10), [] { logLatencies(Logger::GetInstance()); });
+    if (replay) {
+        // Replays run in real time and stop the simulation when the recording ends
+        scheduler.addTask("replay-end", std::chrono::milliseconds(100), [&replay] {
+            if (replay->finished()) {
+                stopRequested.store(true);
+            }
+        });
+    }
+
+    std::thread controlThread([&controlScheduler] { controlScheduler.run(stopRequested); });
+    scheduler.run(stopRequested);
+    controlThread.join();
+
+    std::ostringstream stats;
+    controlScheduler.printStats(stats);
+    scheduler.printStats(stats);
+    stats << '\n';
+    printInstrumentationReport(stats, Instrumentation::GetInstance().Snapshot());
+    std::cout << stats.str();
+    VT_LOG_INFO(Logger::GetInstance(), General, "Scheduler statistics:\n{}", stats.str());
+    if (history) {
+        std::cout << "History: " << history->sampleCount() << " samples in " << history->memoryBytes() << " bytes"
+                  << std::endl;
+    }
 
-        // Wait for 2 seconds before the next update
-        std::this_thread::sleep_for(std::chrono::seconds(2));
+    if (recorder) {
+        recorder->close();
     }
+    TelemetryLog::GetInstance().Close();
+    Logger::GetInstance().Shutdown();
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,358 @@
+#include "../headers/metrics_exporter.hpp"
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <stdexcept>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "../headers/instrumentation.hpp"
+#include "../headers/logger.hpp"
+
+namespace {
+// How long a scrape may take to send its request or receive the page
+constexpr long kClientTimeoutUs = 200000;
+
+// Prometheus names of the Instrumentation counters, in Counter order
+constexpr const char* kCounterMetrics[kCounterCount][2] = {
+    {"vt_log_records_total", "Log messages written or queued."},
+    {"vt_log_bytes_total", "Bytes written to the log file."},
+    {"vt_log_dropped_total", "Log messages discarded by the overflow policy."},
+    {"vt_warnings_raised_total", "Diagnostic rules of warning or critical severity raised."},
+};
+
+// Quantiles of the stage latency summaries
+struct Quantile {
+    const char* label;
+    double percent;
+};
+constexpr Quantile kQuantiles[] = {{"0.5", 50.0}, {"0.99", 99.0}, {"0.999", 99.9}};
+
+void appendNumber(std::string& out, std::uint64_t value) {
+    char text[24];
+    const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+    out.append(text, static_cast<std::size_t>(result.ptr - text));
+}
+
+void appendNumber(std::string& out, std::int64_t value) {
+    char text[24];
+    const std::to_chars_result result = std::to_chars(text, text + sizeof(text), value);
+    out.append(text, static_cast<std::size_t>(result.ptr - text));
+}
+
+void appendSeconds(std::string& out, std::uint64_t ns) {
+    char text[32];
+    const std::to_chars_result result = std::to_chars(text, text + sizeof(text), static_cast<double>(ns) / 1e9);
+    out.append(text, static_cast<std::size_t>(result.ptr - text));
+}
+
+/// Appends a label value with backslash, double quote and newline escaped.
+void appendLabelValue(std::string& out, const std::string& value) {
+    for (const char c : value) {
+        if (c == '\\' || c == '"') {
+            out.push_back('\\');
+            out.push_back(c);
+        } else if (c == '\n') {
+            out.append("\\n");
+        } else {
+            out.push_back(c);
+        }
+    }
+}
+
+void appendHeader(std::string& out, const char* name, const char* help, const char* type) {
+    out.append("# HELP ").append(name).append(" ").append(help).append("\n");
+    out.append("# TYPE ").append(name).append(" ").append(type).append("\n");
+}
+
+/// Sends the whole buffer; gives up on errors and timeouts.
+bool sendAll(int fd, const char* data, std::size_t size) {
+    while (size > 0) {
+        const ssize_t sent = send(fd, data, size, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        data += sent;
+        size -= static_cast<std::size_t>(sent);
+    }
+    return true;
+}
+
+bool isPort(const std::string& endpoint) {
+    return !endpoint.empty() && endpoint.size() <= 5 &&
+           std::all_of(endpoint.begin(), endpoint.end(), [](char c) { return c >= '0' && c <= '9'; });
+}
+}
+
+/**
+ * @brief Constructor for the MetricsExporter class; opens the endpoint and starts the server thread.
+ *
+ * A stale socket file at the path is replaced.
+ *
+ * @param endpoint Unix domain socket path, or a port number to listen on 127.0.0.1.
+ * @param rules The diagnostic rules to export vehicle counts for; every rule starts with none raised.
+ * @param vehicleCount Number of vehicles simulated.
+ * @param refreshPeriod How often the page is rendered again.
+ */
+MetricsExporter::MetricsExporter(const std::string& endpoint, const RuleSet& rules, std::size_t vehicleCount,
+                                 std::chrono::milliseconds refreshPeriod)
+    : endpointName(endpoint),
+      rules(rules),
+      vehicles(vehicleCount),
+      refreshPeriod(refreshPeriod),
+      activeVehicles(std::make_unique<std::atomic<std::int64_t>[]>(rules.size())) {
+    auto fail = [&](const char* what) {
+        const std::string reason = std::strerror(errno);
+        for (int fd : {listenFd, wakeFds[0], wakeFds[1]}) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+        throw std::runtime_error(std::string(what) + " metrics endpoint " + endpoint + ": " + reason);
+    };
+
+    if (isPort(endpoint)) {
+        const unsigned long port = std::stoul(endpoint);
+        if (port == 0 || port > 65535) {
+            throw std::runtime_error("Invalid metrics port: " + endpoint);
+        }
+        listenFd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listenFd < 0) {
+            fail("Failed to create");
+        }
+        const int reuse = 1;
+        setsockopt(listenFd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<std::uint16_t>(port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            fail("Failed to bind");
+        }
+    } else {
+        sockaddr_un address{};
+        if (endpoint.empty() || endpoint.size() >= sizeof(address.sun_path)) {
+            throw std::runtime_error("Invalid metrics socket path: " + endpoint);
+        }
+        address.sun_family = AF_UNIX;
+        std::memcpy(address.sun_path, endpoint.c_str(), endpoint.size() + 1);
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listenFd < 0) {
+            fail("Failed to create");
+        }
+        unlink(endpoint.c_str());
+        if (bind(listenFd, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+            fail("Failed to bind");
+        }
+        socketPath = endpoint;
+    }
+    if (listen(listenFd, 16) != 0) {
+        fail("Failed to listen on");
+    }
+    if (pipe2(wakeFds, O_CLOEXEC) != 0) {
+        fail("Failed to open");
+    }
+    server = std::thread(&MetricsExporter::run, this);
+}
+
+/**
+ * @brief Destructor for the MetricsExporter class; stops the server thread and removes the socket file.
+ */
+MetricsExporter::~MetricsExporter() {
+    stopRequested.store(true);
+    const char wake = 1;
+    // Should the write fail, the server thread still stops after its next refresh
+    while (write(wakeFds[1], &wake, 1) < 0 && errno == EINTR) {
+    }
+    server.join();
+    close(listenFd);
+    close(wakeFds[0]);
+    close(wakeFds[1]);
+    if (!socketPath.empty()) {
+        unlink(socketPath.c_str());
+    }
+}
+
+/**
+ * @brief Applies rule transitions to the per-rule vehicle counts.
+ *
+ * @param events Transitions of the exporter's rules, as reported by RuleEngine.
+ */
+void MetricsExporter::recordEvents(const std::vector<RuleEvent>& events) {
+    for (const RuleEvent& event : events) {
+        if (event.rule < rules.size()) {
+            activeVehicles[event.rule].fetch_add(event.raised ? 1 : -1, std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Recounts the vehicles with each rule raised from a rule engine's state.
+ *
+ * Must run on the thread that evaluates the engine.
+ *
+ * @param engine The engine evaluating the exporter's rules.
+ */
+void MetricsExporter::countActive(const RuleEngine& engine) {
+    const std::size_t ruleCount = std::min(rules.size(), engine.rules().size());
+    for (std::size_t r = 0; r < ruleCount; ++r) {
+        std::int64_t active = 0;
+        for (std::uint32_t v = 0; v < engine.vehicleCount(); ++v) {
+            active += engine.isActive(v, r) ? 1 : 0;
+        }
+        activeVehicles[r].store(active, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Body of the server thread: renders the page every refreshPeriod and answers scrapes in between.
+ */
+void MetricsExporter::run() {
+    using Clock = std::chrono::steady_clock;
+    Clock::time_point nextRefresh = Clock::now();
+    while (!stopRequested.load()) {
+        const Clock::time_point now = Clock::now();
+        if (now >= nextRefresh) {
+            nextPage.clear();
+            render(nextPage);
+            page.swap(nextPage);
+            nextRefresh = now + refreshPeriod;
+        }
+        const auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(nextRefresh - now);
+        pollfd fds[2] = {{listenFd, POLLIN, 0}, {wakeFds[0], POLLIN, 0}};
+        if (poll(fds, 2, static_cast<int>(wait.count()) + 1) <= 0) {
+            continue;
+        }
+        if ((fds[1].revents & POLLIN) != 0) {
+            break;
+        }
+        if ((fds[0].revents & POLLIN) != 0) {
+            const int client = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client >= 0) {
+                serve(client);
+                close(client);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Renders every metric in the Prometheus text format.
+ *
+ * @param out The string to append the page to.
+ */
+void MetricsExporter::render(std::string& out) const {
+    appendHeader(out, "vt_vehicles", "Vehicles simulated.", "gauge");
+    out.append("vt_vehicles ");
+    appendNumber(out, static_cast<std::uint64_t>(vehicles));
+    out.push_back('\n');
+
+    const std::uint64_t ticks = tickCount.load(std::memory_order_relaxed);
+    if (ticks != UINT64_MAX) {
+        appendHeader(out, "vt_ticks_total", "Simulation ticks completed.", "counter");
+        out.append("vt_ticks_total ");
+        appendNumber(out, ticks);
+        out.push_back('\n');
+    }
+
+    appendHeader(out, "vt_rule_active_vehicles", "Vehicles with a diagnostic rule currently raised.", "gauge");
+    for (std::size_t r = 0; r < rules.size(); ++r) {
+        const RuleSpec& spec = rules.spec(r);
+        out.append("vt_rule_active_vehicles{rule=\"");
+        appendNumber(out, static_cast<std::uint64_t>(r));
+        out.append("\",signal=\"").append(signalKey(spec.signal));
+        out.append("\",aggregate=\"").append(aggregateName(spec.aggregate));
+        out.append("\",severity=\"").append(severityName(spec.severity));
+        out.append("\",message=\"");
+        appendLabelValue(out, spec.message);
+        out.append("\"} ");
+        appendNumber(out, activeVehicles[r].load(std::memory_order_relaxed));
+        out.push_back('\n');
+    }
+
+    const InstrumentationSnapshot snapshot = Instrumentation::GetInstance().Snapshot();
+    appendHeader(out, "vt_stage_latency_seconds", "Latency of an instrumented stage.", "summary");
+    for (std::size_t p = 0; p < kProbeCount; ++p) {
+        const LatencyHistogram& histogram = snapshot.probes[p];
+        const char* stage = probeName(static_cast<Probe>(p));
+        for (const Quantile& quantile : kQuantiles) {
+            out.append("vt_stage_latency_seconds{stage=\"").append(stage).append("\",quantile=\"");
+            out.append(quantile.label).append("\"} ");
+            appendSeconds(out, histogram.percentileNs(quantile.percent));
+            out.push_back('\n');
+        }
+        out.append("vt_stage_latency_seconds_sum{stage=\"").append(stage).append("\"} ");
+        appendSeconds(out, histogram.sumNs());
+        out.append("\nvt_stage_latency_seconds_count{stage=\"").append(stage).append("\"} ");
+        appendNumber(out, histogram.count());
+        out.push_back('\n');
+    }
+    appendHeader(out, "vt_stage_latency_max_seconds", "Longest run of an instrumented stage.", "gauge");
+    for (std::size_t p = 0; p < kProbeCount; ++p) {
+        out.append("vt_stage_latency_max_seconds{stage=\"").append(probeName(static_cast<Probe>(p))).append("\"} ");
+        appendSeconds(out, snapshot.probes[p].maxNs());
+        out.push_back('\n');
+    }
+
+    for (std::size_t c = 0; c < kCounterCount; ++c) {
+        appendHeader(out, kCounterMetrics[c][0], kCounterMetrics[c][1], "counter");
+        out.append(kCounterMetrics[c][0]).push_back(' ');
+        appendNumber(out, snapshot.counters[c]);
+        out.push_back('\n');
+    }
+
+    appendHeader(out, "vt_log_queue_depth", "Log messages waiting for the writer thread.", "gauge");
+    out.append("vt_log_queue_depth ");
+    appendNumber(out, Logger::GetInstance().GetQueueDepth());
+    out.push_back('\n');
+
+    appendHeader(out, "vt_metrics_scrapes_total", "Scrapes answered.", "counter");
+    out.append("vt_metrics_scrapes_total ");
+    appendNumber(out, scrapes.load(std::memory_order_relaxed));
+    out.push_back('\n');
+}
+
+/**
+ * @brief Answers one scrape with the last rendered page.
+ *
+ * Any request is answered (an HTTP GET, or a bare newline from a socket tool);
+ * a client that sends nothing gets the page after kClientTimeoutUs.
+ *
+ * @param client The accepted connection.
+ */
+void MetricsExporter::serve(int client) {
+    const timeval timeout{0, kClientTimeoutUs};
+    setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+    setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+    char request[2048];
+    std::size_t used = 0;
+    while (used < sizeof(request)) {
+        const ssize_t received = recv(client, request + used, sizeof(request) - used, 0);
+        if (received <= 0) {
+            break;
+        }
+        used += static_cast<std::size_t>(received);
+        const std::string_view head(request, used);
+        if (head.find("\r\n\r\n") != std::string_view::npos || head.find("\n\n") != std::string_view::npos ||
+            head == "\n") {
+            break;
+        }
+    }
+
+    std::string header = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+                         "Connection: close\r\nContent-Length: ";
+    appendNumber(header, static_cast<std::uint64_t>(page.size()));
+    header.append("\r\n\r\n");
+    if (sendAll(client, header.data(), header.size()) && sendAll(client, page.data(), page.size())) {
+        scrapes.fetch_add(1, std::memory_order_relaxed);
+    }
+}
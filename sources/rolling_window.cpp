@@ -0,0 +1,201 @@
+#include "../headers/rolling_window.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "../headers/checkpoint.hpp"
+
+namespace {
+constexpr double kNotReady = std::numeric_limits<double>::quiet_NaN();
+}
+
+/**
+ * @brief Constructor for the RollingWindows class; allocates every window's rings.
+ *
+ * @param windowCount Number of independent windows.
+ * @param length Samples per window (at least 1).
+ */
+RollingWindows::RollingWindows(std::size_t windowCount, std::uint32_t length)
+    : windowLength(length == 0 ? 1 : length),
+      states(windowCount),
+      values(windowCount * windowLength),
+      timestamps(windowCount * windowLength),
+      minQueue(windowCount * windowLength),
+      maxQueue(windowCount * windowLength) {}
+
+/**
+ * @brief Appends a sample to a window and updates its statistics.
+ *
+ * @param window Index of the window.
+ * @param timestampNs Time of the sample; must not be earlier than the previous one.
+ * @param value The sample.
+ */
+void RollingWindows::push(std::size_t window, std::uint64_t timestampNs, double value) {
+    State& state = states[window];
+    double* ring = values.data() + base(window);
+    std::uint64_t* minRing = minQueue.data() + base(window);
+    std::uint64_t* maxRing = maxQueue.data() + base(window);
+    const std::uint64_t sample = state.pushed;
+    const std::size_t slot = static_cast<std::size_t>(sample % windowLength);
+
+    if (sample >= windowLength) {
+        // Replace the oldest sample, which shares the new sample's slot
+        const double evicted = ring[slot];
+        const double previousMean = state.mean;
+        state.mean += (value - evicted) / windowLength;
+        state.m2 += (value - evicted) * (value - state.mean + evicted - previousMean);
+        const std::uint64_t oldest = sample - windowLength;
+        if (minRing[state.minHead % windowLength] == oldest) {
+            ++state.minHead;
+        }
+        if (maxRing[state.maxHead % windowLength] == oldest) {
+            ++state.maxHead;
+        }
+    } else {
+        const double delta = value - state.mean;
+        state.mean += delta / static_cast<double>(sample + 1);
+        state.m2 += delta * (value - state.mean);
+    }
+    ring[slot] = value;
+    timestamps[base(window) + slot] = timestampNs;
+
+    while (state.minTail > state.minHead && ring[minRing[(state.minTail - 1) % windowLength] % windowLength] >= value) {
+        --state.minTail;
+    }
+    minRing[state.minTail++ % windowLength] = sample;
+    while (state.maxTail > state.maxHead && ring[maxRing[(state.maxTail - 1) % windowLength] % windowLength] <= value) {
+        --state.maxTail;
+    }
+    maxRing[state.maxTail++ % windowLength] = sample;
+
+    state.pushed = sample + 1;
+}
+
+/**
+ * @brief Empties a window; its statistics read NaN until it fills again.
+ *
+ * @param window Index of the window.
+ */
+void RollingWindows::reset(std::size_t window) {
+    states[window] = State();
+}
+
+/**
+ * @brief Gets the mean of a window.
+ *
+ * @param window Index of the window.
+ * @return The mean, or NaN if the window has not filled yet.
+ */
+double RollingWindows::mean(std::size_t window) const {
+    return full(window) ? states[window].mean : kNotReady;
+}
+
+/**
+ * @brief Gets the population variance of a window.
+ *
+ * @param window Index of the window.
+ * @return The variance, or NaN if the window has not filled yet.
+ */
+double RollingWindows::variance(std::size_t window) const {
+    if (!full(window)) {
+        return kNotReady;
+    }
+    // The sliding update can leave a tiny negative residue for constant input
+    const double variance = states[window].m2 / windowLength;
+    return variance > 0.0 ? variance : 0.0;
+}
+
+/**
+ * @brief Gets the standard deviation of a window.
+ *
+ * @param window Index of the window.
+ * @return The standard deviation, or NaN if the window has not filled yet.
+ */
+double RollingWindows::stddev(std::size_t window) const {
+    return std::sqrt(variance(window));
+}
+
+/**
+ * @brief Gets the smallest sample in a window.
+ *
+ * @param window Index of the window.
+ * @return The minimum, or NaN if the window has not filled yet.
+ */
+double RollingWindows::min(std::size_t window) const {
+    if (!full(window)) {
+        return kNotReady;
+    }
+    const State& state = states[window];
+    return values[base(window) + minQueue[base(window) + state.minHead % windowLength] % windowLength];
+}
+
+/**
+ * @brief Gets the largest sample in a window.
+ *
+ * @param window Index of the window.
+ * @return The maximum, or NaN if the window has not filled yet.
+ */
+double RollingWindows::max(std::size_t window) const {
+    if (!full(window)) {
+        return kNotReady;
+    }
+    const State& state = states[window];
+    return values[base(window) + maxQueue[base(window) + state.maxHead % windowLength] % windowLength];
+}
+
+/**
+ * @brief Gets the average rate of change across a window.
+ *
+ * @param window Index of the window.
+ * @return (newest - oldest) per second of elapsed time; NaN if the window has not
+ *         filled yet or its samples share one timestamp.
+ */
+double RollingWindows::rate(std::size_t window) const {
+    const State& state = states[window];
+    if (!full(window) || windowLength < 2) {
+        return kNotReady;
+    }
+    const std::size_t newest = base(window) + static_cast<std::size_t>((state.pushed - 1) % windowLength);
+    const std::size_t oldest = base(window) + static_cast<std::size_t>(state.pushed % windowLength);
+    const std::uint64_t elapsedNs = timestamps[newest] - timestamps[oldest];
+    if (elapsedNs == 0) {
+        return kNotReady;
+    }
+    return (values[newest] - values[oldest]) * 1e9 / static_cast<double>(elapsedNs);
+}
+
+/**
+ * @brief Gets the memory held by the pool.
+ *
+ * @return Bytes allocated for window state and rings.
+ */
+std::size_t RollingWindows::memoryBytes() const {
+    return states.size() * sizeof(State) + values.size() * sizeof(double) +
+           (timestamps.size() + minQueue.size() + maxQueue.size()) * sizeof(std::uint64_t);
+}
+
+/**
+ * @brief Writes every window's rings, deques and statistics to a checkpoint.
+ *
+ * @param writer The checkpoint being written.
+ */
+void RollingWindows::saveState(CheckpointWriter& writer) const {
+    writer.write("window.states", states);
+    writer.write("window.values", values);
+    writer.write("window.timestamps", timestamps);
+    writer.write("window.min_queue", minQueue);
+    writer.write("window.max_queue", maxQueue);
+}
+
+/**
+ * @brief Reads back the state written by saveState() into a pool of the same window count and length.
+ *
+ * @param reader The checkpoint being read.
+ */
+void RollingWindows::restoreState(CheckpointReader& reader) {
+    reader.read("window.states", states);
+    reader.read("window.values", values);
+    reader.read("window.timestamps", timestamps);
+    reader.read("window.min_queue", minQueue);
+    reader.read("window.max_queue", maxQueue);
+}
@@ -0,0 +1,581 @@
+#include "../headers/rule_engine.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include "../headers/checkpoint.hpp"
+#include "../headers/fleet.hpp"
+#include "../headers/telemetry_format.hpp"
+#include "../headers/vehicle_model.hpp"
+
+namespace {
+using CompiledRule = RuleSet::CompiledRule;
+
+bool exceeds(const CompiledRule& rule, double value, double limit) {
+    if (rule.above) {
+        return rule.inclusive ? value >= limit : value > limit;
+    }
+    return rule.inclusive ? value <= limit : value < limit;
+}
+
+const char* comparatorText(Comparator comparator) {
+    switch (comparator) {
+        case Comparator::Greater: return ">";
+        case Comparator::GreaterEqual: return ">=";
+        case Comparator::Less: return "<";
+        case Comparator::LessEqual: return "<=";
+    }
+    return "?";
+}
+
+bool parseComparator(const std::string& text, Comparator& comparator) {
+    for (Comparator candidate : {Comparator::Greater, Comparator::GreaterEqual, Comparator::Less, Comparator::LessEqual}) {
+        if (text == comparatorText(candidate)) {
+            comparator = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseAggregate(const std::string& text, Aggregate& aggregate) {
+    for (Aggregate candidate : {Aggregate::Mean, Aggregate::Variance, Aggregate::StdDev, Aggregate::Min, Aggregate::Max,
+                                Aggregate::Rate, Aggregate::Ewma}) {
+        if (text == aggregateName(candidate)) {
+            aggregate = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseSeverity(const std::string& text, Severity& severity) {
+    for (Severity candidate : {Severity::Info, Severity::Warning, Severity::Critical}) {
+        if (text == severityName(candidate)) {
+            severity = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+/// Advances one rule's state by one reading.
+/// @return true if the rule was raised or cleared by this reading.
+template <typename State>
+inline bool step(const CompiledRule& rule, State& state, double value) {
+    const bool condition = state.active ? !exceeds(rule, value, rule.clearLimit) : exceeds(rule, value, rule.raiseLimit);
+    state.counter = condition ? state.counter + 1 : 0;
+    if (state.counter < rule.debounce) {
+        return false;
+    }
+    state.active ^= 1;
+    state.counter = 0;
+    return true;
+}
+
+/// Parses a whole token as a number; std::stod alone accepts trailing garbage.
+double parseNumber(const std::string& text, const char* what) {
+    std::size_t consumed = 0;
+    double value = 0.0;
+    try {
+        value = std::stod(text, &consumed);
+    } catch (const std::exception&) {
+        consumed = 0;
+    }
+    if (consumed == 0 || consumed != text.size()) {
+        throw std::runtime_error(std::string("invalid ") + what + " '" + text + "'");
+    }
+    return value;
+}
+
+/// Parses "<signal>" or "<signal>:<aggregate>(<n>)" into the input fields of a rule.
+void parseInput(const std::string& text, RuleSpec& spec) {
+    const std::size_t colon = text.find(':');
+    const std::string signalText = text.substr(0, colon);
+    if (!parseSignalKey(signalText, spec.signal)) {
+        throw std::runtime_error("unknown signal '" + signalText + "'");
+    }
+    if (colon == std::string::npos) {
+        return;
+    }
+
+    const std::size_t open = text.find('(', colon);
+    if (open == std::string::npos || text.back() != ')') {
+        throw std::runtime_error("expected <aggregate>(<n>) after '" + signalText + ":'");
+    }
+    const std::string name = text.substr(colon + 1, open - colon - 1);
+    if (!parseAggregate(name, spec.aggregate)) {
+        throw std::runtime_error("unknown aggregate '" + name + "'");
+    }
+    const double parameter = parseNumber(text.substr(open + 1, text.size() - open - 2), "aggregate parameter");
+    if (spec.aggregate == Aggregate::Ewma) {
+        if (!(parameter > 0.0 && parameter <= 1.0)) {
+            throw std::runtime_error("ewma smoothing factor must be in (0, 1]");
+        }
+        spec.alpha = parameter;
+    } else {
+        const std::uint32_t minimum = spec.aggregate == Aggregate::Rate ? 2 : 1;
+        if (parameter < minimum || parameter > 1000000.0 || parameter != static_cast<std::uint32_t>(parameter)) {
+            throw std::runtime_error(std::string(aggregateName(spec.aggregate)) +
+                                     " window must be an integer from " + std::to_string(minimum) + " to 1000000");
+        }
+        spec.window = static_cast<std::uint32_t>(parameter);
+    }
+}
+}
+
+/**
+ * @brief Gets the configuration name of a severity.
+ *
+ * @param severity The severity.
+ * @return A static lowercase string.
+ */
+const char* severityName(Severity severity) {
+    switch (severity) {
+        case Severity::Info: return "info";
+        case Severity::Warning: return "warning";
+        case Severity::Critical: return "critical";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Gets the rules file name of an aggregate.
+ *
+ * @param aggregate The aggregate.
+ * @return A static lowercase string.
+ */
+const char* aggregateName(Aggregate aggregate) {
+    switch (aggregate) {
+        case Aggregate::Value: return "value";
+        case Aggregate::Mean: return "mean";
+        case Aggregate::Variance: return "variance";
+        case Aggregate::StdDev: return "stddev";
+        case Aggregate::Min: return "min";
+        case Aggregate::Max: return "max";
+        case Aggregate::Rate: return "rate";
+        case Aggregate::Ewma: return "ewma";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Names what a rule compares, for reports.
+ *
+ * @param spec The rule.
+ * @return The signal's display name, followed by the aggregate and its parameter if any.
+ */
+std::string ruleInputName(const RuleSpec& spec) {
+    std::ostringstream name;
+    name << signalName(spec.signal);
+    if (spec.aggregate == Aggregate::Ewma) {
+        name << " ewma(" << spec.alpha << ')';
+    } else if (spec.aggregate != Aggregate::Value) {
+        name << ' ' << aggregateName(spec.aggregate) << '(' << spec.window << ')';
+    }
+    return name.str();
+}
+
+/**
+ * @brief Constructor for the RuleSet class; compiles the rules into the evaluation table.
+ *
+ * Rules aggregating the same signal over the same window length share one
+ * window, and rules on the same moving average share it too.
+ *
+ * @param specs The rules, in evaluation and reporting order.
+ */
+RuleSet::RuleSet(std::vector<RuleSpec> specs) : specs(std::move(specs)) {
+    compiled.reserve(this->specs.size());
+    for (const RuleSpec& spec : this->specs) {
+        const bool above = spec.comparator == Comparator::Greater || spec.comparator == Comparator::GreaterEqual;
+        const bool inclusive = spec.comparator == Comparator::GreaterEqual || spec.comparator == Comparator::LessEqual;
+        const double clearLimit = above ? spec.limit - spec.hysteresis : spec.limit + spec.hysteresis;
+
+        std::size_t source = 0;
+        if (spec.aggregate == Aggregate::Ewma) {
+            while (source < ewmaSpecs.size() &&
+                   (ewmaSpecs[source].signal != spec.signal || ewmaSpecs[source].alpha != spec.alpha)) {
+                ++source;
+            }
+            if (source == ewmaSpecs.size()) {
+                ewmaSpecs.push_back(EwmaSpec{spec.signal, spec.alpha});
+            }
+        } else if (spec.aggregate != Aggregate::Value) {
+            const std::uint32_t length = spec.window == 0 ? 1u : spec.window;
+            while (source < windowSpecs.size() &&
+                   (windowSpecs[source].signal != spec.signal || windowSpecs[source].length != length)) {
+                ++source;
+            }
+            if (source == windowSpecs.size()) {
+                windowSpecs.push_back(WindowSpec{spec.signal, length});
+            }
+        }
+        compiled.push_back(CompiledRule{spec.signal, spec.aggregate, static_cast<std::uint32_t>(source), above,
+                                        inclusive, spec.limit, clearLimit, spec.debounce == 0 ? 1u : spec.debounce});
+    }
+}
+
+/**
+ * @brief Checks whether any rule aggregates a signal.
+ *
+ * @param signal The signal.
+ * @return true if the rules need every sample of the signal, not just the latest.
+ */
+bool RuleSet::aggregates(Signal signal) const {
+    for (const WindowSpec& window : windowSpecs) {
+        if (window.signal == signal) {
+            return true;
+        }
+    }
+    for (const EwmaSpec& ewma : ewmaSpecs) {
+        if (ewma.signal == signal) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Fingerprints the rules, e.g. to check that a checkpoint is restored under the same rules.
+ *
+ * @return CRC32 over every rule's fields in order, doubles by their bits.
+ */
+std::uint32_t RuleSet::fingerprint() const {
+    std::string bytes;
+    auto append = [&bytes](const auto& field) {
+        char raw[sizeof(field)];
+        std::memcpy(raw, &field, sizeof(field));
+        bytes.append(raw, sizeof(field));
+    };
+    for (const RuleSpec& spec : specs) {
+        append(spec.signal);
+        append(spec.aggregate);
+        append(spec.window);
+        append(spec.alpha);
+        append(spec.comparator);
+        append(spec.limit);
+        append(spec.hysteresis);
+        append(spec.debounce);
+        append(spec.severity);
+        bytes += spec.message;
+        bytes += '\0';
+    }
+    return crc32(bytes.data(), bytes.size());
+}
+
+/**
+ * @brief Builds the rule set equivalent to the built-in diagnostic checks.
+ *
+ * @return One warning rule per entry of vehicle_model::kDiagnosticChecks.
+ */
+RuleSet RuleSet::defaults() {
+    std::vector<RuleSpec> specs;
+    for (const vehicle_model::DiagnosticCheck& check : vehicle_model::kDiagnosticChecks) {
+        RuleSpec spec;
+        spec.signal = check.signal;
+        spec.comparator = check.warnAbove ? Comparator::Greater : Comparator::Less;
+        spec.limit = check.threshold;
+        spec.message = check.warningMessage;
+        specs.push_back(spec);
+    }
+    return RuleSet(std::move(specs));
+}
+
+/**
+ * @brief Loads and compiles a rules file.
+ *
+ * @param filePath Path to the rules file.
+ * @return The compiled rules.
+ */
+RuleSet RuleSet::fromFile(const std::string& filePath) {
+    std::ifstream file(filePath);
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open rules file: " + filePath);
+    }
+    return parse(file, filePath);
+}
+
+/**
+ * @brief Parses rules in the rules file format.
+ *
+ * @param input The text to parse.
+ * @param sourceName Name used in error messages.
+ * @return The compiled rules.
+ */
+RuleSet RuleSet::parse(std::istream& input, const std::string& sourceName) {
+    std::vector<RuleSpec> specs;
+    std::string line;
+    for (std::size_t lineNumber = 1; std::getline(input, line); ++lineNumber) {
+        const std::size_t comment = line.find('#');
+        if (comment != std::string::npos) {
+            line.erase(comment);
+        }
+        std::istringstream tokens(line);
+        std::string signalText;
+        if (!(tokens >> signalText)) {
+            continue;
+        }
+
+        try {
+            RuleSpec spec;
+            std::string comparatorToken;
+            std::string limitToken;
+            parseInput(signalText, spec);
+            if (!(tokens >> comparatorToken) || !parseComparator(comparatorToken, spec.comparator)) {
+                throw std::runtime_error("expected a comparator (> >= < <=)");
+            }
+            if (!(tokens >> limitToken)) {
+                throw std::runtime_error("expected a limit");
+            }
+            spec.limit = parseNumber(limitToken, "limit");
+
+            std::string word;
+            while (tokens >> word) {
+                const std::size_t equals = word.find('=');
+                const std::string key = equals == std::string::npos ? "" : word.substr(0, equals);
+                const std::string value = equals == std::string::npos ? "" : word.substr(equals + 1);
+                if (key == "hysteresis") {
+                    spec.hysteresis = parseNumber(value, "hysteresis");
+                    if (spec.hysteresis < 0.0) {
+                        throw std::runtime_error("hysteresis must not be negative");
+                    }
+                } else if (key == "debounce") {
+                    const double debounce = parseNumber(value, "debounce");
+                    if (debounce < 1.0 || debounce != static_cast<std::uint32_t>(debounce)) {
+                        throw std::runtime_error("debounce must be a positive integer");
+                    }
+                    spec.debounce = static_cast<std::uint32_t>(debounce);
+                } else if (key == "severity") {
+                    if (!parseSeverity(value, spec.severity)) {
+                        throw std::runtime_error("unknown severity '" + value + "'");
+                    }
+                } else {
+                    // The rest of the line is the message
+                    std::string rest;
+                    std::getline(tokens, rest);
+                    spec.message = word + rest;
+                    break;
+                }
+            }
+            if (spec.message.empty()) {
+                std::ostringstream message;
+                message << ruleInputName(spec) << ' ' << comparatorToken << ' ' << limitToken;
+                spec.message = message.str();
+            }
+            specs.push_back(std::move(spec));
+        } catch (const std::runtime_error& e) {
+            throw std::runtime_error(sourceName + ":" + std::to_string(lineNumber) + ": " + e.what());
+        }
+    }
+    return RuleSet(std::move(specs));
+}
+
+/**
+ * @brief Constructor for the RuleEngine class; every rule starts cleared for every vehicle.
+ *
+ * The windows of aggregated rules are allocated here, one per vehicle, and start empty.
+ *
+ * @param rules The rules to evaluate.
+ * @param vehicleCount Number of vehicles to keep rule state for.
+ */
+RuleEngine::RuleEngine(RuleSet rules, std::size_t vehicleCount)
+    : ruleSet(std::move(rules)), vehicles(vehicleCount), states(ruleSet.size() * vehicleCount),
+      ewmas(ruleSet.ewmas().size() * vehicleCount) {
+    windows.reserve(ruleSet.windows().size());
+    for (const RuleSet::WindowSpec& window : ruleSet.windows()) {
+        windows.emplace_back(vehicleCount, window.length);
+    }
+}
+
+/**
+ * @brief Feeds a sample to every window and moving average over its signal.
+ *
+ * @param vehicle Index of the vehicle; must be below vehicleCount().
+ * @param signal The sampled signal.
+ * @param timestampNs Time of the sample; must not be earlier than the signal's previous sample.
+ * @param value The reading.
+ */
+void RuleEngine::observe(std::uint32_t vehicle, Signal signal, std::uint64_t timestampNs, double value) {
+    const std::vector<RuleSet::WindowSpec>& windowSpecs = ruleSet.windows();
+    for (std::size_t w = 0; w < windowSpecs.size(); ++w) {
+        if (windowSpecs[w].signal == signal) {
+            windows[w].push(vehicle, timestampNs, value);
+        }
+    }
+    const std::vector<RuleSet::EwmaSpec>& ewmaSpecs = ruleSet.ewmas();
+    for (std::size_t e = 0; e < ewmaSpecs.size(); ++e) {
+        if (ewmaSpecs[e].signal == signal) {
+            ewmas[e * vehicles + vehicle].push(value, ewmaSpecs[e].alpha);
+        }
+    }
+}
+
+/**
+ * @brief Reads an aggregated rule's input for one vehicle.
+ *
+ * @param rule The rule; must not compare the plain value.
+ * @param vehicle Index of the vehicle.
+ * @return The aggregate; NaN while the window is filling or before the first sample,
+ *         which no comparison exceeds.
+ */
+double RuleEngine::aggregateValue(const CompiledRule& rule, std::uint32_t vehicle) const {
+    const RollingWindows& window = windows[rule.source];
+    switch (rule.aggregate) {
+        case Aggregate::Mean: return window.mean(vehicle);
+        case Aggregate::Variance: return window.variance(vehicle);
+        case Aggregate::StdDev: return window.stddev(vehicle);
+        case Aggregate::Min: return window.min(vehicle);
+        case Aggregate::Max: return window.max(vehicle);
+        case Aggregate::Rate: return window.rate(vehicle);
+        case Aggregate::Ewma: {
+            const Ewma& ewma = ewmas[rule.source * vehicles + vehicle];
+            return ewma.seeded ? ewma.value : std::numeric_limits<double>::quiet_NaN();
+        }
+        case Aggregate::Value: break;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+/**
+ * @brief Evaluates every rule for one vehicle, appending any transitions.
+ *
+ * @param vehicle Index of the vehicle; must be below vehicleCount().
+ * @param values Current readings indexed by Signal.
+ * @param events Receives one event per rule that was raised or cleared.
+ */
+void RuleEngine::evaluate(std::uint32_t vehicle, const double (&values)[kSignalCount], std::vector<RuleEvent>& events) {
+    const std::vector<CompiledRule>& table = ruleSet.table();
+    for (std::size_t r = 0; r < table.size(); ++r) {
+        RuleState& state = states[r * vehicles + vehicle];
+        const double value = table[r].aggregate == Aggregate::Value ? values[static_cast<std::size_t>(table[r].signal)]
+                                                                    : aggregateValue(table[r], vehicle);
+        if (step(table[r], state, value)) {
+            events.push_back(RuleEvent{vehicle, static_cast<std::uint32_t>(r), state.active != 0, value});
+        }
+    }
+}
+
+/**
+ * @brief Evaluates every rule for a range of fleet vehicles, appending any transitions.
+ *
+ * @param fleet The fleet to read; must not have more vehicles than vehicleCount().
+ * @param begin First vehicle of the range.
+ * @param end One past the last vehicle of the range.
+ * @param timestampNs Time of the current readings, fed to the windows of aggregated rules.
+ * @param events Receives one event per rule and vehicle that was raised or cleared.
+ */
+void RuleEngine::evaluateBatch(const Fleet& fleet, std::size_t begin, std::size_t end, std::uint64_t timestampNs,
+                               std::vector<RuleEvent>& events) {
+    const std::vector<int>& gear = fleet.columns().gear;
+    const std::vector<RuleSet::WindowSpec>& windowSpecs = ruleSet.windows();
+    for (std::size_t w = 0; w < windowSpecs.size(); ++w) {
+        const std::vector<double>* column = fleet.column(windowSpecs[w].signal);
+        for (std::size_t i = begin; i < end; ++i) {
+            windows[w].push(i, timestampNs, column ? (*column)[i] : static_cast<double>(gear[i]));
+        }
+    }
+    const std::vector<RuleSet::EwmaSpec>& ewmaSpecs = ruleSet.ewmas();
+    for (std::size_t e = 0; e < ewmaSpecs.size(); ++e) {
+        const std::vector<double>* column = fleet.column(ewmaSpecs[e].signal);
+        Ewma* averages = ewmas.data() + e * vehicles;
+        for (std::size_t i = begin; i < end; ++i) {
+            averages[i].push(column ? (*column)[i] : static_cast<double>(gear[i]), ewmaSpecs[e].alpha);
+        }
+    }
+
+    const std::vector<CompiledRule>& table = ruleSet.table();
+    for (std::size_t r = 0; r < table.size(); ++r) {
+        const CompiledRule& rule = table[r];
+        RuleState* ruleStates = states.data() + r * vehicles;
+        if (rule.aggregate != Aggregate::Value) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const std::uint32_t vehicle = static_cast<std::uint32_t>(i);
+                const double value = aggregateValue(rule, vehicle);
+                if (step(rule, ruleStates[i], value)) {
+                    events.push_back(RuleEvent{vehicle, static_cast<std::uint32_t>(r), ruleStates[i].active != 0, value});
+                }
+            }
+            continue;
+        }
+        const std::vector<double>* column = fleet.column(rule.signal);
+        for (std::size_t i = begin; i < end; ++i) {
+            const double value = column ? (*column)[i] : static_cast<double>(gear[i]);
+            if (step(rule, ruleStates[i], value)) {
+                events.push_back(RuleEvent{static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(r),
+                                           ruleStates[i].active != 0, value});
+            }
+        }
+    }
+}
+
+/**
+ * @brief Gets the memory held for aggregated rules.
+ *
+ * @return Bytes of window rings, window state and moving averages across all vehicles.
+ */
+std::size_t RuleEngine::aggregateMemoryBytes() const {
+    std::size_t total = ewmas.size() * sizeof(Ewma);
+    for (const RollingWindows& window : windows) {
+        total += window.memoryBytes();
+    }
+    return total;
+}
+
+/**
+ * @brief Writes every vehicle's rule states, windows and moving averages to a checkpoint.
+ *
+ * Structs with padding are split into one array per field, so the image has no undefined bytes.
+ *
+ * @param writer The checkpoint being written.
+ */
+void RuleEngine::saveState(CheckpointWriter& writer) const {
+    std::vector<std::uint32_t> counters(states.size());
+    std::vector<std::uint8_t> active(states.size());
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        counters[i] = states[i].counter;
+        active[i] = states[i].active;
+    }
+    writer.write("rules.counter", counters);
+    writer.write("rules.active", active);
+    for (const RollingWindows& window : windows) {
+        window.saveState(writer);
+    }
+    std::vector<double> ewmaValues(ewmas.size());
+    std::vector<std::uint8_t> ewmaSeeded(ewmas.size());
+    for (std::size_t i = 0; i < ewmas.size(); ++i) {
+        ewmaValues[i] = ewmas[i].value;
+        ewmaSeeded[i] = ewmas[i].seeded;
+    }
+    writer.write("ewma.value", ewmaValues);
+    writer.write("ewma.seeded", ewmaSeeded);
+}
+
+/**
+ * @brief Reads back the state written by saveState() into an engine with the same rules and vehicle count.
+ *
+ * @param reader The checkpoint being read.
+ */
+void RuleEngine::restoreState(CheckpointReader& reader) {
+    std::vector<std::uint32_t> counters(states.size());
+    std::vector<std::uint8_t> active(states.size());
+    reader.read("rules.counter", counters);
+    reader.read("rules.active", active);
+    for (std::size_t i = 0; i < states.size(); ++i) {
+        states[i].counter = counters[i];
+        states[i].active = active[i];
+    }
+    for (RollingWindows& window : windows) {
+        window.restoreState(reader);
+    }
+    std::vector<double> ewmaValues(ewmas.size());
+    std::vector<std::uint8_t> ewmaSeeded(ewmas.size());
+    reader.read("ewma.value", ewmaValues);
+    reader.read("ewma.seeded", ewmaSeeded);
+    for (std::size_t i = 0; i < ewmas.size(); ++i) {
+        ewmas[i].value = ewmaValues[i];
+        ewmas[i].seeded = ewmaSeeded[i] != 0;
+    }
+}
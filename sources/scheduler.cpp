@@ -0,0 +1,214 @@
+#include "../headers/scheduler.hpp"
+
+#include <algorithm>
+#include <iomanip>
+#include <thread>
+
+/**
+ * @brief Registers a periodic task.
+ *
+ * @param name Name used in the statistics report.
+ * @param period Time between activations; must be positive.
+ * @param body The work to run at each activation.
+ * @param policy What to do when the task falls behind.
+ * @param phase Offset of the first activation from the scheduler's start; for a task added
+ *              once the scheduler has started, from the scheduler's current (real or virtual) time.
+ * @return The task's identifier, for reading its statistics.
+ */
+TaskScheduler::TaskId TaskScheduler::addTask(const std::string& name, std::chrono::nanoseconds period,
+                                             std::function<void()> body, MissPolicy policy,
+                                             std::chrono::nanoseconds phase) {
+    Task task{name, period, phase, std::move(body), policy, Clock::time_point(), TaskStats()};
+    if (started) {
+        task.nextDeadline = now() + phase;
+    }
+    tasks.push_back(std::move(task));
+    return tasks.size() - 1;
+}
+
+/**
+ * @brief Runs tasks until the stop flag is set.
+ *
+ * @param stop Flag checked before every activation; may be set from another thread or a signal handler.
+ */
+void TaskScheduler::run(const std::atomic<bool>& stop) {
+    start(Clock::now());
+    while (runNext(&stop, Clock::time_point::max())) {
+    }
+}
+
+/**
+ * @brief Runs tasks for a fixed amount of time.
+ *
+ * @param duration How long to run, measured from the first call that started the scheduler.
+ */
+void TaskScheduler::runFor(std::chrono::nanoseconds duration) {
+    start(Clock::now());
+    const Clock::time_point end = Clock::now() + duration;
+    while (runNext(nullptr, end)) {
+    }
+}
+
+/**
+ * @brief Runs every activation due up to a point in virtual time, back to back.
+ *
+ * @param virtualTime Virtual time to advance to, measured from the virtual start of zero.
+ */
+void TaskScheduler::advanceTo(std::chrono::nanoseconds virtualTime) {
+    if (!started) {
+        virtualClock = true;
+    }
+    start(Clock::time_point());
+    const Clock::time_point end = startTime + virtualTime;
+    if (tasks.empty()) {
+        virtualNow = end;
+        return;
+    }
+    for (;;) {
+        Task& task = tasks[earliestTask()];
+        const Clock::time_point deadline = task.nextDeadline;
+        if (deadline > end) {
+            virtualNow = end;
+            return;
+        }
+        virtualNow = deadline;
+        execute(task, deadline);
+        task.nextDeadline = deadline + task.period;
+    }
+}
+
+/**
+ * @brief Prints the counters of every task.
+ *
+ * @param os The output stream to write to.
+ */
+void TaskScheduler::printStats(std::ostream& os) const {
+    os << std::left << std::setw(14) << "task" << std::right
+       << std::setw(10) << "runs" << std::setw(10) << "overruns" << std::setw(10) << "skipped"
+       << std::setw(14) << "jitter avg us" << std::setw(14) << "jitter max us" << std::setw(12) << "run max us" << '\n';
+    for (const Task& task : tasks) {
+        os << std::left << std::setw(14) << task.name << std::right
+           << std::setw(10) << task.stats.runs << std::setw(10) << task.stats.overruns
+           << std::setw(10) << task.stats.skipped
+           << std::fixed << std::setprecision(1)
+           << std::setw(14) << task.stats.meanJitterNs() / 1000.0
+           << std::setw(14) << task.stats.maxJitterNs / 1000.0
+           << std::setw(12) << task.stats.maxDurationNs / 1000.0 << '\n';
+    }
+}
+
+/**
+ * @brief Gets the scheduler's current time.
+ *
+ * @return The clock's time, or in virtual time the latest deadline or advanceTo() target reached.
+ */
+TaskScheduler::Clock::time_point TaskScheduler::now() const {
+    return virtualClock ? virtualNow : Clock::now();
+}
+
+/**
+ * @brief Fixes the scheduler's time origin and every task's first deadline, once.
+ *
+ * @param origin The start time: now for real time, the clock's epoch for virtual time.
+ */
+void TaskScheduler::start(Clock::time_point origin) {
+    if (started) {
+        return;
+    }
+    startTime = origin;
+    for (Task& task : tasks) {
+        task.nextDeadline = startTime + task.phase;
+    }
+    started = true;
+}
+
+/**
+ * @brief Waits for the earliest deadline and runs that task once.
+ *
+ * @param stop Optional stop flag.
+ * @param end Time after which no further activation is started.
+ * @return false when there is nothing left to run before end, or stop was requested.
+ */
+bool TaskScheduler::runNext(const std::atomic<bool>* stop, Clock::time_point end) {
+    if (tasks.empty() || (stop != nullptr && stop->load(std::memory_order_relaxed))) {
+        return false;
+    }
+
+    Task& task = tasks[earliestTask()];
+    const Clock::time_point deadline = task.nextDeadline;
+    if (deadline >= end) {
+        sleepUntil(end);
+        return false;
+    }
+
+    sleepUntil(deadline);
+    if (stop != nullptr && stop->load(std::memory_order_relaxed)) {
+        return false;
+    }
+
+    const Clock::time_point finish = execute(task, deadline);
+
+    TaskStats& stats = task.stats;
+    task.nextDeadline = deadline + task.period;
+    if (finish > task.nextDeadline) {
+        ++stats.overruns;
+        // Deadlines that have already passed, including nextDeadline itself
+        const std::int64_t behind = (finish - task.nextDeadline) / task.period + 1;
+        if (task.policy == MissPolicy::Skip || behind > kMaxCatchUpPeriods) {
+            task.nextDeadline += behind * task.period;
+            stats.skipped += static_cast<std::uint64_t>(behind);
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Finds the task with the earliest deadline; ties go to the task registered first.
+ *
+ * @return Index of the task; the task list must not be empty.
+ */
+std::size_t TaskScheduler::earliestTask() const {
+    std::size_t next = 0;
+    for (std::size_t i = 1; i < tasks.size(); ++i) {
+        if (tasks[i].nextDeadline < tasks[next].nextDeadline) {
+            next = i;
+        }
+    }
+    return next;
+}
+
+/**
+ * @brief Runs a task's body once and updates its run, jitter and duration counters.
+ *
+ * @param task The task to run.
+ * @param deadline The activation's deadline; jitter is only counted in real time.
+ * @return The wall-clock time the body finished.
+ */
+TaskScheduler::Clock::time_point TaskScheduler::execute(Task& task, Clock::time_point deadline) {
+    const Clock::time_point begin = Clock::now();
+    task.body();
+    const Clock::time_point finish = Clock::now();
+
+    TaskStats& stats = task.stats;
+    const std::int64_t durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(finish - begin).count();
+    ++stats.runs;
+    stats.totalDurationNs += durationNs;
+    stats.maxDurationNs = std::max(stats.maxDurationNs, durationNs);
+    if (!virtualClock) {
+        const std::int64_t jitterNs = std::chrono::duration_cast<std::chrono::nanoseconds>(begin - deadline).count();
+        stats.totalJitterNs += jitterNs;
+        stats.maxJitterNs = std::max(stats.maxJitterNs, jitterNs);
+    }
+    return finish;
+}
+
+/**
+ * @brief Blocks until the given time point.
+ *
+ * @param deadline The time to wake up.
+ */
+void TaskScheduler::sleepUntil(Clock::time_point deadline) {
+    if (deadline > Clock::now()) {
+        std::this_thread::sleep_until(deadline);
+    }
+}
@@ -0,0 +1,112 @@
+#include "../headers/sensor_recording.hpp"
+
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * @brief Constructor for the SensorRecorder class; creates the file and writes its header.
+ *
+ * @param filePath Path of the recording to create (replaced if it exists).
+ * @param bus The bus the sensors publish to; radar samples published from now on are recorded.
+ * @param period Time between frames (the radar period); the replay publishes frames at the same rate.
+ * @param seed Seed of the recorded run, stored for reference.
+ */
+SensorRecorder::SensorRecorder(const std::string& filePath, const SignalBus& bus, std::chrono::nanoseconds period,
+                               std::uint64_t seed)
+    : file(filePath, std::ios::binary | std::ios::trunc), bus(bus), pace(bus, kRecordingPaceSignal),
+      framePeriod(period) {
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to create recording: " + filePath);
+    }
+    const RecordingHeader header{kRecordingMagic, kRecordingFormatVersion, static_cast<std::uint16_t>(kRecordedSignalCount),
+                                 static_cast<std::uint64_t>(period.count()), seed, 0};
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+/**
+ * @brief Appends a frame per new radar sample, holding that sample and the latest value of every other signal.
+ */
+void SensorRecorder::record() {
+    pace.drain([this](const SignalSample& sample) {
+        RecordingFrame frame;
+        for (std::size_t i = 0; i < kRecordedSignalCount; ++i) {
+            frame.values[i] = kRecordedSignals[i] == kRecordingPaceSignal ? sample.value
+                                                                          : bus.latestValue(kRecordedSignals[i]);
+        }
+        file.write(reinterpret_cast<const char*>(&frame), sizeof(frame));
+        ++frames;
+    });
+}
+
+/**
+ * @brief Flushes and closes the recording.
+ */
+void SensorRecorder::close() {
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+/**
+ * @brief Constructor for the SensorReplay class; maps the recording read-only.
+ *
+ * @param filePath Path of the recording.
+ */
+SensorReplay::SensorReplay(const std::string& filePath) {
+    const int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open recording: " + filePath);
+    }
+    struct stat info {};
+    if (fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(RecordingHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a sensor recording: " + filePath);
+    }
+    size = static_cast<std::size_t>(info.st_size);
+    void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        throw std::runtime_error("Failed to map recording: " + filePath);
+    }
+    base = static_cast<const unsigned char*>(mapping);
+    // Frames are read front to back; let the kernel read ahead aggressively
+    madvise(mapping, size, MADV_SEQUENTIAL);
+
+    const RecordingHeader& h = header();
+    if (h.magic != kRecordingMagic || h.version != kRecordingFormatVersion || h.signalCount != kRecordedSignalCount ||
+        h.periodNs == 0) {
+        munmap(mapping, size);
+        throw std::runtime_error("Not a sensor recording: " + filePath);
+    }
+    frames = (size - sizeof(RecordingHeader)) / sizeof(RecordingFrame);
+}
+
+/**
+ * @brief Destructor for the SensorReplay class; unmaps the recording.
+ */
+SensorReplay::~SensorReplay() {
+    munmap(const_cast<unsigned char*>(base), size);
+}
+
+/**
+ * @brief Publishes the next frame's values to the bus and advances.
+ *
+ * @param bus The bus to publish to; the replay is then the bus's only sensor producer.
+ * @return false if the recording is exhausted (nothing is published).
+ */
+bool SensorReplay::publishNext(SignalBus& bus) {
+    const std::size_t index = cursor.load(std::memory_order_relaxed);
+    if (index >= frames) {
+        return false;
+    }
+    const RecordingFrame& next = frame(index);
+    const std::uint64_t now = bus.now();
+    for (std::size_t i = 0; i < kRecordedSignalCount; ++i) {
+        bus.publish(kRecordedSignals[i], next.values[i], now);
+    }
+    cursor.store(index + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,152 @@
+#include "../headers/shm_publisher.hpp"
+
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "../headers/fleet.hpp"
+
+/**
+ * @brief Constructor for the ShmPublisher class; creates and initializes the segment.
+ *
+ * An existing segment of the same name is replaced. Every vehicle slot starts
+ * unpublished (sequence 0) until its first publish.
+ *
+ * @param name POSIX shared memory name, e.g. "/vehicle-telemetry".
+ * @param vehicleCount Number of vehicle slots.
+ * @param rules The diagnostic rules whose active state is published; only the first kShmMaxWarnings are labelled.
+ */
+ShmPublisher::ShmPublisher(const std::string& name, std::size_t vehicleCount, const RuleSet& rules)
+    : segmentName(name), vehicles(vehicleCount), size(shmSegmentSize(vehicleCount)) {
+    shm_unlink(name.c_str());
+    const int fd = shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to create shared memory segment: " + name);
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        shm_unlink(name.c_str());
+        throw std::runtime_error("Failed to size shared memory segment: " + name);
+    }
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED) {
+        shm_unlink(name.c_str());
+        throw std::runtime_error("Failed to map shared memory segment: " + name);
+    }
+    base = static_cast<unsigned char*>(mapping);
+
+    // The new segment is zero-filled; construct the shared objects in place
+    header = new (base) ShmHeader{};
+    ShmWarningLabel* labels = reinterpret_cast<ShmWarningLabel*>(base + sizeof(ShmHeader));
+    const std::size_t warningCount = rules.size() < kShmMaxWarnings ? rules.size() : kShmMaxWarnings;
+    for (std::size_t r = 0; r < warningCount; ++r) {
+        const RuleSpec& spec = rules.spec(r);
+        labels[r].signal = static_cast<std::uint8_t>(spec.signal);
+        labels[r].severity = static_cast<std::uint8_t>(spec.severity);
+        std::strncpy(labels[r].message, spec.message.c_str(), sizeof(labels[r].message) - 1);
+    }
+    slots = reinterpret_cast<ShmVehicleSlot*>(base + sizeof(ShmHeader) + kShmMaxWarnings * sizeof(ShmWarningLabel));
+    for (std::size_t v = 0; v < vehicleCount; ++v) {
+        new (&slots[v]) ShmVehicleSlot{};
+    }
+
+    header->version = kShmFormatVersion;
+    header->signalCount = static_cast<std::uint16_t>(kSignalCount);
+    header->vehicleCount = static_cast<std::uint32_t>(vehicleCount);
+    header->warningCount = static_cast<std::uint32_t>(warningCount);
+    header->slotSize = sizeof(ShmVehicleSlot);
+    // Readers reject the segment until the magic is in place
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = kShmMagic;
+}
+
+/**
+ * @brief Destructor for the ShmPublisher class; unmaps and removes the segment.
+ *
+ * Readers that still have it mapped keep their mapping of the last state.
+ */
+ShmPublisher::~ShmPublisher() {
+    munmap(base, size);
+    shm_unlink(segmentName.c_str());
+}
+
+/**
+ * @brief Publishes one vehicle's state.
+ *
+ * @param slot Slot to write; must be below vehicleCount().
+ * @param vehicleId Identifier stored with the state.
+ * @param timestampNs Time of the state.
+ * @param state The readings and actuator states.
+ * @param rules The engine holding the vehicle's diagnostic rule state.
+ * @param engineVehicle Index of the vehicle in the rule engine.
+ */
+void ShmPublisher::publish(std::size_t slot, std::uint32_t vehicleId, std::uint64_t timestampNs,
+                           const VehicleState& state, const RuleEngine& rules, std::uint32_t engineVehicle) {
+    double values[kSignalCount];
+    toSignalValues(state, values);
+    write(slot, vehicleId, timestampNs, values, activeWarnings(rules, engineVehicle));
+    header->publishCount.fetch_add(1, std::memory_order_release);
+}
+
+/**
+ * @brief Publishes a range of fleet vehicles, vehicle i into slot i.
+ *
+ * Disjoint ranges may be published concurrently, e.g. from a TickEngine chunk observer.
+ *
+ * @param fleet The fleet to read.
+ * @param rules The engine holding the fleet's diagnostic rule state.
+ * @param begin First vehicle of the range.
+ * @param end One past the last vehicle of the range; must not exceed vehicleCount().
+ * @param timestampNs Time of the states.
+ */
+void ShmPublisher::publishFleet(const Fleet& fleet, const RuleEngine& rules, std::size_t begin, std::size_t end,
+                                std::uint64_t timestampNs) {
+    double values[kSignalCount];
+    for (std::size_t i = begin; i < end; ++i) {
+        toSignalValues(fleet.state(i), values);
+        const std::uint32_t id = static_cast<std::uint32_t>(i);
+        write(i, id, timestampNs, values, activeWarnings(rules, id));
+    }
+    header->publishCount.fetch_add(end - begin, std::memory_order_release);
+}
+
+/**
+ * @brief Writes one slot under its seqlock.
+ *
+ * @param slot Slot to write.
+ * @param vehicleId Identifier stored with the state.
+ * @param timestampNs Time of the state.
+ * @param values Readings indexed by Signal.
+ * @param warnings Bit i set while rule i is raised.
+ */
+void ShmPublisher::write(std::size_t slot, std::uint32_t vehicleId, std::uint64_t timestampNs, const double* values,
+                         std::uint64_t warnings) {
+    ShmVehicleSlot& target = slots[slot];
+    const std::uint64_t sequence = target.sequence.load(std::memory_order_relaxed);
+    target.sequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    target.vehicleId.store(vehicleId, std::memory_order_relaxed);
+    target.timestampNs.store(timestampNs, std::memory_order_relaxed);
+    target.activeWarnings.store(warnings, std::memory_order_relaxed);
+    for (std::size_t s = 0; s < kSignalCount; ++s) {
+        target.values[s].store(values[s], std::memory_order_relaxed);
+    }
+    target.sequence.store(sequence + 2, std::memory_order_release);
+}
+
+/**
+ * @brief Packs a vehicle's raised rules into a bit mask.
+ *
+ * @param rules The rule engine.
+ * @param vehicle Index of the vehicle in the engine.
+ * @return Bit i set while rule i is raised, for the first kShmMaxWarnings rules.
+ */
+std::uint64_t ShmPublisher::activeWarnings(const RuleEngine& rules, std::uint32_t vehicle) const {
+    const std::size_t count = rules.rules().size() < kShmMaxWarnings ? rules.rules().size() : kShmMaxWarnings;
+    std::uint64_t mask = 0;
+    for (std::size_t r = 0; r < count; ++r) {
+        mask |= static_cast<std::uint64_t>(rules.isActive(vehicle, r)) << r;
+    }
+    return mask;
+}
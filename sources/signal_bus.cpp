@@ -0,0 +1,185 @@
+#include "../headers/signal_bus.hpp"
+
+#include <chrono>
+#include <memory>
+#include <type_traits>
+
+namespace {
+std::size_t roundUpToPowerOfTwo(std::size_t value) {
+    std::size_t result = 1;
+    while (result < value) {
+        result <<= 1;
+    }
+    return result;
+}
+}
+
+/**
+ * @brief Constructor for the SignalRing class.
+ *
+ * @param capacity Number of samples of history to keep; rounded up to a power of two.
+ */
+SignalRing::SignalRing(std::size_t capacity)
+    : mask(roundCapacity(capacity) - 1), owned(new Slot[mask + 1]), slots(owned.get()) {}
+
+/**
+ * @brief Gets the capacity a ring allocates for a requested history.
+ *
+ * @param capacity The requested number of samples.
+ * @return The number rounded up to a power of two (at least 1).
+ */
+std::size_t SignalRing::roundCapacity(std::size_t capacity) {
+    return roundUpToPowerOfTwo(capacity == 0 ? 1 : capacity);
+}
+
+/**
+ * @brief Appends a sample, overwriting the oldest one when the ring is full.
+ *
+ * Must only be called from the ring's single producer thread.
+ *
+ * @param timestampNs Time of the reading.
+ * @param value The reading.
+ */
+void SignalRing::publish(std::uint64_t timestampNs, double value) {
+    const std::uint64_t sequence = head.load(std::memory_order_relaxed);
+    Slot& slot = slots[sequence & mask];
+    slot.sequence.store(2 * sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.timestampNs.store(timestampNs, std::memory_order_relaxed);
+    slot.value.store(value, std::memory_order_relaxed);
+    slot.sequence.store(2 * sequence + 2, std::memory_order_release);
+    head.store(sequence + 1, std::memory_order_release);
+}
+
+/**
+ * @brief Reads the most recent sample.
+ *
+ * @param sample Receives the sample.
+ * @return false if nothing has been published yet.
+ */
+bool SignalRing::latest(SignalSample& sample) const {
+    for (;;) {
+        const std::uint64_t published = head.load(std::memory_order_acquire);
+        if (published == 0) {
+            return false;
+        }
+        // Only fails if the producer lapped the whole ring during the read
+        if (read(published - 1, sample)) {
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Reads one sample by sequence number.
+ *
+ * @param sequence The sample's sequence number.
+ * @param sample Receives the sample.
+ * @return false if the sample is not published yet, was overwritten, or changed during the read.
+ */
+bool SignalRing::read(std::uint64_t sequence, SignalSample& sample) const {
+    const Slot& slot = slots[sequence & mask];
+    const std::uint64_t before = slot.sequence.load(std::memory_order_acquire);
+    if (before != 2 * sequence + 2) {
+        return false;
+    }
+    sample.timestampNs = slot.timestampNs.load(std::memory_order_relaxed);
+    sample.value = slot.value.load(std::memory_order_relaxed);
+    sample.sequence = sequence;
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return slot.sequence.load(std::memory_order_relaxed) == before;
+}
+
+// Slots in an Arena are released without destructor calls
+static_assert(std::is_trivially_destructible<SignalRing::Slot>::value, "SignalRing::Slot needs a destructor call");
+
+/**
+ * @brief Constructor for the SignalBus class.
+ *
+ * The slots of every ring are allocated together, from the arena if one is given.
+ *
+ * @param historyCapacity Samples of history kept per signal.
+ * @param arena Arena to take the slots from, or nullptr to allocate them on the heap.
+ */
+SignalBus::SignalBus(std::size_t historyCapacity, Arena* arena) {
+    const std::size_t capacity = SignalRing::roundCapacity(historyCapacity);
+    SignalRing::Slot* slots;
+    if (arena != nullptr) {
+        slots = arena->allocate<SignalRing::Slot>(kSignalCount * capacity);
+        std::uninitialized_default_construct_n(slots, kSignalCount * capacity);
+    } else {
+        ownedSlots.reset(new SignalRing::Slot[kSignalCount * capacity]);
+        slots = ownedSlots.get();
+    }
+    for (std::size_t i = 0; i < kSignalCount; ++i) {
+        rings[i].attach(slots + i * capacity, capacity);
+    }
+}
+
+/**
+ * @brief Publishes a sample of a signal.
+ *
+ * @param signal The signal.
+ * @param value The reading.
+ * @param timestampNs Time of the reading.
+ */
+void SignalBus::publish(Signal signal, double value, std::uint64_t timestampNs) {
+    rings[static_cast<std::size_t>(signal)].publish(timestampNs, value);
+}
+
+/**
+ * @brief Reads the most recent sample of a signal.
+ *
+ * @param signal The signal.
+ * @param sample Receives the sample.
+ * @return false if the signal has not been published yet.
+ */
+bool SignalBus::latest(Signal signal, SignalSample& sample) const {
+    return rings[static_cast<std::size_t>(signal)].latest(sample);
+}
+
+/**
+ * @brief Gets the most recent value of a signal.
+ *
+ * @param signal The signal.
+ * @param fallback Value returned if the signal has not been published yet.
+ * @return The latest value, or fallback.
+ */
+double SignalBus::latestValue(Signal signal, double fallback) const {
+    SignalSample sample;
+    return latest(signal, sample) ? sample.value : fallback;
+}
+
+/**
+ * @brief Gets the current monotonic time in nanoseconds.
+ *
+ * @return Nanoseconds since the steady clock's epoch.
+ */
+std::uint64_t SignalBus::nowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/**
+ * @brief Switches the bus to virtual time and sets it.
+ *
+ * @param timeNs The virtual time; samples published without a timestamp are stamped with it.
+ */
+void SignalBus::setVirtualTimeNs(std::uint64_t timeNs) {
+    virtualTimeNs.store(timeNs, std::memory_order_relaxed);
+    useVirtualTime.store(true, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Gathers the latest value of every signal into a vehicle state.
+ *
+ * @param bus The bus to read.
+ * @return The snapshot; signals not published yet read as 0.
+ */
+VehicleState latestVehicleState(const SignalBus& bus) {
+    return VehicleState{bus.latestValue(Signal::Speed), bus.latestValue(Signal::FuelLevel),
+                        bus.latestValue(Signal::EngineTemperature), bus.latestValue(Signal::BatteryCharge),
+                        bus.latestValue(Signal::BatteryTemperature), bus.latestValue(Signal::RadarDistance),
+                        bus.latestValue(Signal::Throttle), bus.latestValue(Signal::BrakePressure),
+                        static_cast<int>(bus.latestValue(Signal::Gear))};
+}
@@ -0,0 +1,281 @@
+#include "../headers/signal_history.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "../headers/fleet.hpp"
+
+namespace {
+// Worst case of one encoded sample: 4 + 64 timestamp bits, 2 + 5 + 6 + 64 value bits
+constexpr std::uint32_t kMaxSampleBits = 145;
+
+bool fitsSigned(std::int64_t value, unsigned bits) {
+    const std::int64_t limit = std::int64_t(1) << (bits - 1);
+    return value >= -limit && value < limit;
+}
+
+std::uint64_t mask(std::uint64_t value, unsigned bits) {
+    return bits == 64 ? value : value & ((std::uint64_t(1) << bits) - 1);
+}
+}
+
+/**
+ * @brief Appends a sample, opening a new block when the open one is full.
+ *
+ * @param timestampNs Time of the sample; must not be earlier than the previous one.
+ * @param value The sample.
+ * @param config Resolution and retention; must be the same for every call.
+ */
+void CompressedSeries::append(std::uint64_t timestampNs, double value, const HistoryConfig& config) {
+    const std::uint64_t time = timestampNs / config.resolutionNs;
+    if (config.valueResolution > 0.0) {
+        value = std::round(value / config.valueResolution);
+    }
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    HistoryBlock* block = head < blocks.size() ? blocks.back().get() : nullptr;
+    if (block == nullptr || block->bitCount + kMaxSampleBits > HistoryBlock::kBits) {
+        dropExpired(time, config);
+        openBlock(time, bits);
+        ++samples;
+        return;
+    }
+
+    const std::int64_t delta = static_cast<std::int64_t>(time - previousTime);
+    const std::int64_t deltaOfDelta = delta - previousDelta;
+    if (deltaOfDelta == 0) {
+        write(0, 1);
+    } else if (fitsSigned(deltaOfDelta, 7)) {
+        write(0b10, 2);
+        write(mask(static_cast<std::uint64_t>(deltaOfDelta), 7), 7);
+    } else if (fitsSigned(deltaOfDelta, 9)) {
+        write(0b110, 3);
+        write(mask(static_cast<std::uint64_t>(deltaOfDelta), 9), 9);
+    } else if (fitsSigned(deltaOfDelta, 12)) {
+        write(0b1110, 4);
+        write(mask(static_cast<std::uint64_t>(deltaOfDelta), 12), 12);
+    } else {
+        write(0b1111, 4);
+        write(static_cast<std::uint64_t>(deltaOfDelta), 64);
+    }
+    previousDelta = delta;
+    previousTime = time;
+
+    const std::uint64_t difference = bits ^ previousBits;
+    if (difference == 0) {
+        write(0, 1);
+    } else {
+        const unsigned newLeading = std::min(31u, static_cast<unsigned>(__builtin_clzll(difference)));
+        const unsigned newTrailing = static_cast<unsigned>(__builtin_ctzll(difference));
+        if (haveWindow && newLeading >= leading && newTrailing >= trailing) {
+            write(0b10, 2);
+            write(difference >> trailing, 64 - leading - trailing);
+        } else {
+            const unsigned length = 64 - newLeading - newTrailing;
+            write(0b11, 2);
+            write(newLeading, 5);
+            write(length - 1, 6);
+            write(difference >> newTrailing, length);
+            leading = newLeading;
+            trailing = newTrailing;
+            haveWindow = true;
+        }
+    }
+    previousBits = bits;
+
+    block->lastTime = time;
+    ++block->count;
+    ++samples;
+}
+
+/**
+ * @brief Decodes the retained samples in a time range.
+ *
+ * Blocks entirely outside the range are skipped without decoding.
+ *
+ * @param fromNs Start of the range (inclusive).
+ * @param toNs End of the range (inclusive).
+ * @param out Receives the samples, oldest first.
+ * @param config The configuration the series was appended with.
+ */
+void CompressedSeries::decode(std::uint64_t fromNs, std::uint64_t toNs, std::vector<HistorySample>& out,
+                              const HistoryConfig& config) const {
+    const std::uint64_t from = fromNs / config.resolutionNs;
+    const std::uint64_t to = toNs / config.resolutionNs;
+    std::uint64_t time;
+    double value;
+    for (std::size_t b = head; b < blocks.size(); ++b) {
+        const HistoryBlock& block = *blocks[b];
+        if (block.lastTime < from) {
+            continue;
+        }
+        if (block.firstTime > to) {
+            break;
+        }
+        HistoryBlockDecoder decoder(block);
+        while (decoder.next(time, value)) {
+            if (time >= from && time <= to) {
+                out.push_back(HistorySample{time * config.resolutionNs,
+                                            config.valueResolution > 0.0 ? value * config.valueResolution : value});
+            }
+        }
+    }
+}
+
+/**
+ * @brief Starts a new block with a raw first sample.
+ *
+ * @param time Timestamp in resolution units.
+ * @param bits The value's bit pattern.
+ */
+void CompressedSeries::openBlock(std::uint64_t time, std::uint64_t bits) {
+    std::unique_ptr<HistoryBlock> block = spare ? std::move(spare) : std::make_unique<HistoryBlock>();
+    std::memset(block->words, 0, sizeof(block->words));
+    block->firstTime = time;
+    block->lastTime = time;
+    block->count = 1;
+    block->bitCount = 0;
+
+    if (head > 0 && head * 2 >= blocks.size()) {
+        blocks.erase(blocks.begin(), blocks.begin() + static_cast<std::ptrdiff_t>(head));
+        head = 0;
+    }
+    blocks.push_back(std::move(block));
+
+    write(time, 64);
+    write(bits, 64);
+    previousTime = time;
+    previousDelta = 0;
+    previousBits = bits;
+    haveWindow = false;
+}
+
+/**
+ * @brief Drops the blocks whose newest sample has fallen out of the retention window.
+ *
+ * @param time Timestamp of the newest sample, in resolution units.
+ * @param config The retention window.
+ */
+void CompressedSeries::dropExpired(std::uint64_t time, const HistoryConfig& config) {
+    const std::uint64_t retention = static_cast<std::uint64_t>(config.retention.count()) / config.resolutionNs;
+    const std::uint64_t oldest = time > retention ? time - retention : 0;
+    while (head < blocks.size() && blocks[head]->lastTime < oldest) {
+        samples -= blocks[head]->count;
+        spare = std::move(blocks[head]);
+        ++head;
+    }
+}
+
+/**
+ * @brief Appends bits to the open block, most significant first.
+ *
+ * @param value The bits, in the low end of the word.
+ * @param bits Number of bits to write (1-64).
+ */
+void CompressedSeries::write(std::uint64_t value, unsigned bits) {
+    HistoryBlock& block = *blocks.back();
+    value = mask(value, bits);
+    const std::size_t word = block.bitCount >> 6;
+    const unsigned offset = block.bitCount & 63;
+    const unsigned available = 64 - offset;
+    if (bits <= available) {
+        block.words[word] |= value << (available - bits);
+    } else {
+        const unsigned rest = bits - available;
+        block.words[word] |= value >> rest;
+        block.words[word + 1] |= value << (64 - rest);
+    }
+    block.bitCount += bits;
+}
+
+/**
+ * @brief Constructor for the SignalHistory class.
+ *
+ * @param vehicleCount Number of vehicles to keep history for.
+ * @param config Retention and timestamp resolution.
+ */
+SignalHistory::SignalHistory(std::size_t vehicleCount, HistoryConfig config)
+    : settings(config), series(vehicleCount * kSignalCount) {
+    if (settings.resolutionNs == 0) {
+        settings.resolutionNs = 1;
+    }
+}
+
+/**
+ * @brief Appends one sample of every signal of a vehicle.
+ *
+ * @param vehicle Index of the vehicle.
+ * @param timestampNs Time of the samples.
+ * @param values Readings indexed by Signal.
+ */
+void SignalHistory::appendAll(std::size_t vehicle, std::uint64_t timestampNs, const double (&values)[kSignalCount]) {
+    CompressedSeries* vehicleSeries = &series[vehicle * kSignalCount];
+    for (std::size_t s = 0; s < kSignalCount; ++s) {
+        vehicleSeries[s].append(timestampNs, values[s], settings);
+    }
+}
+
+/**
+ * @brief Appends every signal of a range of fleet vehicles.
+ *
+ * Disjoint ranges may be appended concurrently, e.g. from a TickEngine chunk observer.
+ *
+ * @param fleet The fleet to read.
+ * @param begin First vehicle of the range.
+ * @param end One past the last vehicle of the range; must not exceed vehicleCount().
+ * @param timestampNs Time of the samples.
+ */
+void SignalHistory::appendFleet(const Fleet& fleet, std::size_t begin, std::size_t end, std::uint64_t timestampNs) {
+    for (std::size_t s = 0; s < kSignalCount; ++s) {
+        const Signal signal = static_cast<Signal>(s);
+        const std::vector<double>* column = fleet.column(signal);
+        const std::vector<int>& gear = fleet.columns().gear;
+        for (std::size_t i = begin; i < end; ++i) {
+            series[i * kSignalCount + s].append(timestampNs, column ? (*column)[i] : static_cast<double>(gear[i]),
+                                                settings);
+        }
+    }
+}
+
+/**
+ * @brief Decodes one signal's history in a time range.
+ *
+ * @param vehicle Index of the vehicle.
+ * @param signal The signal.
+ * @param fromNs Start of the range (inclusive).
+ * @param toNs End of the range (inclusive).
+ * @return The samples, oldest first.
+ */
+std::vector<HistorySample> SignalHistory::decode(std::size_t vehicle, Signal signal, std::uint64_t fromNs,
+                                                 std::uint64_t toNs) const {
+    std::vector<HistorySample> samples;
+    of(vehicle, signal).decode(fromNs, toNs, samples, settings);
+    return samples;
+}
+
+/**
+ * @brief Counts the retained samples of every series.
+ *
+ * @return The number of samples.
+ */
+std::uint64_t SignalHistory::sampleCount() const {
+    std::uint64_t total = 0;
+    for (const CompressedSeries& s : series) {
+        total += s.sampleCount();
+    }
+    return total;
+}
+
+/**
+ * @brief Sums the memory held by every series' blocks and bookkeeping.
+ *
+ * @return Bytes used.
+ */
+std::size_t SignalHistory::memoryBytes() const {
+    std::size_t total = series.size() * sizeof(CompressedSeries);
+    for (const CompressedSeries& s : series) {
+        total += s.memoryBytes();
+    }
+    return total;
+}
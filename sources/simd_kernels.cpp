@@ -0,0 +1,521 @@
+#include "../headers/simd_kernels.hpp"
+#include "../headers/ecu.hpp"
+#include "../headers/rng.hpp"
+#include "../headers/vehicle_model.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define VT_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace simd {
+namespace {
+
+using namespace vehicle_model;
+
+// One implementation of every kernel for a given instruction set
+struct KernelTable {
+    Isa isa;
+    void (*scaleUniform)(double*, const double*, double, double, std::size_t);
+    void (*addUniform)(double*, const double*, double, double, std::size_t);
+    void (*drainUniform)(double*, const double*, double, double, std::size_t);
+    void (*engineTemperature)(double*, const double*, const double*, std::size_t);
+    void (*clamp)(double*, double, double, std::size_t);
+    void (*accBand)(const double*, double*, double*, std::size_t);
+    void (*thresholdMask)(const double*, double, bool, std::uint32_t, std::uint32_t*, std::size_t);
+    void (*philoxUniform)(std::uint64_t, RandomChannel, std::uint64_t, std::uint32_t, double*, std::size_t);
+};
+
+// ---------------------------------------------------------------- scalar
+
+void scaleUniformScalar(double* out, const double* unit, double low, double high, std::size_t n) {
+    const double span = high - low;
+    for (std::size_t i = 0; i < n; ++i) {
+        out[i] = low + span * unit[i];
+    }
+}
+
+void addUniformScalar(double* values, const double* unit, double low, double high, std::size_t n) {
+    const double span = high - low;
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] += low + span * unit[i];
+    }
+}
+
+void drainUniformScalar(double* level, const double* unit, double low, double high, std::size_t n) {
+    const double span = high - low;
+    for (std::size_t i = 0; i < n; ++i) {
+        level[i] = drain(level[i], low + span * unit[i]);
+    }
+}
+
+void engineTemperatureScalar(double* temperature, const double* speed, const double* unit, std::size_t n) {
+    const double low = -kEngineTempNoise;
+    const double span = 2.0 * kEngineTempNoise;
+    for (std::size_t i = 0; i < n; ++i) {
+        temperature[i] = vehicle_model::engineTemperature(speed[i], low + span * unit[i]);
+    }
+}
+
+void clampScalar(double* values, double low, double high, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        values[i] = ::clamp(values[i], low, high);
+    }
+}
+
+void accBandScalar(const double* distance, double* throttle, double* brake, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        AccCommand command = accBandCommand(distance[i]);
+        throttle[i] = ::clamp(command.throttle, kActuatorMin, kActuatorMax);
+        brake[i] = ::clamp(command.brake, kActuatorMin, kActuatorMax);
+    }
+}
+
+void thresholdMaskScalar(const double* values, double threshold, bool warnAbove, std::uint32_t bit,
+                         std::uint32_t* masks, std::size_t n) {
+    if (warnAbove) {
+        for (std::size_t i = 0; i < n; ++i) {
+            masks[i] |= values[i] > threshold ? bit : 0u;
+        }
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            masks[i] |= values[i] < threshold ? bit : 0u;
+        }
+    }
+}
+
+void philoxUniformScalar(std::uint64_t seed, RandomChannel channel, std::uint64_t tick,
+                         std::uint32_t firstVehicle, double* out, std::size_t n) {
+    rng::fillUniformScalar<rng::Philox4x32>(seed, channel, tick, firstVehicle, out, n);
+}
+
+constexpr KernelTable kScalarTable = {
+    Isa::Scalar, scaleUniformScalar, addUniformScalar, drainUniformScalar, engineTemperatureScalar,
+    clampScalar, accBandScalar, thresholdMaskScalar, philoxUniformScalar};
+
+#ifdef VT_SIMD_X86
+
+// ---------------------------------------------------------------- SSE2 (2 doubles per vector)
+
+__attribute__((target("sse2")))
+void scaleUniformSse2(double* out, const double* unit, double low, double high, std::size_t n) {
+    const __m128d vLow = _mm_set1_pd(low);
+    const __m128d vSpan = _mm_set1_pd(high - low);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        _mm_storeu_pd(out + i, _mm_add_pd(vLow, _mm_mul_pd(vSpan, _mm_loadu_pd(unit + i))));
+    }
+    scaleUniformScalar(out + i, unit + i, low, high, n - i);
+}
+
+__attribute__((target("sse2")))
+void addUniformSse2(double* values, const double* unit, double low, double high, std::size_t n) {
+    const __m128d vLow = _mm_set1_pd(low);
+    const __m128d vSpan = _mm_set1_pd(high - low);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d step = _mm_add_pd(vLow, _mm_mul_pd(vSpan, _mm_loadu_pd(unit + i)));
+        _mm_storeu_pd(values + i, _mm_add_pd(_mm_loadu_pd(values + i), step));
+    }
+    addUniformScalar(values + i, unit + i, low, high, n - i);
+}
+
+__attribute__((target("sse2")))
+void drainUniformSse2(double* level, const double* unit, double low, double high, std::size_t n) {
+    const __m128d vLow = _mm_set1_pd(low);
+    const __m128d vSpan = _mm_set1_pd(high - low);
+    const __m128d zero = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d amount = _mm_add_pd(vLow, _mm_mul_pd(vSpan, _mm_loadu_pd(unit + i)));
+        _mm_storeu_pd(level + i, _mm_max_pd(_mm_sub_pd(_mm_loadu_pd(level + i), amount), zero));
+    }
+    drainUniformScalar(level + i, unit + i, low, high, n - i);
+}
+
+__attribute__((target("sse2")))
+void engineTemperatureSse2(double* temperature, const double* speed, const double* unit, std::size_t n) {
+    const __m128d vLow = _mm_set1_pd(-kEngineTempNoise);
+    const __m128d vSpan = _mm_set1_pd(2.0 * kEngineTempNoise);
+    const __m128d vBase = _mm_set1_pd(kEngineTempBase);
+    const __m128d vPerKmh = _mm_set1_pd(kEngineTempPerKmh);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d noise = _mm_add_pd(vLow, _mm_mul_pd(vSpan, _mm_loadu_pd(unit + i)));
+        __m128d heat = _mm_add_pd(vBase, _mm_mul_pd(_mm_loadu_pd(speed + i), vPerKmh));
+        _mm_storeu_pd(temperature + i, _mm_add_pd(heat, noise));
+    }
+    engineTemperatureScalar(temperature + i, speed + i, unit + i, n - i);
+}
+
+__attribute__((target("sse2")))
+void clampSse2(double* values, double low, double high, std::size_t n) {
+    const __m128d vLow = _mm_set1_pd(low);
+    const __m128d vHigh = _mm_set1_pd(high);
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        // max(a, b) is a > b ? a : b and min(a, b) is a < b ? a : b, so with the bounds first a NaN
+        // or -0.0 passes through as in ::clamp
+        _mm_storeu_pd(values + i, _mm_min_pd(vHigh, _mm_max_pd(vLow, _mm_loadu_pd(values + i))));
+    }
+    clampScalar(values + i, low, high, n - i);
+}
+
+__attribute__((target("sse2")))
+inline __m128d selectSse2(__m128d mask, __m128d ifTrue, __m128d ifFalse) {
+    return _mm_or_pd(_mm_and_pd(mask, ifTrue), _mm_andnot_pd(mask, ifFalse));
+}
+
+__attribute__((target("sse2")))
+void accBandSse2(const double* distance, double* throttle, double* brake, std::size_t n) {
+    const __m128d slowDistance = _mm_set1_pd(kAccSlowDownDistance);
+    const __m128d fastDistance = _mm_set1_pd(kAccSpeedUpDistance);
+    const __m128d slowThrottle = _mm_set1_pd(::clamp(kAccSlowDownThrottle, kActuatorMin, kActuatorMax));
+    const __m128d keepThrottle = _mm_set1_pd(::clamp(kAccMaintainThrottle, kActuatorMin, kActuatorMax));
+    const __m128d fastThrottle = _mm_set1_pd(::clamp(kAccSpeedUpThrottle, kActuatorMin, kActuatorMax));
+    const __m128d slowBrake = _mm_set1_pd(::clamp(kAccSlowDownBrake, kActuatorMin, kActuatorMax));
+    const __m128d zero = _mm_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d d = _mm_loadu_pd(distance + i);
+        __m128d isSlow = _mm_cmplt_pd(d, slowDistance);
+        __m128d isKeep = _mm_cmplt_pd(d, fastDistance);
+        __m128d t = selectSse2(isSlow, slowThrottle, selectSse2(isKeep, keepThrottle, fastThrottle));
+        _mm_storeu_pd(throttle + i, t);
+        _mm_storeu_pd(brake + i, selectSse2(isSlow, slowBrake, zero));
+    }
+    accBandScalar(distance + i, throttle + i, brake + i, n - i);
+}
+
+__attribute__((target("sse2")))
+void thresholdMaskSse2(const double* values, double threshold, bool warnAbove, std::uint32_t bit,
+                       std::uint32_t* masks, std::size_t n) {
+    const __m128d vThreshold = _mm_set1_pd(threshold);
+    const __m128i vBit = _mm_set1_epi32(static_cast<int>(bit));
+    std::size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(values + i);
+        __m128d hit = warnAbove ? _mm_cmpgt_pd(v, vThreshold) : _mm_cmplt_pd(v, vThreshold);
+        // Narrow the two 64-bit lane masks to two 32-bit lanes
+        __m128i lanes = _mm_shuffle_epi32(_mm_castpd_si128(hit), _MM_SHUFFLE(2, 0, 2, 0));
+        __m128i current = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(masks + i));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(masks + i), _mm_or_si128(current, _mm_and_si128(lanes, vBit)));
+    }
+    thresholdMaskScalar(values + i, threshold, warnAbove, bit, masks + i, n - i);
+}
+
+// Philox blocks for vehicle pairs (first + 2j, first + 2j + 1), two blocks per vector;
+// each 32-bit counter word lives in the low half of a 64-bit lane
+__attribute__((target("sse2")))
+void philoxUniformSse2(std::uint64_t seed, RandomChannel channel, std::uint64_t tick,
+                       std::uint32_t firstVehicle, double* out, std::size_t n) {
+    std::size_t i = 0;
+    if ((firstVehicle & 1u) && n > 0) {
+        out[0] = rng::uniformAt<rng::Philox4x32>(seed, firstVehicle, channel, tick);
+        i = 1;
+    }
+    const __m128i mask32 = _mm_set1_epi64x(0xFFFFFFFFll);
+    const __m128i m0 = _mm_set1_epi64x(rng::kPhiloxM0);
+    const __m128i m1 = _mm_set1_epi64x(rng::kPhiloxM1);
+    const __m128i w0 = _mm_set1_epi64x(rng::kPhiloxW0);
+    const __m128i w1 = _mm_set1_epi64x(rng::kPhiloxW1);
+    const __m128i one = _mm_set1_epi64x(0x3FF0000000000000ll);
+    const __m128d oneDouble = _mm_set1_pd(1.0);
+    for (; i + 4 <= n; i += 4) {
+        const long long pair = (firstVehicle + static_cast<std::uint32_t>(i)) >> 1;
+        __m128i c0 = _mm_set1_epi64x(static_cast<std::uint32_t>(tick));
+        __m128i c1 = _mm_set1_epi64x(static_cast<std::uint32_t>(tick >> 32));
+        __m128i c2 = _mm_set_epi64x(pair + 1, pair);
+        __m128i c3 = _mm_set1_epi64x(static_cast<std::uint32_t>(channel));
+        __m128i k0 = _mm_set1_epi64x(static_cast<std::uint32_t>(seed));
+        __m128i k1 = _mm_set1_epi64x(static_cast<std::uint32_t>(seed >> 32));
+        for (int round = 0; round < rng::kPhiloxRounds; ++round) {
+            __m128i p0 = _mm_mul_epu32(m0, c0);
+            __m128i p1 = _mm_mul_epu32(m1, c2);
+            c0 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi64(p1, 32), c1), k0);
+            c1 = _mm_and_si128(p1, mask32);
+            c2 = _mm_xor_si128(_mm_xor_si128(_mm_srli_epi64(p0, 32), c3), k1);
+            c3 = _mm_and_si128(p0, mask32);
+            k0 = _mm_and_si128(_mm_add_epi64(k0, w0), mask32);
+            k1 = _mm_and_si128(_mm_add_epi64(k1, w1), mask32);
+        }
+        __m128i even = _mm_or_si128(_mm_slli_epi64(c1, 32), c0);
+        __m128i odd = _mm_or_si128(_mm_slli_epi64(c3, 32), c2);
+        __m128d d0 = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(even, 12), one)), oneDouble);
+        __m128d d1 = _mm_sub_pd(_mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(odd, 12), one)), oneDouble);
+        _mm_storeu_pd(out + i, _mm_unpacklo_pd(d0, d1));
+        _mm_storeu_pd(out + i + 2, _mm_unpackhi_pd(d0, d1));
+    }
+    rng::fillUniformScalar<rng::Philox4x32>(seed, channel, tick, firstVehicle + static_cast<std::uint32_t>(i), out + i,
+                                            n - i);
+}
+
+constexpr KernelTable kSse2Table = {
+    Isa::Sse2, scaleUniformSse2, addUniformSse2, drainUniformSse2, engineTemperatureSse2,
+    clampSse2, accBandSse2, thresholdMaskSse2, philoxUniformSse2};
+
+// ---------------------------------------------------------------- AVX2 (4 doubles per vector)
+
+__attribute__((target("avx2")))
+void scaleUniformAvx2(double* out, const double* unit, double low, double high, std::size_t n) {
+    const __m256d vLow = _mm256_set1_pd(low);
+    const __m256d vSpan = _mm256_set1_pd(high - low);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(out + i, _mm256_add_pd(vLow, _mm256_mul_pd(vSpan, _mm256_loadu_pd(unit + i))));
+    }
+    scaleUniformScalar(out + i, unit + i, low, high, n - i);
+}
+
+__attribute__((target("avx2")))
+void addUniformAvx2(double* values, const double* unit, double low, double high, std::size_t n) {
+    const __m256d vLow = _mm256_set1_pd(low);
+    const __m256d vSpan = _mm256_set1_pd(high - low);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d step = _mm256_add_pd(vLow, _mm256_mul_pd(vSpan, _mm256_loadu_pd(unit + i)));
+        _mm256_storeu_pd(values + i, _mm256_add_pd(_mm256_loadu_pd(values + i), step));
+    }
+    addUniformScalar(values + i, unit + i, low, high, n - i);
+}
+
+__attribute__((target("avx2")))
+void drainUniformAvx2(double* level, const double* unit, double low, double high, std::size_t n) {
+    const __m256d vLow = _mm256_set1_pd(low);
+    const __m256d vSpan = _mm256_set1_pd(high - low);
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d amount = _mm256_add_pd(vLow, _mm256_mul_pd(vSpan, _mm256_loadu_pd(unit + i)));
+        _mm256_storeu_pd(level + i, _mm256_max_pd(_mm256_sub_pd(_mm256_loadu_pd(level + i), amount), zero));
+    }
+    drainUniformScalar(level + i, unit + i, low, high, n - i);
+}
+
+__attribute__((target("avx2")))
+void engineTemperatureAvx2(double* temperature, const double* speed, const double* unit, std::size_t n) {
+    const __m256d vLow = _mm256_set1_pd(-kEngineTempNoise);
+    const __m256d vSpan = _mm256_set1_pd(2.0 * kEngineTempNoise);
+    const __m256d vBase = _mm256_set1_pd(kEngineTempBase);
+    const __m256d vPerKmh = _mm256_set1_pd(kEngineTempPerKmh);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d noise = _mm256_add_pd(vLow, _mm256_mul_pd(vSpan, _mm256_loadu_pd(unit + i)));
+        __m256d heat = _mm256_add_pd(vBase, _mm256_mul_pd(_mm256_loadu_pd(speed + i), vPerKmh));
+        _mm256_storeu_pd(temperature + i, _mm256_add_pd(heat, noise));
+    }
+    engineTemperatureScalar(temperature + i, speed + i, unit + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void clampAvx2(double* values, double low, double high, std::size_t n) {
+    const __m256d vLow = _mm256_set1_pd(low);
+    const __m256d vHigh = _mm256_set1_pd(high);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        _mm256_storeu_pd(values + i, _mm256_min_pd(vHigh, _mm256_max_pd(vLow, _mm256_loadu_pd(values + i))));
+    }
+    clampScalar(values + i, low, high, n - i);
+}
+
+__attribute__((target("avx2")))
+void accBandAvx2(const double* distance, double* throttle, double* brake, std::size_t n) {
+    const __m256d slowDistance = _mm256_set1_pd(kAccSlowDownDistance);
+    const __m256d fastDistance = _mm256_set1_pd(kAccSpeedUpDistance);
+    const __m256d slowThrottle = _mm256_set1_pd(::clamp(kAccSlowDownThrottle, kActuatorMin, kActuatorMax));
+    const __m256d keepThrottle = _mm256_set1_pd(::clamp(kAccMaintainThrottle, kActuatorMin, kActuatorMax));
+    const __m256d fastThrottle = _mm256_set1_pd(::clamp(kAccSpeedUpThrottle, kActuatorMin, kActuatorMax));
+    const __m256d slowBrake = _mm256_set1_pd(::clamp(kAccSlowDownBrake, kActuatorMin, kActuatorMax));
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d d = _mm256_loadu_pd(distance + i);
+        __m256d isSlow = _mm256_cmp_pd(d, slowDistance, _CMP_LT_OQ);
+        __m256d isKeep = _mm256_cmp_pd(d, fastDistance, _CMP_LT_OQ);
+        __m256d t = _mm256_blendv_pd(_mm256_blendv_pd(fastThrottle, keepThrottle, isKeep), slowThrottle, isSlow);
+        _mm256_storeu_pd(throttle + i, t);
+        _mm256_storeu_pd(brake + i, _mm256_blendv_pd(zero, slowBrake, isSlow));
+    }
+    accBandScalar(distance + i, throttle + i, brake + i, n - i);
+}
+
+__attribute__((target("avx2")))
+void thresholdMaskAvx2(const double* values, double threshold, bool warnAbove, std::uint32_t bit,
+                       std::uint32_t* masks, std::size_t n) {
+    const __m256d vThreshold = _mm256_set1_pd(threshold);
+    const __m128i vBit = _mm_set1_epi32(static_cast<int>(bit));
+    // Picks the low 32 bits of each 64-bit lane into the lower half of the register
+    const __m256i narrow = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    std::size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(values + i);
+        __m256d hit = warnAbove ? _mm256_cmp_pd(v, vThreshold, _CMP_GT_OQ) : _mm256_cmp_pd(v, vThreshold, _CMP_LT_OQ);
+        __m128i lanes = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_castpd_si256(hit), narrow));
+        __m128i* target = reinterpret_cast<__m128i*>(masks + i);
+        _mm_storeu_si128(target, _mm_or_si128(_mm_loadu_si128(target), _mm_and_si128(lanes, vBit)));
+    }
+    thresholdMaskScalar(values + i, threshold, warnAbove, bit, masks + i, n - i);
+}
+
+// Same layout as philoxUniformSse2, four blocks (eight vehicles) per iteration
+__attribute__((target("avx2")))
+void philoxUniformAvx2(std::uint64_t seed, RandomChannel channel, std::uint64_t tick,
+                       std::uint32_t firstVehicle, double* out, std::size_t n) {
+    std::size_t i = 0;
+    if ((firstVehicle & 1u) && n > 0) {
+        out[0] = rng::uniformAt<rng::Philox4x32>(seed, firstVehicle, channel, tick);
+        i = 1;
+    }
+    const __m256i mask32 = _mm256_set1_epi64x(0xFFFFFFFFll);
+    const __m256i m0 = _mm256_set1_epi64x(rng::kPhiloxM0);
+    const __m256i m1 = _mm256_set1_epi64x(rng::kPhiloxM1);
+    const __m256i w0 = _mm256_set1_epi64x(rng::kPhiloxW0);
+    const __m256i w1 = _mm256_set1_epi64x(rng::kPhiloxW1);
+    const __m256i one = _mm256_set1_epi64x(0x3FF0000000000000ll);
+    const __m256d oneDouble = _mm256_set1_pd(1.0);
+    for (; i + 8 <= n; i += 8) {
+        const long long pair = (firstVehicle + static_cast<std::uint32_t>(i)) >> 1;
+        __m256i c0 = _mm256_set1_epi64x(static_cast<std::uint32_t>(tick));
+        __m256i c1 = _mm256_set1_epi64x(static_cast<std::uint32_t>(tick >> 32));
+        __m256i c2 = _mm256_setr_epi64x(pair, pair + 1, pair + 2, pair + 3);
+        __m256i c3 = _mm256_set1_epi64x(static_cast<std::uint32_t>(channel));
+        __m256i k0 = _mm256_set1_epi64x(static_cast<std::uint32_t>(seed));
+        __m256i k1 = _mm256_set1_epi64x(static_cast<std::uint32_t>(seed >> 32));
+        for (int round = 0; round < rng::kPhiloxRounds; ++round) {
+            __m256i p0 = _mm256_mul_epu32(m0, c0);
+            __m256i p1 = _mm256_mul_epu32(m1, c2);
+            c0 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p1, 32), c1), k0);
+            c1 = _mm256_and_si256(p1, mask32);
+            c2 = _mm256_xor_si256(_mm256_xor_si256(_mm256_srli_epi64(p0, 32), c3), k1);
+            c3 = _mm256_and_si256(p0, mask32);
+            k0 = _mm256_and_si256(_mm256_add_epi64(k0, w0), mask32);
+            k1 = _mm256_and_si256(_mm256_add_epi64(k1, w1), mask32);
+        }
+        __m256i even = _mm256_or_si256(_mm256_slli_epi64(c1, 32), c0);
+        __m256i odd = _mm256_or_si256(_mm256_slli_epi64(c3, 32), c2);
+        __m256d d0 = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(even, 12), one)), oneDouble);
+        __m256d d1 = _mm256_sub_pd(_mm256_castsi256_pd(_mm256_or_si256(_mm256_srli_epi64(odd, 12), one)), oneDouble);
+        // Interleave back into vehicle order: even0 odd0 even1 odd1 | even2 odd2 even3 odd3
+        __m256d low = _mm256_unpacklo_pd(d0, d1);
+        __m256d high = _mm256_unpackhi_pd(d0, d1);
+        _mm256_storeu_pd(out + i, _mm256_permute2f128_pd(low, high, 0x20));
+        _mm256_storeu_pd(out + i + 4, _mm256_permute2f128_pd(low, high, 0x31));
+    }
+    rng::fillUniformScalar<rng::Philox4x32>(seed, channel, tick, firstVehicle + static_cast<std::uint32_t>(i), out + i,
+                                            n - i);
+}
+
+constexpr KernelTable kAvx2Table = {
+    Isa::Avx2, scaleUniformAvx2, addUniformAvx2, drainUniformAvx2, engineTemperatureAvx2,
+    clampAvx2, accBandAvx2, thresholdMaskAvx2, philoxUniformAvx2};
+
+#endif // VT_SIMD_X86
+
+bool isSupported(Isa isa) {
+#ifdef VT_SIMD_X86
+    // Required because the first call happens during static initialization
+    __builtin_cpu_init();
+    switch (isa) {
+        case Isa::Scalar: return true;
+        case Isa::Sse2: return __builtin_cpu_supports("sse2");
+        case Isa::Avx2: return __builtin_cpu_supports("avx2");
+    }
+    return false;
+#else
+    return isa == Isa::Scalar;
+#endif
+}
+
+const KernelTable* tableFor(Isa isa) {
+#ifdef VT_SIMD_X86
+    if (isa == Isa::Avx2) {
+        return &kAvx2Table;
+    }
+    if (isa == Isa::Sse2) {
+        return &kSse2Table;
+    }
+#endif
+    (void)isa;
+    return &kScalarTable;
+}
+
+// Picks the widest supported instruction set, honouring VT_SIMD if it names a supported one
+const KernelTable* selectTable() {
+    if (const char* requested = std::getenv("VT_SIMD")) {
+        for (Isa isa : {Isa::Scalar, Isa::Sse2, Isa::Avx2}) {
+            if (std::strcmp(requested, isaName(isa)) == 0 && isSupported(isa)) {
+                return tableFor(isa);
+            }
+        }
+    }
+    for (Isa isa : {Isa::Avx2, Isa::Sse2}) {
+        if (isSupported(isa)) {
+            return tableFor(isa);
+        }
+    }
+    return &kScalarTable;
+}
+
+const KernelTable* active = selectTable();
+
+} // namespace
+
+Isa activeIsa() {
+    return active->isa;
+}
+
+const char* isaName(Isa isa) {
+    switch (isa) {
+        case Isa::Scalar: return "scalar";
+        case Isa::Sse2: return "sse2";
+        case Isa::Avx2: return "avx2";
+    }
+    return "unknown";
+}
+
+bool setIsa(Isa isa) {
+    if (!isSupported(isa)) {
+        return false;
+    }
+    active = tableFor(isa);
+    return true;
+}
+
+void scaleUniform(double* out, const double* unit, double low, double high, std::size_t n) {
+    active->scaleUniform(out, unit, low, high, n);
+}
+
+void addUniform(double* values, const double* unit, double low, double high, std::size_t n) {
+    active->addUniform(values, unit, low, high, n);
+}
+
+void drainUniform(double* level, const double* unit, double low, double high, std::size_t n) {
+    active->drainUniform(level, unit, low, high, n);
+}
+
+void engineTemperature(double* temperature, const double* speed, const double* unit, std::size_t n) {
+    active->engineTemperature(temperature, speed, unit, n);
+}
+
+void clamp(double* values, double low, double high, std::size_t n) {
+    active->clamp(values, low, high, n);
+}
+
+void accBand(const double* distance, double* throttle, double* brake, std::size_t n) {
+    active->accBand(distance, throttle, brake, n);
+}
+
+void thresholdMask(const double* values, double threshold, bool warnAbove, std::uint32_t bit,
+                   std::uint32_t* masks, std::size_t n) {
+    active->thresholdMask(values, threshold, warnAbove, bit, masks, n);
+}
+
+void philoxUniform(std::uint64_t seed, RandomChannel channel, std::uint64_t tick,
+                   std::uint32_t firstVehicle, double* out, std::size_t n) {
+    active->philoxUniform(seed, channel, tick, firstVehicle, out, n);
+}
+
+} // namespace simd
@@ -0,0 +1,316 @@
+#include "../headers/telemetry_log.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+
+/// @brief Gets the singleton instance of the TelemetryLog
+/// @return Reference to the TelemetryLog instance
+TelemetryLog& TelemetryLog::GetInstance() {
+    static TelemetryLog instance;
+    return instance;
+}
+
+/// @brief Destructor for the TelemetryLog class
+/// @details Writes the last partial block and closes the file
+TelemetryLog::~TelemetryLog() {
+    Close();
+}
+
+/// @brief Opens a telemetry file and writes the file header
+/// @param filePath The path to the telemetry file (truncated if it exists)
+/// @param blockCapacity Number of records buffered per block
+void TelemetryLog::Open(const std::string& filePath, std::uint32_t blockCapacity) {
+    Close();
+
+    std::lock_guard<std::mutex> lock(mutex);
+    file.open(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open telemetry file: " << filePath << std::endl;
+        throw std::runtime_error("Failed to open telemetry file: " + filePath);
+    }
+
+    this->blockCapacity = blockCapacity == 0 ? 1 : blockCapacity;
+    block.clear();
+    block.reserve(this->blockCapacity);
+    pending.clear();
+    pending.reserve(this->blockCapacity);
+
+    TelemetryFileHeader header{};
+    header.magic = kTelemetryFileMagic;
+    header.version = kTelemetryFormatVersion;
+    header.recordSize = sizeof(TelemetryRecord);
+    header.blockCapacity = this->blockCapacity;
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    bytesWritten.store(sizeof(header), std::memory_order_relaxed);
+    writing = false;
+    stopping = false;
+    writerThread = std::thread(&TelemetryLog::WriterLoop, this);
+    isOpen.store(true, std::memory_order_release);
+}
+
+/// @brief Writes any buffered records, stops the writer thread and closes the file
+void TelemetryLog::Close() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!IsOpen()) {
+        return;
+    }
+    isOpen.store(false, std::memory_order_release);
+    HandOffLocked(lock);
+    stopping = true;
+    writerWakeup.notify_one();
+    lock.unlock();
+    writerThread.join();
+    file.close();
+}
+
+/// @brief Records the state of every sensor of a vehicle
+void TelemetryLog::RecordSensorSnapshot(std::uint32_t vehicleId, double speed, double fuel, double engineTemperature,
+                                        double batteryCharge, double batteryTemperature, double radarDistance) {
+    if (!IsOpen()) {
+        return;
+    }
+    TelemetryRecord record{};
+    record.type = static_cast<std::uint16_t>(TelemetryRecordType::SensorSnapshot);
+    record.fieldCount = 6;
+    record.vehicleId = vehicleId;
+    record.fields[0] = speed;
+    record.fields[1] = fuel;
+    record.fields[2] = engineTemperature;
+    record.fields[3] = batteryCharge;
+    record.fields[4] = batteryTemperature;
+    record.fields[5] = radarDistance;
+    Record(record);
+}
+
+/// @brief Records one adaptive cruise control decision
+/// @param band 0 = slowing down, 1 = maintaining speed, 2 = speeding up
+void TelemetryLog::RecordAccDecision(std::uint32_t vehicleId, double distance, double throttle, double brake, int band) {
+    if (!IsOpen()) {
+        return;
+    }
+    TelemetryRecord record{};
+    record.type = static_cast<std::uint16_t>(TelemetryRecordType::AccDecision);
+    record.fieldCount = 4;
+    record.vehicleId = vehicleId;
+    record.fields[0] = distance;
+    record.fields[1] = throttle;
+    record.fields[2] = brake;
+    record.fields[3] = band;
+    Record(record);
+}
+
+/// @brief Records one diagnostic check
+void TelemetryLog::RecordDiagnostic(std::uint32_t vehicleId, Signal signal, double value, double threshold, bool warning) {
+    if (!IsOpen()) {
+        return;
+    }
+    TelemetryRecord record{};
+    record.type = static_cast<std::uint16_t>(TelemetryRecordType::DiagnosticReading);
+    record.fieldCount = 4;
+    record.vehicleId = vehicleId;
+    record.fields[0] = static_cast<double>(signal);
+    record.fields[1] = value;
+    record.fields[2] = threshold;
+    record.fields[3] = warning ? 1.0 : 0.0;
+    Record(record);
+}
+
+/// @brief Appends a record to the current block, handing the block to the writer when it is full
+/// @param record The record; a zero timestamp is replaced with the current (or virtual) time
+void TelemetryLog::Record(TelemetryRecord record) {
+    if (record.timestampNs == 0) {
+        record.timestampNs = useVirtualTime.load(std::memory_order_relaxed)
+            ? virtualTimeNs.load(std::memory_order_relaxed) : NowNs();
+    }
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!IsOpen()) {
+        return;
+    }
+    block.push_back(record);
+    if (block.size() >= blockCapacity) {
+        HandOffLocked(lock);
+    }
+}
+
+/// @brief Writes the current partial block and flushes the file
+/// @details Waits for the writer thread to finish every block handed to it.
+void TelemetryLog::Flush() {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (!IsOpen()) {
+        return;
+    }
+    HandOffLocked(lock);
+    blockWritten.wait(lock, [this] { return !writing; });
+    file.flush();
+}
+
+/// @brief Gets the current monotonic time in nanoseconds
+/// @return Nanoseconds since the steady clock's epoch
+std::uint64_t TelemetryLog::NowNs() {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+/// @brief Switches record timestamps to simulated time
+/// @details Used by headless runs, where simulated time advances faster than the wall clock.
+/// @param timeNs The simulated time to stamp subsequent records with
+void TelemetryLog::SetVirtualTimeNs(std::uint64_t timeNs) {
+    virtualTimeNs.store(timeNs, std::memory_order_relaxed);
+    useVirtualTime.store(true, std::memory_order_relaxed);
+}
+
+/// @brief Gives the current block to the writer thread and starts filling the other one
+/// @details The caller must hold the mutex through lock; waits while the writer still has the other block.
+void TelemetryLog::HandOffLocked(std::unique_lock<std::mutex>& lock) {
+    if (block.empty()) {
+        return;
+    }
+    blockWritten.wait(lock, [this] { return !writing; });
+    block.swap(pending);
+    block.clear();
+    writing = true;
+    writerWakeup.notify_one();
+}
+
+/// @brief Writer thread: writes each handed-off block until Close()
+void TelemetryLog::WriterLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;) {
+        writerWakeup.wait(lock, [this] { return writing || stopping; });
+        if (!writing) {
+            return;
+        }
+        lock.unlock();
+        WriteBlock(pending);
+        lock.lock();
+        writing = false;
+        blockWritten.notify_all();
+    }
+}
+
+/// @brief Writes records as one block with its header and CRC
+/// @details Runs on the writer thread without the mutex; only it touches the block until it is written.
+/// @param records The block's records
+void TelemetryLog::WriteBlock(const std::vector<TelemetryRecord>& records) {
+    const std::size_t payloadBytes = records.size() * sizeof(TelemetryRecord);
+
+    TelemetryBlockHeader header{};
+    header.magic = kTelemetryBlockMagic;
+    header.recordCount = static_cast<std::uint32_t>(records.size());
+    header.payloadBytes = static_cast<std::uint32_t>(payloadBytes);
+    header.crc32 = crc32(records.data(), payloadBytes);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(records.data()), static_cast<std::streamsize>(payloadBytes));
+    bytesWritten.fetch_add(sizeof(header) + payloadBytes, std::memory_order_relaxed);
+}
+
+/// @brief Opens a telemetry file for reading and validates its header
+/// @param filePath The path to the telemetry file
+TelemetryReader::TelemetryReader(const std::string& filePath) : file(filePath, std::ios::binary) {
+    if (!file.is_open()) {
+        throw std::runtime_error("Failed to open telemetry file: " + filePath);
+    }
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != kTelemetryFileMagic) {
+        throw std::runtime_error("Not a telemetry file: " + filePath);
+    }
+    if (header.version != kTelemetryFormatVersion || header.recordSize != sizeof(TelemetryRecord)) {
+        throw std::runtime_error("Unsupported telemetry format version in " + filePath);
+    }
+    const std::streamoff firstBlock = file.tellg();
+    file.seekg(0, std::ios::end);
+    fileSize = file.tellg();
+    file.seekg(firstBlock);
+}
+
+/// @brief Reads the next block whose CRC matches
+/// @details A block with a bad CRC is skipped whole. A block header with a bad magic, an
+///          inconsistent size or more records than the rest of the file holds is skipped by
+///          scanning forward for the next block magic.
+/// @param records Receives the block's records
+/// @return false at end of file or when the last block is cut short
+bool TelemetryReader::NextBlock(std::vector<TelemetryRecord>& records) {
+    for (;;) {
+        const std::streamoff blockStart = file.tellg();
+        TelemetryBlockHeader blockHeader{};
+        if (!file.read(reinterpret_cast<char*>(&blockHeader), sizeof(blockHeader))) {
+            return false;
+        }
+        const std::streamoff remaining = fileSize - blockStart - static_cast<std::streamoff>(sizeof(blockHeader));
+        if (blockHeader.magic != kTelemetryBlockMagic ||
+            blockHeader.payloadBytes != blockHeader.recordCount * sizeof(TelemetryRecord) ||
+            static_cast<std::streamoff>(blockHeader.payloadBytes) > remaining) {
+            ++corruptBlocks;
+            if (!Resync(blockStart + 1)) {
+                return false;
+            }
+            continue;
+        }
+
+        records.resize(blockHeader.recordCount);
+        if (!file.read(reinterpret_cast<char*>(records.data()), blockHeader.payloadBytes)) {
+            ++corruptBlocks;
+            return false;
+        }
+        if (crc32(records.data(), blockHeader.payloadBytes) == blockHeader.crc32) {
+            return true;
+        }
+        ++corruptBlocks;
+    }
+}
+
+/// @brief Positions the file at the next block magic
+/// @param offset File offset to start scanning from
+/// @return false if no block magic follows the offset
+bool TelemetryReader::Resync(std::streamoff offset) {
+    unsigned char magic[sizeof(kTelemetryBlockMagic)];
+    std::memcpy(magic, &kTelemetryBlockMagic, sizeof(magic));
+    char buffer[4096];
+    file.clear();
+    while (offset + static_cast<std::streamoff>(sizeof(magic)) <= fileSize) {
+        file.seekg(offset);
+        const std::streamsize wanted = static_cast<std::streamsize>(
+            std::min<std::streamoff>(sizeof(buffer), fileSize - offset));
+        if (!file.read(buffer, wanted)) {
+            return false;
+        }
+        for (std::streamsize i = 0; i + static_cast<std::streamsize>(sizeof(magic)) <= wanted; ++i) {
+            if (std::memcmp(buffer + i, magic, sizeof(magic)) == 0) {
+                file.seekg(offset + i);
+                return true;
+            }
+        }
+        // Keep the last bytes, which may hold the start of a magic cut by the buffer end
+        offset += wanted - static_cast<std::streamoff>(sizeof(magic)) + 1;
+    }
+    return false;
+}
+
+const char* telemetryRecordTypeName(std::uint16_t type) {
+    switch (static_cast<TelemetryRecordType>(type)) {
+        case TelemetryRecordType::SensorSnapshot: return "sensors";
+        case TelemetryRecordType::AccDecision: return "acc";
+        case TelemetryRecordType::DiagnosticReading: return "diagnostic";
+        default: return "unknown";
+    }
+}
+
+const char* telemetryFieldName(std::uint16_t type, std::size_t index) {
+    static const char* const sensorFields[] = {"speed", "fuel", "engine_temp", "battery_charge", "battery_temp", "radar_distance"};
+    static const char* const accFields[] = {"distance", "throttle", "brake", "band"};
+    static const char* const diagnosticFields[] = {"signal", "value", "threshold", "warning"};
+
+    switch (static_cast<TelemetryRecordType>(type)) {
+        case TelemetryRecordType::SensorSnapshot:
+            return index < 6 ? sensorFields[index] : "field";
+        case TelemetryRecordType::AccDecision:
+            return index < 4 ? accFields[index] : "field";
+        case TelemetryRecordType::DiagnosticReading:
+            return index < 4 ? diagnosticFields[index] : "field";
+        default:
+            return "field";
+    }
+}
@@ -0,0 +1,221 @@
+#include "../headers/thread_pool.hpp"
+
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace {
+constexpr std::uint64_t packRange(std::uint64_t begin, std::uint64_t end) {
+    return (begin << 32) | end;
+}
+constexpr std::uint64_t rangeBegin(std::uint64_t packed) {
+    return packed >> 32;
+}
+constexpr std::uint64_t rangeEnd(std::uint64_t packed) {
+    return packed & 0xFFFFFFFFu;
+}
+}
+
+/**
+ * @brief Constructor for the WorkStealingPool class.
+ *
+ * Starts threads - 1 worker threads; the thread calling parallelFor() is the remaining participant.
+ * With pinning, the workers are pinned here and participant 0 by parallelFor(), since the thread
+ * constructing the pool need not be the one that runs its jobs.
+ *
+ * @param config Thread count and CPU pinning options.
+ */
+WorkStealingPool::WorkStealingPool(const ThreadPoolConfig& config)
+    : participantCount(config.threads != 0 ? config.threads : std::max(1u, std::thread::hardware_concurrency())),
+      ranges(new TaskRange[participantCount]),
+      pinThreads(config.pinThreads) {
+    const std::size_t cpuCount = std::max(1u, std::thread::hardware_concurrency());
+    callerCpu = config.firstCpu % cpuCount;
+    workers.reserve(participantCount - 1);
+    for (std::size_t p = 1; p < participantCount; ++p) {
+        workers.emplace_back(&WorkStealingPool::workerLoop, this, p);
+        if (pinThreads) {
+#ifdef __linux__
+            pinToCpu(workers.back().native_handle(), (config.firstCpu + p) % cpuCount);
+#endif
+        }
+    }
+}
+
+/**
+ * @brief Destructor for the WorkStealingPool class.
+ *
+ * Stops and joins all worker threads.
+ */
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    jobReady.notify_all();
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Runs task(i) for every i in [0, taskCount) across all participants.
+ *
+ * Returns once all tasks have completed and all workers are idle again.
+ *
+ * @param taskCount Number of tasks; must fit in 32 bits.
+ * @param task The function to run for each task index.
+ */
+void WorkStealingPool::parallelFor(std::size_t taskCount, const std::function<void(std::size_t)>& task) {
+    if (taskCount == 0) {
+        return;
+    }
+    if (pinThreads && pinnedCaller != std::this_thread::get_id()) {
+#ifdef __linux__
+        pinToCpu(pthread_self(), callerCpu);
+#endif
+        pinnedCaller = std::this_thread::get_id();
+    }
+    if (participantCount == 1) {
+        for (std::size_t i = 0; i < taskCount; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    // Contiguous initial split keeps neighbouring tasks on the same thread
+    for (std::size_t p = 0; p < participantCount; ++p) {
+        std::uint64_t begin = taskCount * p / participantCount;
+        std::uint64_t end = taskCount * (p + 1) / participantCount;
+        ranges[p].packed.store(packRange(begin, end), std::memory_order_relaxed);
+    }
+    job = &task;
+    remainingTasks.store(taskCount, std::memory_order_relaxed);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        busyWorkers.store(participantCount - 1, std::memory_order_relaxed);
+        ++generation;
+    }
+    jobReady.notify_all();
+
+    runParticipant(0);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    jobDone.wait(lock, [&] {
+        return remainingTasks.load(std::memory_order_acquire) == 0 && busyWorkers.load(std::memory_order_acquire) == 0;
+    });
+    job = nullptr;
+}
+
+/**
+ * @brief Body of each worker thread: waits for a job, takes part in it, reports when idle.
+ *
+ * @param participant Index of this worker's task range.
+ */
+void WorkStealingPool::workerLoop(std::size_t participant) {
+    std::uint64_t seenGeneration = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            jobReady.wait(lock, [&] { return stopping || generation != seenGeneration; });
+            if (stopping) {
+                return;
+            }
+            seenGeneration = generation;
+        }
+
+        runParticipant(participant);
+
+        if (busyWorkers.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobDone.notify_all();
+        }
+    }
+}
+
+/**
+ * @brief Runs tasks from the participant's own range, stealing when it runs dry.
+ *
+ * @param participant Index of the participant.
+ */
+void WorkStealingPool::runParticipant(std::size_t participant) {
+    const std::function<void(std::size_t)>& task = *job;
+    std::size_t index;
+    do {
+        while (popLocal(participant, index)) {
+            task(index);
+            remainingTasks.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    } while (stealInto(participant));
+}
+
+/**
+ * @brief Takes the next task from the front of a participant's own range.
+ *
+ * @param participant Index of the participant.
+ * @param task Receives the task index.
+ * @return false if the range is empty.
+ */
+bool WorkStealingPool::popLocal(std::size_t participant, std::size_t& task) {
+    std::atomic<std::uint64_t>& range = ranges[participant].packed;
+    std::uint64_t current = range.load(std::memory_order_acquire);
+    for (;;) {
+        std::uint64_t begin = rangeBegin(current);
+        std::uint64_t end = rangeEnd(current);
+        if (begin >= end) {
+            return false;
+        }
+        if (range.compare_exchange_weak(current, packRange(begin + 1, end), std::memory_order_acq_rel)) {
+            task = static_cast<std::size_t>(begin);
+            return true;
+        }
+    }
+}
+
+/**
+ * @brief Steals the back half of another participant's range into the thief's own range.
+ *
+ * @param thief Index of the stealing participant, whose own range is empty.
+ * @return false if every other range is empty.
+ */
+bool WorkStealingPool::stealInto(std::size_t thief) {
+    for (std::size_t offset = 1; offset < participantCount; ++offset) {
+        std::atomic<std::uint64_t>& victim = ranges[(thief + offset) % participantCount].packed;
+        std::uint64_t current = victim.load(std::memory_order_acquire);
+        for (;;) {
+            std::uint64_t begin = rangeBegin(current);
+            std::uint64_t end = rangeEnd(current);
+            if (begin >= end) {
+                break;
+            }
+            std::uint64_t take = (end - begin + 1) / 2;
+            if (victim.compare_exchange_weak(current, packRange(begin, end - take), std::memory_order_acq_rel)) {
+                ranges[thief].packed.store(packRange(end - take, end), std::memory_order_release);
+                steals.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Restricts a thread to a single CPU (Linux only; a no-op elsewhere).
+ *
+ * @param handle The thread to pin.
+ * @param cpu The CPU index.
+ */
+void WorkStealingPool::pinToCpu(std::thread::native_handle_type handle, std::size_t cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(handle, sizeof(set), &set);
+#else
+    (void)handle;
+    (void)cpu;
+#endif
+}
@@ -0,0 +1,86 @@
+#include "../headers/tick_engine.hpp"
+
+#include <chrono>
+
+#include "../headers/instrumentation.hpp"
+
+namespace {
+using StageClock = std::chrono::steady_clock;
+
+std::uint64_t elapsedNs(StageClock::time_point from, StageClock::time_point to) {
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count());
+}
+
+std::size_t alignedChunkSize(std::size_t requested) {
+    const std::size_t block = Fleet::kKernelBlock;
+    const std::size_t size = requested == 0 ? block : requested;
+    return (size + block - 1) / block * block;
+}
+}
+
+/**
+ * @brief Constructor for the TickEngine class.
+ *
+ * @param fleet The fleet to advance; must outlive the engine.
+ * @param config Thread count, chunk size and CPU pinning options.
+ */
+TickEngine::TickEngine(Fleet& fleet, const TickEngineConfig& config)
+    : fleet(fleet),
+      chunkSize(alignedChunkSize(config.chunkSize)),
+      chunks((fleet.size() + chunkSize - 1) / chunkSize),
+      pool(ThreadPoolConfig{config.threads, config.pinThreads, config.firstCpu}),
+      chunkTask([this](std::size_t chunk) { runChunk(chunk); }) {}
+
+/**
+ * @brief Advances every vehicle by one tick and waits for all chunks to finish.
+ */
+void TickEngine::tick() {
+    pool.parallelFor(chunks, chunkTask);
+    fleet.advanceTick();
+    ++ticks;
+}
+
+/**
+ * @brief Runs the per-vehicle pipeline for one chunk of the fleet.
+ *
+ * Each stage's time is added to the engine's totals and recorded into the stage's probe.
+ *
+ * @param chunk Index of the chunk.
+ */
+void TickEngine::runChunk(std::size_t chunk) {
+    const std::size_t begin = chunk * chunkSize;
+    const std::size_t end = std::min(fleet.size(), begin + chunkSize);
+
+    const StageClock::time_point start = StageClock::now();
+    fleet.updateSensors(begin, end);
+    const StageClock::time_point sensorsDone = StageClock::now();
+    fleet.adaptiveCruiseControl(begin, end);
+    const StageClock::time_point accDone = StageClock::now();
+    fleet.runDiagnostics(begin, end);
+    const StageClock::time_point diagnosticsDone = StageClock::now();
+    sensorsNs.fetch_add(elapsedNs(start, sensorsDone), std::memory_order_relaxed);
+    accNs.fetch_add(elapsedNs(sensorsDone, accDone), std::memory_order_relaxed);
+    diagnosticsNs.fetch_add(elapsedNs(accDone, diagnosticsDone), std::memory_order_relaxed);
+    VT_RECORD(Sensors, elapsedNs(start, sensorsDone));
+    VT_RECORD(Acc, elapsedNs(sensorsDone, accDone));
+    VT_RECORD(Diagnostics, elapsedNs(accDone, diagnosticsDone));
+    if (chunkObserver) {
+        chunkObserver(begin, end);
+        const std::uint64_t observedNs = elapsedNs(diagnosticsDone, StageClock::now());
+        observerNs.fetch_add(observedNs, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * @brief Gets the time spent in each pipeline stage so far.
+ *
+ * @return Per-stage times summed over all chunks and threads (CPU time, not wall time).
+ */
+StageTimes TickEngine::stageTimes() const {
+    StageTimes times;
+    times.sensorsNs = sensorsNs.load(std::memory_order_relaxed);
+    times.accNs = accNs.load(std::memory_order_relaxed);
+    times.diagnosticsNs = diagnosticsNs.load(std::memory_order_relaxed);
+    times.observerNs = observerNs.load(std::memory_order_relaxed);
+    return times;
+}
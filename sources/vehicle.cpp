@@ -3,46 +3,87 @@
 /**
  * @brief Constructor for the Vehicle class, initializing all components.
  * 
- * This constructor initializes all the sensors, ECUs, and the logger for the vehicle.
- */
-Vehicle::Vehicle(const std::string& filePath) :
-    speedSensor(std::make_shared<SpeedSensor>()),
-    fuelSensor(std::make_shared<FuelSensor>()),
-    tempSensor(std::make_shared<TemperatureSensor>()),
-    battery(std::make_shared<Battery>()),
-    radarSensor(std::make_shared<RadarSensor>()),
-    engineECU(std::make_shared<EngineControlUnit>()),
-    brakeECU(std::make_shared<BrakeControlUnit>()),
-    transmissionECU(std::make_shared<TransmissionControlUnit>()),
+ * This constructor initializes all the sensors, ECUs, and the logger for the vehicle,
+ * and connects the dashboard, diagnostics and cruise control to the signal bus.
+ * The initial readings and actuator states are published so every consumer
+ * sees a complete state from the start.
+ *
+ * @param filePath The path to the log file.
+ * @param vehicleId Identifier of the vehicle in binary telemetry records and its random streams.
+ * @param seed Simulation seed; the same seed and id always reproduce the same run.
+ * @param arena Arena for the signal bus history, or nullptr for the heap; must outlive the vehicle.
+ * @param busHistory Samples of history the signal bus keeps per signal.
+ */
+Vehicle::Vehicle(const std::string& filePath, std::uint32_t vehicleId, std::uint64_t seed, Arena* arena,
+                 std::size_t busHistory) :
+    vehicleId(vehicleId),
+    sensors(seed, vehicleId),
     logger(Logger::GetInstance(filePath)),
-    dashboard(std::make_unique<Dashboard>(speedSensor, fuelSensor, tempSensor, battery, radarSensor, engineECU, brakeECU, transmissionECU, logger)),
-    diagnostics(std::make_unique<VehicleDiagnostics>(speedSensor, fuelSensor, tempSensor, battery, radarSensor, logger)),
-    cruiseControl(std::make_unique<CruiseControlSystem>(radarSensor, engineECU, brakeECU, logger))
-{}
+    bus(busHistory, arena),
+    dashboard(bus, logger),
+    diagnostics(bus, logger, vehicleId),
+    cruiseControl(bus, engineECU, brakeECU, vehicleId)
+{
+    const std::uint64_t now = bus.now();
+    sensors.publishAll(bus, now);
+    bus.publish(Signal::Throttle, engineECU.getThrottlePosition(), now);
+    bus.publish(Signal::BrakePressure, brakeECU.getBrakePressure(), now);
+    bus.publish(Signal::Gear, transmissionECU.getGear(), now);
+}
 
 /**
  * @brief Updates all sensors and logs the results.
  * 
- * This function updates the state of all sensors in the vehicle and logs each update.
+ * This function updates the state of all sensors in the vehicle, in VehicleSensors order
+ * followed by the plug-in sensors, and logs each update. The resulting readings are
+ * written to the binary telemetry log as one snapshot record.
  */
 void Vehicle::updateSensors() {
-    logger.Log("\n\nUpdating sensors.");
+    VT_LOG_DEBUG(logger, Sensors, "Updating sensors.");
 
-    speedSensor->update();
-    logger.Log("Speed sensor updated.");
-
-    fuelSensor->update();
-    logger.Log("Fuel sensor updated.");
+    sensors.forEach([this](auto& sensor) { updateSensor<std::decay_t<decltype(sensor)>>(); });
+    for (PluginSensor& plugin : plugins) {
+        updatePlugin(*plugin.sensor);
+    }
+    recordTelemetry();
+}
 
-    tempSensor->setSpeed(speedSensor->readData());
-    tempSensor->update();
-    logger.Log("Temperature sensor updated.");
+/**
+ * @brief Updates one plug-in sensor and publishes its readings.
+ *
+ * @param sensor The plug-in sensor.
+ */
+void Vehicle::updatePlugin(Sensor& sensor) {
+    VT_PROBE(Sensors);
+    sensor.update(bus);
+    sensor.publish(bus, bus.now());
+}
 
-    battery->update();
-    logger.Log("Battery updated.");
+/**
+ * @brief Adds a sensor only known at run time.
+ *
+ * @param sensor The sensor; the vehicle takes ownership.
+ * @param name Name of its scheduler task.
+ * @param period Time between its updates when the vehicle's tasks are scheduled.
+ * @param controlLoop Whether it runs with the radar and ACC on the control scheduler.
+ */
+void Vehicle::addSensor(std::unique_ptr<Sensor> sensor, const std::string& name, std::chrono::nanoseconds period,
+                        bool controlLoop) {
+    sensor->publish(bus, bus.now());
+    plugins.push_back(PluginSensor{std::move(sensor), name, period, controlLoop});
+}
 
-    radarSensor->update();
-    logger.Log("Radar sensor updated.");
+/**
+ * @brief Writes the latest sensor readings on the bus to the binary telemetry log as one snapshot record.
+ */
+void Vehicle::recordTelemetry() {
+    VT_PROBE(Telemetry);
+    TelemetryLog::GetInstance().RecordSensorSnapshot(vehicleId, bus.latestValue(Signal::Speed),
+                                                     bus.latestValue(Signal::FuelLevel),
+                                                     bus.latestValue(Signal::EngineTemperature),
+                                                     bus.latestValue(Signal::BatteryCharge),
+                                                     bus.latestValue(Signal::BatteryTemperature),
+                                                     bus.latestValue(Signal::RadarDistance));
 }
 
 /**
@@ -52,7 +93,8 @@ void Vehicle::updateSensors() {
  * the current sensor readings, ECU states, and other relevant vehicle status details.
  */
 void Vehicle::displayDashboard() {
-    dashboard->display();
+    VT_PROBE(Dashboard);
+    dashboard.display();
 }
 
 /**
@@ -62,7 +104,8 @@ void Vehicle::displayDashboard() {
  * which performs a series of diagnostic checks on the sensors and logs the results.
  */
 void Vehicle::runDiagnostics() {
-    diagnostics->runDiagnostics();
+    VT_PROBE(Diagnostics);
+    diagnostics.runDiagnostics();
 }
 
 /**
@@ -72,5 +115,143 @@ void Vehicle::runDiagnostics() {
  * which adjusts the vehicle's throttle and brake settings based on radar sensor readings.
  */
 void Vehicle::adaptiveCruiseControl() {
-    cruiseControl->adaptiveCruiseControl();
+    VT_PROBE(Acc);
+    cruiseControl.adaptiveCruiseControl();
+}
+
+/**
+ * @brief Gathers the latest sensor readings and ECU states from the signal bus.
+ * 
+ * Safe to call from any thread while the vehicle runs.
+ *
+ * @return A snapshot of the vehicle's state.
+ */
+VehicleState Vehicle::state() const {
+    return latestVehicleState(bus);
+}
+
+/**
+ * @brief Registers the vehicle's subsystems with a scheduler, each at its own fixed rate.
+ * 
+ * Each sensor runs at the period of its SensorTraits: radar at 100 Hz, so ACC (also
+ * 100 Hz) reacts at the radar rate; speed and the engine temperature derived from it
+ * at 50 Hz; fuel and battery at 1 Hz. The dashboard and telemetry snapshots run at
+ * 10 Hz and the diagnostics at 1 Hz.
+ *
+ * @param scheduler The scheduler to add the tasks to; the vehicle must outlive its use.
+ * @param withDashboard Whether to register the dashboard display task.
+ */
+void Vehicle::scheduleTasks(TaskScheduler& scheduler, bool withDashboard) {
+    scheduleControlTasks(scheduler);
+    scheduleMonitorTasks(scheduler, withDashboard);
+}
+
+/**
+ * @brief Registers a task for every sensor of VehicleSensors on one side of the control/monitor split.
+ *
+ * The tasks are generated from the sensor list, in list order, so sensors due at the
+ * same instant run in that order (the engine temperature after the speed it reads).
+ * The plug-in sensors on the same side follow, in the order they were added.
+ *
+ * @param scheduler The scheduler to add the tasks to; the vehicle must outlive its use.
+ */
+template <bool ControlLoop>
+void Vehicle::scheduleSensorTasks(TaskScheduler& scheduler) {
+    sensors.forEach([&](auto& sensor) {
+        using S = std::decay_t<decltype(sensor)>;
+        if constexpr (SensorTraits<S>::kControlLoop == ControlLoop) {
+            scheduler.addTask(SensorTraits<S>::kName, SensorTraits<S>::kPeriod, [this] { updateSensor<S>(); });
+        }
+    });
+    for (PluginSensor& plugin : plugins) {
+        if (plugin.controlLoop == ControlLoop) {
+            Sensor* sensor = plugin.sensor.get();
+            scheduler.addTask(plugin.name, plugin.period, [this, sensor] { updatePlugin(*sensor); });
+        }
+    }
+}
+
+/**
+ * @brief Registers the control loop sensors (the radar) and adaptive cruise control at 100 Hz.
+ *
+ * The control loop only shares the signal bus with the other tasks, so it may
+ * run on a scheduler of its own on a dedicated thread (the logger must then be
+ * in asynchronous mode). When replaying, a task publishing one frame of the
+ * recording per recording period takes the place of the radar.
+ *
+ * @param scheduler The scheduler to add the tasks to; the vehicle must outlive its use.
+ */
+void Vehicle::scheduleControlTasks(TaskScheduler& scheduler) {
+    using namespace std::chrono_literals;
+    if (replay != nullptr) {
+        scheduler.addTask("replay", replay->period(), [this] { replay->publishNext(bus); });
+    } else {
+        scheduleSensorTasks<true>(scheduler);
+    }
+    scheduler.addTask("acc", 10ms, [this] { adaptiveCruiseControl(); });
+}
+
+/**
+ * @brief Registers every task except the control loop (see scheduleControlTasks()).
+ *
+ * The sensor updates are left out when replaying; the recording supplies their values.
+ *
+ * @param scheduler The scheduler to add the tasks to; the vehicle must outlive its use.
+ * @param withDashboard Whether to register the dashboard display task.
+ */
+void Vehicle::scheduleMonitorTasks(TaskScheduler& scheduler, bool withDashboard) {
+    using namespace std::chrono_literals;
+    if (replay == nullptr) {
+        scheduleSensorTasks<false>(scheduler);
+    }
+    if (withDashboard) {
+        scheduler.addTask("dashboard", 100ms, [this] { displayDashboard(); });
+    }
+    scheduler.addTask("diagnostics", 1s, [this] { runDiagnostics(); });
+    scheduler.addTask("telemetry", 100ms, [this] { recordTelemetry(); });
+}
+
+/**
+ * @brief Enables or disables the diagnostics report on the console.
+ *
+ * @param enabled Whether diagnostics print to the console; they are always logged.
+ */
+void Vehicle::setConsoleOutput(bool enabled) {
+    diagnostics.setConsoleOutput(enabled);
+}
+
+/**
+ * @brief Replaces the rules the diagnostics evaluate.
+ *
+ * @param rules The new rules; every rule starts cleared.
+ */
+void Vehicle::setDiagnosticRules(RuleSet rules) {
+    diagnostics.setRules(std::move(rules));
+}
+
+/**
+ * @brief Gets the diagnostics' rules and which of them are raised.
+ *
+ * @return The rule engine; only consistent on the thread that runs the diagnostics.
+ */
+const RuleEngine& Vehicle::diagnosticRules() const {
+    return diagnostics.ruleEngine();
+}
+
+/**
+ * @brief Stamps the vehicle's bus samples with a virtual time instead of the steady clock.
+ *
+ * @param timeNs The current virtual time; call again as it advances.
+ */
+void Vehicle::setVirtualTimeNs(std::uint64_t timeNs) {
+    bus.setVirtualTimeNs(timeNs);
+}
+
+/**
+ * @brief Drives the vehicle from a recording instead of its sensors.
+ *
+ * @param replay The recording, which must outlive the scheduled tasks; nullptr to use the sensors again.
+ */
+void Vehicle::setReplay(SensorReplay* replay) {
+    this->replay = replay;
 }
@@ -0,0 +1,59 @@
+#include "../headers/vehicle_pool.hpp"
+
+#include <new>
+
+namespace {
+std::size_t alignUp(std::size_t bytes, std::size_t alignment) {
+    return (bytes + alignment - 1) & ~(alignment - 1);
+}
+}
+
+/**
+ * @brief Gets the arena bytes one pooled vehicle takes.
+ *
+ * @param busHistory Samples of history each signal bus keeps per signal.
+ * @return The vehicle object and its bus slots, the slots rounded up to their alignment.
+ */
+std::size_t VehiclePool::bytesPerVehicle(std::size_t busHistory) {
+    return sizeof(Vehicle) + alignUp(SignalBus::storageBytes(busHistory), alignof(SignalRing::Slot));
+}
+
+/**
+ * @brief Constructor for the VehiclePool class; builds every vehicle in one arena block.
+ *
+ * If a vehicle's constructor throws, the vehicles built so far are destroyed and the block is released.
+ *
+ * @param count Number of vehicles.
+ * @param logPath The log file every vehicle writes to.
+ * @param seed Simulation seed shared by the vehicles; vehicle i uses id i.
+ * @param busHistory Samples of history each signal bus keeps per signal.
+ */
+VehiclePool::VehiclePool(std::size_t count, const std::string& logPath, std::uint64_t seed, std::size_t busHistory)
+    : arena(count * bytesPerVehicle(busHistory) + Arena::kBlockAlignment),
+      vehicles(arena.allocate<Vehicle>(count)) {
+    try {
+        for (; this->count < count; ++this->count) {
+            new (&vehicles[this->count]) Vehicle(logPath, static_cast<std::uint32_t>(this->count), seed, &arena,
+                                                 busHistory);
+        }
+    } catch (...) {
+        destroyVehicles();
+        throw;
+    }
+}
+
+/**
+ * @brief Destructor for the VehiclePool class; destroys the vehicles, then the arena releases its block.
+ */
+VehiclePool::~VehiclePool() {
+    destroyVehicles();
+}
+
+/**
+ * @brief Destroys the constructed vehicles, last first.
+ */
+void VehiclePool::destroyVehicles() {
+    while (count > 0) {
+        vehicles[--count].~Vehicle();
+    }
+}
@@ -0,0 +1,42 @@
+#include "../headers/vehicle_state.hpp"
+
+#include <iomanip>
+
+/**
+ * @brief Overloads the << operator to print a vehicle state in the dashboard layout.
+ *
+ * @param os The output stream to write to.
+ * @param state The state to print.
+ * @return The output stream.
+ */
+std::ostream& operator<<(std::ostream& os, const VehicleState& state) {
+    os << std::fixed << std::setprecision(2)
+       << "Speed: " << state.speed << " km/h\n"
+       << "Fuel Level: " << state.fuelLevel << " liters\n"
+       << "Engine Temperature: " << state.engineTemperature << " °C\n"
+       << "Battery Charge: " << state.batteryCharge << "%, "
+       << "Battery Temperature: " << state.batteryTemperature << " °C\n"
+       << "Front Vehicle Distance: " << state.radarDistance << " meters\n"
+       << "Throttle Position: " << state.throttle << "%\n"
+       << "Brake Pressure: " << state.brakePressure << "%\n"
+       << "Current Gear: " << state.gear;
+    return os;
+}
+
+/**
+ * @brief Copies a vehicle state into an array indexed by Signal.
+ *
+ * @param state The state to copy.
+ * @param values Receives one value per signal; the gear as a whole number.
+ */
+void toSignalValues(const VehicleState& state, double (&values)[kSignalCount]) {
+    values[static_cast<std::size_t>(Signal::Speed)] = state.speed;
+    values[static_cast<std::size_t>(Signal::FuelLevel)] = state.fuelLevel;
+    values[static_cast<std::size_t>(Signal::EngineTemperature)] = state.engineTemperature;
+    values[static_cast<std::size_t>(Signal::BatteryCharge)] = state.batteryCharge;
+    values[static_cast<std::size_t>(Signal::BatteryTemperature)] = state.batteryTemperature;
+    values[static_cast<std::size_t>(Signal::RadarDistance)] = state.radarDistance;
+    values[static_cast<std::size_t>(Signal::Throttle)] = state.throttle;
+    values[static_cast<std::size_t>(Signal::BrakePressure)] = state.brakePressure;
+    values[static_cast<std::size_t>(Signal::Gear)] = state.gear;
+}
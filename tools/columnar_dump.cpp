@@ -0,0 +1,98 @@
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Header-only: the loader needs nothing else from the simulator
+#include "../headers/columnar_format.hpp"
+
+/// Prints the file's layout and each row group's per-column min/max statistics.
+static void printSummary(const ColumnarReader& reader) {
+    const ColumnarFileHeader& header = reader.header();
+    std::cout << reader.vehicleCount() << " vehicle(s), a snapshot every " << header.snapshotEvery << " tick(s) of "
+              << header.dtNs << " ns, " << reader.groupCount() << " row group(s)"
+              << (reader.recovered() ? " (no footer: recovered by scanning)" : "") << '\n';
+    for (std::size_t g = 0; g < reader.groupCount(); ++g) {
+        const ColumnarReader::Group& group = reader.group(g);
+        std::cout << "group " << g << ": ticks " << group.firstTick << ".."
+                  << group.ticks[group.snapshotCount - 1] << ", " << group.snapshotCount << " snapshot(s)\n";
+        for (std::size_t c = 0; c < reader.columnCount(); ++c) {
+            const ColumnarChunkInfo& chunk = group.chunks[c];
+            std::cout << "  " << std::left << std::setw(22) << reader.column(c).name << std::right
+                      << std::setw(10) << chunk.bytes << " B  min " << chunk.min << "  max " << chunk.max << '\n';
+        }
+    }
+}
+
+/// Decodes one column of every row group, printing one vehicle's values or each group's mean.
+static void printColumn(const ColumnarReader& reader, std::size_t column, long vehicle) {
+    std::vector<double> values;
+    const std::size_t vehicles = reader.vehicleCount();
+    for (std::size_t g = 0; g < reader.groupCount(); ++g) {
+        const ColumnarReader::Group& group = reader.group(g);
+        reader.readColumn(g, column, values);
+        if (vehicle >= 0) {
+            for (std::size_t s = 0; s < group.snapshotCount; ++s) {
+                std::cout << group.ticks[s] << ' ' << group.timestampsNs[s] << ' '
+                          << values[s * vehicles + static_cast<std::size_t>(vehicle)] << '\n';
+            }
+            continue;
+        }
+        double sum = 0.0;
+        for (double value : values) {
+            sum += value;
+        }
+        std::cout << "group " << g << ": ticks " << group.firstTick << ".." << group.ticks[group.snapshotCount - 1]
+                  << "  min " << group.chunks[column].min << "  mean " << sum / values.size() << "  max "
+                  << group.chunks[column].max << '\n';
+    }
+}
+
+/// Summarises a columnar fleet snapshot file, or scans one of its columns.
+int main(int argc, char* argv[]) {
+    std::string path;
+    std::string columnName;
+    long vehicle = -1;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--column") == 0 && i + 1 < argc) {
+            columnName = argv[++i];
+        } else if (std::strcmp(argv[i], "--vehicle") == 0 && i + 1 < argc) {
+            vehicle = std::atol(argv[++i]);
+        } else if (path.empty() && argv[i][0] != '-') {
+            path = argv[i];
+        } else {
+            path.clear();
+            break;
+        }
+    }
+    if (path.empty() || (vehicle >= 0 && columnName.empty())) {
+        std::cerr << "Usage: " << argv[0] << " FILE [--column NAME [--vehicle N]]" << std::endl;
+        return 2;
+    }
+
+    try {
+        ColumnarReader reader(path);
+        std::cout << std::fixed << std::setprecision(3);
+        if (columnName.empty()) {
+            printSummary(reader);
+            return 0;
+        }
+        const std::size_t column = reader.findColumn(columnName);
+        if (column == reader.columnCount()) {
+            std::cerr << "No column named " << columnName << std::endl;
+            return 1;
+        }
+        if (vehicle >= static_cast<long>(reader.vehicleCount())) {
+            std::cerr << "No vehicle " << vehicle << " (the file has " << reader.vehicleCount() << ")" << std::endl;
+            return 1;
+        }
+        printColumn(reader, column, vehicle);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+// Header-only: the reader needs nothing else from the simulator
+#include "../headers/shm_snapshot.hpp"
+
+/// Prints one vehicle's snapshot and the labels of its active warnings.
+static void printVehicle(const ShmSnapshotReader& reader, const ShmVehicleSnapshot& snapshot) {
+    std::cout << "vehicle " << snapshot.vehicleId << " t=" << snapshot.timestampNs;
+    for (std::size_t s = 0; s < kSignalCount; ++s) {
+        std::cout << ' ' << signalKey(static_cast<Signal>(s)) << '=' << snapshot.values[s];
+    }
+    for (std::size_t r = 0; r < reader.warningCount(); ++r) {
+        if (snapshot.warningActive(r)) {
+            std::cout << " [" << reader.warning(r).message << ']';
+        }
+    }
+    std::cout << '\n';
+}
+
+/// Polls the simulator's live-state segment and prints consistent snapshots.
+int main(int argc, char* argv[]) {
+    std::string name = kShmDefaultName;
+    long intervalMs = 500;
+    long count = 0;
+    std::size_t limit = 8;
+    for (int i = 1; i < argc; ++i) {
+        if (i + 1 >= argc) {
+            std::cerr << "Usage: " << argv[0] << " [--name NAME] [--interval MS] [--count N] [--limit N]" << std::endl;
+            return 2;
+        }
+        if (std::strcmp(argv[i], "--name") == 0) {
+            name = argv[++i];
+        } else if (std::strcmp(argv[i], "--interval") == 0) {
+            intervalMs = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--count") == 0) {
+            count = std::atol(argv[++i]);
+        } else if (std::strcmp(argv[i], "--limit") == 0) {
+            limit = static_cast<std::size_t>(std::atol(argv[++i]));
+        } else {
+            std::cerr << "Unknown option: " << argv[i] << std::endl;
+            return 2;
+        }
+    }
+
+    try {
+        ShmSnapshotReader reader(name);
+        std::cout << std::fixed << std::setprecision(2);
+        for (long poll = 0; count == 0 || poll < count; ++poll) {
+            std::size_t warned = 0;
+            std::size_t printed = 0;
+            ShmVehicleSnapshot snapshot;
+            for (std::size_t v = 0; v < reader.vehicleCount(); ++v) {
+                if (!reader.read(v, snapshot)) {
+                    continue;
+                }
+                warned += snapshot.activeWarnings != 0;
+                if (printed < limit) {
+                    printVehicle(reader, snapshot);
+                    ++printed;
+                }
+            }
+            std::cout << "-- " << reader.vehicleCount() << " vehicle(s), " << warned << " with active warnings, "
+                      << reader.publishCount() << " updates published" << std::endl;
+            std::this_thread::sleep_for(std::chrono::milliseconds(intervalMs));
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+
+#include "../headers/telemetry_log.hpp"
+
+/// Whether a field holds a Signal index; files written by other code may hold anything.
+static bool isSignalField(double value) {
+    return std::isfinite(value) && value >= 0.0 && value < static_cast<double>(kSignalCount) &&
+           value == std::trunc(value);
+}
+
+/// Prints one record as a human readable line.
+static void printText(const TelemetryRecord& record) {
+    std::cout << record.timestampNs << ' ' << telemetryRecordTypeName(record.type)
+              << " vehicle=" << record.vehicleId;
+    for (std::size_t i = 0; i < record.fieldCount && i < kTelemetryMaxFields; ++i) {
+        std::cout << ' ' << telemetryFieldName(record.type, i) << '=';
+        if (record.type == static_cast<std::uint16_t>(TelemetryRecordType::DiagnosticReading) && i == 0 &&
+            isSignalField(record.fields[0])) {
+            std::cout << signalName(static_cast<Signal>(record.fields[0]));
+        } else {
+            std::cout << record.fields[i];
+        }
+    }
+    std::cout << '\n';
+}
+
+/// Prints one record as a CSV row with a fixed number of field columns.
+static void printCsv(const TelemetryRecord& record) {
+    std::cout << record.timestampNs << ',' << telemetryRecordTypeName(record.type) << ',' << record.vehicleId;
+    for (std::size_t i = 0; i < kTelemetryMaxFields; ++i) {
+        std::cout << ',';
+        if (i < record.fieldCount) {
+            std::cout << record.fields[i];
+        }
+    }
+    std::cout << '\n';
+}
+
+/// Converts a binary telemetry file to text or CSV on stdout.
+int main(int argc, char* argv[]) {
+    bool csv = false;
+    const char* path = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--csv") == 0) {
+            csv = true;
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == nullptr) {
+        std::cerr << "Usage: telemetry-decode [--csv] <telemetry.bin>" << std::endl;
+        return 2;
+    }
+
+    try {
+        TelemetryReader reader(path);
+        std::vector<TelemetryRecord> records;
+        std::cout.precision(6);
+        std::cout << std::fixed;
+        if (csv) {
+            std::cout << "timestamp_ns,type,vehicle_id,f0,f1,f2,f3,f4,f5\n";
+        }
+        while (reader.NextBlock(records)) {
+            for (const TelemetryRecord& record : records) {
+                csv ? printCsv(record) : printText(record);
+            }
+        }
+        if (reader.GetCorruptBlocks() > 0) {
+            std::cerr << "Skipped " << reader.GetCorruptBlocks() << " corrupt block(s)" << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}